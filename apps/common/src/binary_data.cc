@@ -0,0 +1,412 @@
+/* Copyright (c) 1997-2020
+   Ewgenij Gawrilow, Michael Joswig, and the polymake team
+   Technische Universität Berlin, Germany
+   https://polymake.org
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version: http://www.gnu.org/licenses/gpl.txt.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+--------------------------------------------------------------------------------
+*/
+
+/* Binary sidecar files for large property values of data files.
+   Each call of write_binary_data appends one record to the file and returns its offset.
+   A record consists of a header of 64-bit integers and a payload:
+   - dense vectors and matrices: the elements in row order;
+   - sparse and incidence matrices: rows+1 row start positions, the column indices of all entries
+     and, for sparse matrices, the values of all entries.
+   Elements of type double and Int are stored in native layout, Integers as the signed limb count
+   followed by the limbs, Rationals as numerator and denominator.
+   The header records the byte order and the GMP limb size of the writing machine;
+   records written with a different layout are rejected.
+   The files are read via mmap, so that reading a record only touches its own pages.
+*/
+
+#include "polymake/client.h"
+#include "polymake/Integer.h"
+#include "polymake/Rational.h"
+#include "polymake/Vector.h"
+#include "polymake/Matrix.h"
+#include "polymake/SparseMatrix.h"
+#include "polymake/IncidenceMatrix.h"
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace polymake { namespace common {
+
+namespace {
+
+using word = std::int64_t;
+
+const char record_magic[8] = { 'p', 'm', 'b', 'i', 'n', '0', '0', '2' };
+
+// stored in native byte order, reads differently on a machine with another one
+const word byte_order_mark = 0x0102030405060708;
+
+enum class record_kind : word { dense_vector = 1, dense_matrix, sparse_matrix, incidence_matrix };
+
+// marks an infinite Integer in place of the limb count
+const word infinite_size = word(1) << 62;
+
+// payload must stay the last field, see record_writer::finish
+struct record_header {
+   char magic[8];
+   word byte_order, limb_bits, kind, element, rows, cols, entries, payload;
+};
+
+template <typename E> struct binary_element;
+template <> struct binary_element<bool> { static constexpr word code = 0; };
+template <> struct binary_element<double> { static constexpr word code = 1; };
+template <> struct binary_element<Int> { static constexpr word code = 2; };
+template <> struct binary_element<Integer> { static constexpr word code = 3; };
+template <> struct binary_element<Rational> { static constexpr word code = 4; };
+
+class record_writer {
+public:
+   // not opened in append mode, which would forbid patching the header
+   explicit record_writer(const std::string& filename)
+      : os(filename, std::ios::binary | std::ios::in | std::ios::out)
+   {
+      if (!os) os.open(filename, std::ios::binary | std::ios::out);
+      if (!os) throw std::runtime_error("write_binary_data: can't open " + filename);
+      os.seekp(0, std::ios::end);
+      offset = os.tellp();
+   }
+
+   void write(const void* src, size_t n) { os.write(static_cast<const char*>(src), n); }
+   void write(word x) { write(&x, sizeof(word)); }
+
+   template <typename E>
+   std::enable_if_t<std::is_arithmetic<E>::value> write_elements(const E* src, Int n) { write(src, n * sizeof(E)); }
+
+   template <typename Iterator>
+   void write_elements(Iterator src, Int n)
+   {
+      for (; n > 0; --n, ++src)
+         write_element(*src);
+   }
+
+   void write_element(double x) { write(&x, sizeof(double)); }
+   void write_element(Int x) { write(word(x)); }
+   void write_element(const Integer& x) { write_mpz(x.get_rep()); }
+   void write_element(const Rational& x)
+   {
+      write_mpz(mpq_numref(x.get_rep()));
+      write_mpz(mpq_denref(x.get_rep()));
+   }
+
+   // the header is written first with a provisional payload size, fixed up in finish()
+   void start(record_kind kind, word element, Int r, Int c, Int entries)
+   {
+      record_header h;
+      std::memcpy(h.magic, record_magic, sizeof(record_magic));
+      h.byte_order = byte_order_mark;  h.limb_bits = GMP_NUMB_BITS;
+      h.kind = word(kind);  h.element = element;  h.rows = r;  h.cols = c;  h.entries = entries;  h.payload = 0;
+      write(&h, sizeof(h));
+      payload_start = os.tellp();
+   }
+
+   Int finish()
+   {
+      const word payload = word(os.tellp()) - payload_start;
+      os.seekp(payload_start - std::streamoff(sizeof(word)));
+      write(payload);
+      os.seekp(0, std::ios::end);
+      os.flush();
+      if (!os) throw std::runtime_error("write_binary_data: I/O error");
+      return offset;
+   }
+
+private:
+   std::fstream os;
+   word offset;
+   word payload_start;
+
+   void write_mpz(mpz_srcptr z)
+   {
+      if (!z->_mp_d) {
+         // infinite values are encoded by the sign alone
+         write(z->_mp_size < 0 ? -infinite_size : infinite_size);
+      } else {
+         write(word(z->_mp_size));
+         write(z->_mp_d, std::abs(z->_mp_size) * sizeof(mp_limb_t));
+      }
+   }
+};
+
+class record_reader {
+public:
+   record_reader(const std::string& filename, Int offset)
+   {
+      const int fd = ::open(filename.c_str(), O_RDONLY);
+      if (fd < 0) throw std::runtime_error("read_binary_data: can't open " + filename);
+      struct stat st;
+      if (::fstat(fd, &st) == 0) {
+         file_size = st.st_size;
+         mapped = file_size ? ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+      }
+      ::close(fd);
+      if (mapped == MAP_FAILED)
+         throw std::runtime_error("read_binary_data: can't map " + filename);
+      if (offset < 0 || size_t(offset) + sizeof(record_header) > file_size)
+         throw std::runtime_error("read_binary_data: offset out of range");
+      std::memcpy(&header, static_cast<const char*>(mapped) + offset, sizeof(record_header));
+      if (std::memcmp(header.magic, record_magic, sizeof(record_magic)) != 0)
+         throw std::runtime_error("read_binary_data: corrupted record or unsupported format in " + filename);
+      if (header.byte_order != byte_order_mark)
+         throw std::runtime_error("read_binary_data: " + filename + " was written on a machine with a different byte order");
+      if (header.limb_bits != GMP_NUMB_BITS)
+         throw std::runtime_error("read_binary_data: " + filename + " was written with " + std::to_string(header.limb_bits)
+                                  + "-bit GMP limbs, this machine uses " + std::to_string(GMP_NUMB_BITS) + "-bit limbs");
+      if (header.payload < 0 || size_t(offset) + sizeof(record_header) + header.payload > file_size)
+         throw std::runtime_error("read_binary_data: corrupted record in " + filename);
+      cur = static_cast<const char*>(mapped) + offset + sizeof(record_header);
+      end = cur + header.payload;
+   }
+
+   ~record_reader()
+   {
+      if (mapped != MAP_FAILED) ::munmap(mapped, file_size);
+   }
+
+   record_reader(const record_reader&) = delete;
+   record_reader& operator= (const record_reader&) = delete;
+
+   const record_header& get_header(record_kind kind, word element) const
+   {
+      if (header.kind != word(kind) || header.element != element)
+         throw std::runtime_error("read_binary_data: stored data has a different type");
+      return header;
+   }
+
+   // pointer to the next n elements in the payload; the record layout keeps 64-bit alignment
+   template <typename E>
+   const E* take(Int n)
+   {
+      if (n < 0 || n > (end - cur) / Int(sizeof(E)))
+         throw std::runtime_error("read_binary_data: truncated record");
+      const E* src = reinterpret_cast<const E*>(cur);
+      cur += n * sizeof(E);
+      return src;
+   }
+
+   // row starts and column indices of a row-compressed matrix, checked for consistency before any access by index:
+   // the row starts ascend from 0 to the number of entries, the column indices ascend within each row and are below cols
+   std::pair<const word*, const word*> take_row_compressed()
+   {
+      if (header.rows < 0 || header.cols < 0 || header.entries < 0)
+         throw std::runtime_error("read_binary_data: inconsistent matrix dimensions");
+      const word* row_starts = take<word>(header.rows + 1);
+      const word* col_indices = take<word>(header.entries);
+      if (row_starts[0] != 0 || row_starts[header.rows] != header.entries || !std::is_sorted(row_starts, row_starts + header.rows + 1))
+         throw std::runtime_error("read_binary_data: corrupted row starts");
+      for (Int i = 0; i < header.rows; ++i) {
+         for (word k = row_starts[i]; k < row_starts[i+1]; ++k) {
+            if (col_indices[k] < 0 || col_indices[k] >= header.cols || (k > row_starts[i] && col_indices[k] <= col_indices[k-1]))
+               throw std::runtime_error("read_binary_data: corrupted column indices");
+         }
+      }
+      return { row_starts, col_indices };
+   }
+
+   template <typename E>
+   std::enable_if_t<std::is_arithmetic<E>::value> read_elements(E* dst, Int n)
+   {
+      if (n) std::memcpy(dst, take<E>(n), n * sizeof(E));
+   }
+
+   template <typename E>
+   std::enable_if_t<!std::is_arithmetic<E>::value> read_elements(E* dst, Int n)
+   {
+      for (; n > 0; --n, ++dst)
+         *dst = read_element<E>();
+   }
+
+   template <typename E>
+   std::enable_if_t<std::is_arithmetic<E>::value, E> read_element() { return *take<E>(1); }
+
+   template <typename E>
+   std::enable_if_t<std::is_same<E, Integer>::value, E> read_element()
+   {
+      mpz_t z;
+      if (const Int s = read_mpz(z)) return Integer::infinity(s);
+      return Integer(std::move(z));
+   }
+
+   template <typename E>
+   std::enable_if_t<std::is_same<E, Rational>::value, E> read_element()
+   {
+      mpq_t q;
+      if (const Int s = read_mpz(mpq_numref(q))) {
+         if (!read_mpz(mpq_denref(q))) mpz_clear(mpq_denref(q));
+         return Rational::infinity(s);
+      }
+      if (read_mpz(mpq_denref(q)))
+         throw std::runtime_error("read_binary_data: infinite denominator");
+      // stored in canonical form
+      return Rational(std::move(q));
+   }
+
+private:
+   void* mapped = MAP_FAILED;
+   size_t file_size = 0;
+   record_header header;
+   const char* cur;
+   const char* end;
+
+   // initializes z with a finite value and returns 0, or returns the sign of an infinite value leaving z untouched
+   Int read_mpz(mpz_ptr z)
+   {
+      const word size = *take<word>(1);
+      if (std::abs(size) == infinite_size)
+         return size < 0 ? -1 : 1;
+      const Int n = std::abs(size);
+      const mp_limb_t* limbs = take<mp_limb_t>(n);
+      mpz_init2(z, std::max(n, Int(1)) * GMP_NUMB_BITS);
+      if (n) std::memcpy(z->_mp_d, limbs, n * sizeof(mp_limb_t));
+      z->_mp_size = size;
+      return 0;
+   }
+};
+
+}
+
+template <typename E>
+Int write_binary_data(const Vector<E>& v, const std::string& filename)
+{
+   record_writer w(filename);
+   w.start(record_kind::dense_vector, binary_element<E>::code, 1, v.dim(), v.dim());
+   if (v.dim()) w.write_elements(&*v.begin(), v.dim());
+   return w.finish();
+}
+
+template <typename E>
+Int write_binary_data(const Matrix<E>& M, const std::string& filename)
+{
+   record_writer w(filename);
+   const Int n = M.rows() * M.cols();
+   w.start(record_kind::dense_matrix, binary_element<E>::code, M.rows(), M.cols(), n);
+   if (n) w.write_elements(&*concat_rows(M).begin(), n);
+   return w.finish();
+}
+
+template <typename TMatrix>
+void write_values(record_writer& w, const TMatrix& M, std::false_type)
+{
+   for (auto r = entire(rows(M)); !r.at_end(); ++r)
+      for (auto e = entire(*r); !e.at_end(); ++e)
+         w.write_element(*e);
+}
+
+template <typename TMatrix>
+void write_values(record_writer&, const TMatrix&, std::true_type) {}
+
+template <typename TMatrix, typename E>
+Int write_row_compressed(const TMatrix& M, const std::string& filename, record_kind kind)
+{
+   std::vector<word> row_starts{ 0 }, col_indices;
+   row_starts.reserve(M.rows() + 1);
+   for (auto r = entire(rows(M)); !r.at_end(); ++r) {
+      for (auto e = entire(*r); !e.at_end(); ++e)
+         col_indices.push_back(e.index());
+      row_starts.push_back(col_indices.size());
+   }
+   record_writer w(filename);
+   w.start(kind, binary_element<E>::code, M.rows(), M.cols(), col_indices.size());
+   w.write(row_starts.data(), row_starts.size() * sizeof(word));
+   w.write(col_indices.data(), col_indices.size() * sizeof(word));
+   write_values(w, M, bool_constant<std::is_same<E, bool>::value>());
+   return w.finish();
+}
+
+template <typename E>
+Int write_binary_data(const SparseMatrix<E>& M, const std::string& filename)
+{
+   return write_row_compressed<SparseMatrix<E>, E>(M, filename, record_kind::sparse_matrix);
+}
+
+Int write_binary_data(const IncidenceMatrix<>& M, const std::string& filename)
+{
+   return write_row_compressed<IncidenceMatrix<>, bool>(M, filename, record_kind::incidence_matrix);
+}
+
+template <typename E>
+void read_binary_data(Vector<E>& v, const std::string& filename, Int offset)
+{
+   record_reader r(filename, offset);
+   const record_header& h = r.get_header(record_kind::dense_vector, binary_element<E>::code);
+   Vector<E> result(h.cols);
+   if (h.cols) r.read_elements(&*result.begin(), h.cols);
+   v = std::move(result);
+}
+
+template <typename E>
+void read_binary_data(Matrix<E>& M, const std::string& filename, Int offset)
+{
+   record_reader r(filename, offset);
+   const record_header& h = r.get_header(record_kind::dense_matrix, binary_element<E>::code);
+   if (h.rows < 0 || h.cols < 0 || h.entries != h.rows * h.cols)
+      throw std::runtime_error("read_binary_data: inconsistent matrix dimensions");
+   Matrix<E> result(h.rows, h.cols);
+   if (h.entries) r.read_elements(&*concat_rows(result).begin(), h.entries);
+   M = std::move(result);
+}
+
+template <typename E>
+void read_binary_data(SparseMatrix<E>& M, const std::string& filename, Int offset)
+{
+   record_reader r(filename, offset);
+   const record_header& h = r.get_header(record_kind::sparse_matrix, binary_element<E>::code);
+   const word *row_starts, *col_indices;
+   std::tie(row_starts, col_indices) = r.take_row_compressed();
+   RestrictedSparseMatrix<E> R(h.rows, h.cols);
+   auto row = rows(R).begin();
+   for (Int i = 0; i < h.rows; ++i, ++row)
+      for (word k = row_starts[i]; k < row_starts[i+1]; ++k)
+         row->push_back(col_indices[k], r.read_element<E>());
+   M = SparseMatrix<E>(std::move(R));
+}
+
+void read_binary_data(IncidenceMatrix<>& M, const std::string& filename, Int offset)
+{
+   record_reader r(filename, offset);
+   const record_header& h = r.get_header(record_kind::incidence_matrix, binary_element<bool>::code);
+   const word *row_starts, *col_indices;
+   std::tie(row_starts, col_indices) = r.take_row_compressed();
+   RestrictedIncidenceMatrix<> R(h.rows, h.cols);
+   auto row = rows(R).begin();
+   for (Int i = 0; i < h.rows; ++i, ++row)
+      for (word k = row_starts[i]; k < row_starts[i+1]; ++k)
+         row->push_back(col_indices[k]);
+   M = IncidenceMatrix<>(std::move(R));
+}
+
+FunctionTemplate4perl("write_binary_data(Vector, $)");
+FunctionTemplate4perl("write_binary_data(Matrix, $)");
+FunctionTemplate4perl("write_binary_data(SparseMatrix, $)");
+FunctionTemplate4perl("write_binary_data(IncidenceMatrix, $)");
+
+FunctionTemplate4perl("read_binary_data(Vector&, $$) : void");
+FunctionTemplate4perl("read_binary_data(Matrix&, $$) : void");
+FunctionTemplate4perl("read_binary_data(SparseMatrix&, $$) : void");
+FunctionTemplate4perl("read_binary_data(IncidenceMatrix&, $$) : void");
+
+} }
+
+// Local Variables:
+// mode:C++
+// c-basic-offset:3
+// indent-tabs-mode:nil
+// End:
@@ -0,0 +1,83 @@
+#  Copyright (c) 1997-2020
+#  Ewgenij Gawrilow, Michael Joswig, and the polymake team
+#  Technische Universität Berlin, Germany
+#  https://polymake.org
+#
+#  This program is free software; you can redistribute it and/or modify it
+#  under the terms of the GNU General Public License as published by the
+#  Free Software Foundation; either version 2, or (at your option) any
+#  later version: http://www.gnu.org/licenses/gpl.txt.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#-------------------------------------------------------------------------------
+
+# Products of multivariate polynomials are computed on exponent vectors packed into 64-bit words,
+# as long as the exponents are non-negative and the bit fields needed for all variables fit into a word.
+# Otherwise the terms are multiplied one by one.  Both must agree with the sum of all products of terms.
+
+# $n_terms terms in $n_vars variables with exponents from $min_exp to $max_exp
+sub poly {
+   my ($n_vars, $n_terms, $min_exp, $max_exp, $shift) = @_;
+   my $range = $max_exp - $min_exp + 1;
+   new Polynomial<Rational, Int>(new Vector<Rational>([ map { ($_ % 2 ? -1 : 1) * ($_ + $shift) } 1..$n_terms ]),
+                                 new Matrix<Int>([ map { my $i = $_; [ map { ($i * (2*$_ + 3) + $shift * $_) % $range + $min_exp } 0..$n_vars-1 ] } 1..$n_terms ]));
+}
+
+sub term_product {
+   my ($p, $q) = @_;
+   my ($pc, $pm, $qc, $qm) = ($p->coefficients_as_vector, $p->monomials_as_matrix, $q->coefficients_as_vector, $q->monomials_as_matrix);
+   my $n = $p->n_vars;
+   my $r = new Polynomial<Rational, Int>(0, $n);
+   foreach my $i (0..$pc->dim-1) {
+      foreach my $j (0..$qc->dim-1) {
+         $r += new Polynomial<Rational, Int>(new Vector<Rational>([ $pc->[$i] * $qc->[$j] ]),
+                                             new Matrix<Int>([ [ map { $pm->elem($i, $_) + $qm->elem($j, $_) } 0..$n-1 ] ]));
+      }
+   }
+   $r
+}
+
+sub check_product {
+   my ($id, $p, $q) = @_;
+   compare_values($id, term_product($p, $q), $p * $q);
+}
+
+# 16 variables with exponents up to 7: 4 bits per variable fill the word exactly; with 17 variables they don't fit
+check_product('16_vars', poly(16, 20, 0, 7, 1), poly(16, 25, 0, 7, 2));
+check_product('17_vars', poly(17, 20, 0, 7, 1), poly(17, 25, 0, 7, 2));
+
+# 2 variables with exponents below 2^31: the sums need 32 bits each; exponents of 2^31 need 33 bits
+my $big = 1 << 31;
+check_product('32_bits', poly(2, 10, $big-20, $big-1, 1), poly(2, 12, $big-20, $big-1, 2));
+check_product('33_bits', poly(2, 10, $big-10, $big, 1), poly(2, 12, $big-10, $big, 2));
+
+# negative exponents of Laurent polynomials are not packed
+check_product('laurent', poly(3, 15, -3, 4, 1), poly(3, 15, 0, 5, 2));
+check_product('laurent_cancelling', poly(3, 15, -4, 4, 1), poly(3, 15, -4, 4, 1));
+
+# sparse polynomials in many variables, each term only has a few of them
+sub var {
+   my ($i, $n) = @_;
+   new Polynomial<Rational, Int>(new Vector<Rational>([1]), new Matrix<Int>([ [ map { $_ == $i ? 1 : 0 } 0..$n-1 ] ]));
+}
+my $s = var(0, 40) + var(39, 40);
+my $sparse = $s * $s * $s + 5;
+check_product('sparse', $sparse, $sparse - var(20, 40));
+
+# the degree of the leading monomial is cached until the monomials change
+my $p = var(3, 40);
+compare_values('deg', 1, $p->deg);
+my $cube = var(2, 40) * var(2, 40) * var(2, 40);
+$p += $cube;
+compare_values('deg_added', 3, $p->deg);
+$p -= $cube;
+compare_values('deg_removed', 1, $p->deg);
+
+# Local Variables:
+# mode: perl
+# cperl-indent-level:3
+# indent-tabs-mode:nil
+# End:
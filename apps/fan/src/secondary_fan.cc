@@ -20,12 +20,17 @@
 #include "polymake/Array.h"
 #include "polymake/hash_set"
 #include "polymake/Bitset.h"
+#include "polymake/permutations.h"
 #include "polymake/FacetList.h"
 #include "polymake/polytope/is_regular.h"
 #include "polymake/polytope/solve_LP.h"
+#include "polymake/polytope/convex_hull.h"
+#include "polymake/polytope/beneath_beyond_impl.h"
 #include "polymake/fan/intersection.h"
 #include "polymake/IncidenceMatrix.h"
 #include "polymake/RandomGenerators.h"
+#include "polymake/parallel.h"
+#include <vector>
 
 namespace polymake { namespace fan {
 
@@ -103,17 +108,27 @@ find_initial_subdivision(const Matrix<Scalar>& V_full,
    return S;
 }
 
+// beneath-beyond does not call back into perl, hence the cones can be computed in parallel threads
+template <typename Scalar>
+struct beneath_beyond_vertex_enumerator {
+   polytope::convex_hull_result<Scalar>
+   enumerate_vertices(const Matrix<Scalar>& inequalities, const Matrix<Scalar>& equations, const bool isCone) const
+   {
+      polytope::beneath_beyond_algo<Scalar> algo;
+      algo.expecting_redundant(true).for_cone(isCone).making_triangulation(false).computing_vertices(true);
+      algo.compute(inequalities, equations);
+      return { algo.getFacets(), algo.getAffineHull() };
+   }
+};
+
 template<typename Scalar, typename Matrix1, typename Matrix2>
 std::pair<SparseMatrix<Scalar>, SparseMatrix<Scalar>>
 vertices_from_ineqs(const GenericMatrix<Matrix1, Scalar>& inequalities,
                     const GenericMatrix<Matrix2, Scalar>& equations)
 {
-   BigObject C("Cone", mlist<Scalar>());
-   C.take("INEQUALITIES") << Matrix<Scalar>(inequalities);
-   C.take("EQUATIONS") << Matrix<Scalar>(equations);
-
-   SparseMatrix<Scalar> rays = C.give("RAYS");
-   SparseMatrix<Scalar> lineality = C.give("LINEALITY_SPACE");
+   const auto rays_and_lin = polytope::enumerate_vertices(inequalities, equations, true, beneath_beyond_vertex_enumerator<Scalar>());
+   SparseMatrix<Scalar> rays = rays_and_lin.first;
+   SparseMatrix<Scalar> lineality = rays_and_lin.second;
    orthogonalize(entire(rows(lineality)));
    project_to_orthogonal_complement(rays, lineality);
    return std::make_pair(rays, lineality);
@@ -132,7 +147,7 @@ cone_from_subdivision(const Matrix<Scalar>& V_full,
    for (auto s_it = entire(subdivision); !s_it.at_end(); ++s_it, ++sa_it)
       *sa_it = Set<Int>(*s_it);
    
-   const auto matrices = polytope::secondary_cone_ineq(V_full, subdivision_array, OptionSet());
+   const auto matrices = polytope::secondary_cone_ineq(V_full, subdivision_array, SparseMatrix<Scalar>(), Set<Int>());
    inequalities = matrices.first;
    equations    = matrices.second;
 
@@ -216,36 +231,91 @@ facet_indices_among_ineqs(const SparseMatrix<Scalar>& inequalities,
 }
 
 
+// Copies of the input matrices for a thread of its own,
+// since reference counters of shared matrices must not be touched concurrently.
+template <typename Scalar>
+struct flip_context {
+   flip_context(const Matrix<Scalar>& V_full_arg, const SparseMatrix<Scalar>& ker_arg, const SparseMatrix<Scalar>& restrict_to_arg)
+      : V_full(V_full_arg.minor(All, All))
+      , ker(ker_arg.minor(All, All))
+      , restrict_to(restrict_to_arg.minor(All, All)) {}
+
+   Matrix<Scalar> V_full;
+   SparseMatrix<Scalar> ker, restrict_to;
+};
+
+struct flip {
+   // index of the inequality of the secondary cone defining the facet
+   Int facet;
+   Subdivision subdivision;
+   // the simplices of the subdivision in sorted order, identifying it among the subdivisions already found
+   Set<Simplex> key;
+};
+
+// The secondary cone of a subdivision and the flips across its facets.
+template <typename Scalar>
+struct flip_result {
+   SparseMatrix<Scalar> rays, inequalities, equations;
+   std::vector<flip> flips;
+};
+
+Simplex
+permuted_simplex(const Simplex& sigma, const Array<Int>& g)
+{
+   Simplex image;
+   for (const Int i : sigma)
+      image += g[i];
+   return image;
+}
+
+// The other subdivisions in the orbit of a subdivision under the group generated by the given permutations,
+// each with a group element mapping the subdivision onto it.  Breadth-first search, applying the generators
+// to the subdivisions found so far.
+std::vector<std::pair<Set<Simplex>, Array<Int>>>
+orbit_of(const Set<Simplex>& key, const Array<Array<Int>>& generators)
+{
+   std::vector<std::pair<Set<Simplex>, Array<Int>>> orbit;
+   if (generators.empty())
+      return orbit;
+
+   hash_set<Set<Simplex>> in_orbit;
+   in_orbit += key;
+   orbit.emplace_back(key, Array<Int>(sequence(0, generators[0].size())));
+   for (size_t i = 0; i < orbit.size(); ++i) {
+      for (const auto& g : generators) {
+         Set<Simplex> image;
+         for (const auto& sigma : orbit[i].first)
+            image += permuted_simplex(sigma, g);
+         if (!in_orbit.collect(image)) {
+            // the group element g after the one leading to orbit[i]
+            Array<Int> h(orbit[i].second.size());
+            for (Int j = 0; j < h.size(); ++j)
+               h[j] = g[orbit[i].second[j]];
+            orbit.emplace_back(std::move(image), std::move(h));
+         }
+      }
+   }
+   // drop the subdivision itself, found first with the identity
+   orbit.erase(orbit.begin());
+   return orbit;
+}
+
+// Runs in a parallel thread: no access to perl, all shared input is taken from the own context.
 template<typename Scalar>
-void
+flip_result<Scalar>
 flip_from_subdivision(const Subdivision& subdivision,
-                      hash_set<Set<Simplex>>& seen_subdivisions,
-                      std::list<Subdivision>& active_subdivisions,
-                      const Matrix<Scalar>& V_full,
-                      const SparseMatrix<Scalar>& ker,
-                      hash_map<Vector<Scalar>, Int>& index_of,
-                      Int& next_index,
-                      FacetList& rays_in_max_cones,
-                      const SparseMatrix<Scalar>& restrict_to)
+                      const flip_context<Scalar>& context)
 {
-   seen_subdivisions += Set<Simplex>(entire(subdivision));
-   
-   SparseMatrix<Scalar> inequalities, equations;
-   const auto rays_and_lin = cone_from_subdivision(V_full, subdivision, restrict_to, inequalities, equations);
-   SparseMatrix<Scalar> R = rays_and_lin.first;
-   project_to_orthogonal_complement(R, ker);
+   flip_result<Scalar> result;
+   const auto rays_and_lin = cone_from_subdivision(context.V_full, subdivision, context.restrict_to, result.inequalities, result.equations);
+   result.rays = rays_and_lin.first;
+   project_to_orthogonal_complement(result.rays, context.ker);
 
-   rays_in_max_cones.insertMax(indices_of(R, index_of, next_index));
-   
    // process the facets of the cone, as they correspond to flips
-   const auto facet_indices(facet_indices_among_ineqs(inequalities, R));
+   const auto facet_indices(facet_indices_among_ineqs(result.inequalities, result.rays));
    for (Int i : facet_indices) {
-      if (restrict_to.rows() &&
-          ! polytope::H_input_feasible(inequalities, equations / restrict_to / inequalities[i]))
-            continue;
-
       Simplex neg_part, pos_part;
-      for (auto e = entire<indexed>(inequalities[i]); !e.at_end(); ++e) {
+      for (auto e = entire<indexed>(result.inequalities[i]); !e.at_end(); ++e) {
          if (*e > Scalar(0))
             pos_part += e.index();
          else
@@ -263,11 +333,110 @@ flip_from_subdivision(const Subdivision& subdivision,
       for (const auto& sigma: T_Z_minus) flipped_subdivision -= sigma;
       for (const auto& sigma: T_Z_plus)  flipped_subdivision += sigma;
 
-      if (!seen_subdivisions.collect(Set<Simplex>(entire(flipped_subdivision))))
-         active_subdivisions.push_back(flipped_subdivision);
+      Set<Simplex> key(entire(flipped_subdivision));
+      result.flips.push_back(flip{ i, std::move(flipped_subdivision), std::move(key) });
    }
+   return result;
+}
+
+// The maximal cone of the secondary fan and its images under the group elements
+// mapping the subdivision onto the others in its orbit.
+// A symmetry maps a height function h to h' with h'[g[i]] = h[i].
+template <typename Scalar>
+void
+add_max_cones(const SparseMatrix<Scalar>& rays,
+              const std::vector<Array<Int>>& orbit_elements,
+              hash_map<Vector<Scalar>, Int>& index_of,
+              Int& next_index,
+              FacetList& rays_in_max_cones)
+{
+   rays_in_max_cones.insertMax(indices_of(rays, index_of, next_index));
+   for (const auto& g : orbit_elements)
+      rays_in_max_cones.insertMax(indices_of(permuted_inv_cols(rays, g), index_of, next_index));
 }
    
+// The images of the maximal cones are only cones of the secondary fan if every symmetry
+// is induced by a linear transformation of the points and leaves the subspace restrict_to invariant.
+// Both properties carry over from the generators to the whole group.
+template <typename Scalar>
+void
+check_symmetry_group(const Array<Array<Int>>& generators,
+                     const Matrix<Scalar>& V_full,
+                     const SparseMatrix<Scalar>& restrict_to)
+{
+   const Int n = V_full.rows();
+   const Int restrict_rank = rank(restrict_to);
+   for (const auto& g : generators) {
+      if (g.size() != n || !is_permutation(g))
+         throw std::runtime_error("secondary_fan: the generators of the symmetry group must be permutations of the points");
+      // V and its permuted copy span the same column space iff the points are mapped linearly onto each other
+      if (rank(V_full | permuted_inv_rows(V_full, g)) != V_full.cols())
+         throw std::runtime_error("secondary_fan: the symmetry group does not preserve the point configuration");
+      if (restrict_rank != 0 && rank(restrict_to / permuted_cols(restrict_to, g)) != restrict_rank)
+         throw std::runtime_error("secondary_fan: restrict_to is not invariant under the symmetry group");
+   }
+}
+
+// Breadth-first search in the flip graph, level by level.  The secondary cones and the flips of a level
+// are computed in parallel; the rays are numbered and the new subdivisions are selected afterwards
+// in the order of the level, so that the result does not depend on the number of threads.
+// For a symmetry group, only one subdivision of each orbit is flipped; the whole orbit is marked as seen
+// as soon as it is reached.
+template <typename Scalar>
+void
+traverse_flip_graph(const Matrix<Scalar>& V_full,
+                    const SparseMatrix<Scalar>& ker,
+                    const SparseMatrix<Scalar>& restrict_to,
+                    const Subdivision& initial_subdivision,
+                    const Array<Array<Int>>& generators,
+                    const Int n_threads,
+                    hash_map<Vector<Scalar>, Int>& index_of,
+                    FacetList& rays_in_max_cones)
+{
+   std::vector<flip_context<Scalar>> contexts;
+   for (Int t = 0; t < n_threads; ++t)
+      contexts.emplace_back(V_full, ker, restrict_to);
+
+   hash_set<Set<Simplex>> seen_subdivisions;
+   Int next_index = 0;
+
+   std::vector<Subdivision> level;
+   // for each subdivision of the level, the group elements mapping it onto the others in its orbit
+   std::vector<std::vector<Array<Int>>> level_orbits;
+   const auto visit = [&](Subdivision&& subdivision, Set<Simplex>&& key) {
+      std::vector<Array<Int>> orbit_elements;
+      for (auto& image : orbit_of(key, generators)) {
+         seen_subdivisions += std::move(image.first);
+         orbit_elements.push_back(std::move(image.second));
+      }
+      seen_subdivisions += std::move(key);
+      level.push_back(std::move(subdivision));
+      level_orbits.push_back(std::move(orbit_elements));
+   };
+
+   visit(Subdivision(initial_subdivision), Set<Simplex>(entire(initial_subdivision)));
+   while (!level.empty()) {
+      auto results = parallel::transform(level, [&](const Subdivision& subdivision) {
+         return flip_from_subdivision(subdivision, contexts[parallel::thread_num()]);
+      });
+      const std::vector<std::vector<Array<Int>>> orbits = std::move(level_orbits);
+      level.clear();
+      level_orbits.clear();
+
+      for (size_t r = 0; r < results.size(); ++r) {
+         auto& result = results[r];
+         add_max_cones(result.rays, orbits[r], index_of, next_index, rays_in_max_cones);
+         for (auto& f : result.flips) {
+            if (restrict_to.rows() &&
+                ! polytope::H_input_feasible(result.inequalities, result.equations / restrict_to / result.inequalities[f.facet]))
+               continue;
+            if (!seen_subdivisions.contains(f.key))
+               visit(std::move(f.subdivision), std::move(f.key));
+         }
+      }
+   }
+}
+
 } // end anonymous namespace
    
 template<typename Scalar>
@@ -292,20 +461,16 @@ secondary_fan_impl(const Matrix<Scalar>& V_embed,
       initial_subdivision = find_initial_subdivision(V_full, restrict_to, seed);
    }
    
-   std::list<Subdivision> active_subdivisions;
-   active_subdivisions.emplace_back(initial_subdivision);
    const auto ker(find_lineality(V_full, initial_subdivision));
-   
-   hash_set<Set<Simplex>> seen_subdivisions;
+
+   const Array<Array<Int>> generators = options["symmetry_group"];
+   check_symmetry_group(generators, V_full, restrict_to);
+   const parallel::ThreadLimit threads(options["threads"]);
+
    FacetList rays_in_max_cones;
    hash_map<Vector<Scalar>, Int> index_of;
-   Int next_index = 0;
+   traverse_flip_graph(V_full, ker, restrict_to, initial_subdivision, generators, threads.get(), index_of, rays_in_max_cones);
 
-   while (active_subdivisions.size()) {
-      flip_from_subdivision(active_subdivisions.front(), seen_subdivisions, active_subdivisions, V_full, ker, index_of, next_index, rays_in_max_cones, restrict_to);
-      active_subdivisions.pop_front();
-   }
-   
    Matrix<Scalar> ordered_rays(index_of.size(), n);
    for (const auto& index_pair : index_of)
       ordered_rays[index_pair.second] = index_pair.first;
@@ -319,7 +484,7 @@ secondary_fan_impl(const Matrix<Scalar>& V_embed,
 }
 
 
-FunctionTemplate4perl("secondary_fan_impl<Scalar>(Matrix<Scalar> { initial_subdivision=>undef, restrict_to=>undef, seed=>undef })");
+FunctionTemplate4perl("secondary_fan_impl<Scalar>(Matrix<Scalar> { initial_subdivision=>undef, restrict_to=>undef, seed=>undef, symmetry_group=>undef, threads=>undef })");
 
 } }
 
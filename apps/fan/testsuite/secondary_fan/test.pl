@@ -0,0 +1,60 @@
+#  Copyright (c) 1997-2020
+#  Ewgenij Gawrilow, Michael Joswig, and the polymake team
+#  Technische Universität Berlin, Germany
+#  https://polymake.org
+#
+#  This program is free software; you can redistribute it and/or modify it
+#  under the terms of the GNU General Public License as published by the
+#  Free Software Foundation; either version 2, or (at your option) any
+#  later version: http://www.gnu.org/licenses/gpl.txt.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#-------------------------------------------------------------------------------
+
+# The secondary cones of a level of the flip graph are computed in parallel threads,
+# the rays are numbered afterwards, so the fan does not depend on the number of threads.
+
+# an affine image of the regular hexagon, its 14 triangulations form the maximal cones
+my $hexagon = new polytope::PointConfiguration(POINTS=>[ [1,1,0], [1,1,1], [1,0,1], [1,-1,0], [1,-1,-1], [1,0,-1] ]);
+my $fan_options = { initial_subdivision=>[ [0,1,2], [0,2,3], [0,3,4], [0,4,5] ] };
+my $rotation = [1,2,3,4,5,0];
+my $reflection = [2,1,0,5,4,3];
+
+# the maximal cones as sets of rays, independent of the numbering of the rays
+sub max_cones {
+   my ($f) = @_;
+   my $rays = $f->RAYS;
+   return new Set<Set<Vector<Rational>>>([ map { [ map { new Vector<Rational>($rays->row($_)) } @$_ ] } @{$f->MAXIMAL_CONES} ]);
+}
+
+my $f1 = secondary_fan($hexagon, %$fan_options, threads=>1);
+my $f4 = secondary_fan($hexagon, %$fan_options, threads=>4);
+check_boolean('n_max_cones', $f1->N_MAXIMAL_CONES == 14);
+compare_values('rays_4', $f1->RAYS, $f4->RAYS);
+compare_values('max_cones_4', $f1->MAXIMAL_CONES, $f4->MAXIMAL_CONES);
+
+# only the generators of the dihedral group are passed, the orbits are computed from them
+my $s1 = secondary_fan($hexagon, %$fan_options, symmetry_group=>[ $rotation, $reflection ], threads=>1);
+my $s4 = secondary_fan($hexagon, %$fan_options, symmetry_group=>[ $rotation, $reflection ], threads=>4);
+compare_values('sym_rays_4', $s1->RAYS, $s4->RAYS);
+compare_values('sym_max_cones_4', $s1->MAXIMAL_CONES, $s4->MAXIMAL_CONES);
+compare_values('sym_max_cones', max_cones($f1), max_cones($s1));
+compare_values('rotation_max_cones', max_cones($f1), max_cones(secondary_fan($hexagon, %$fan_options, symmetry_group=>[ $rotation ], threads=>4)));
+
+eval { secondary_fan($hexagon, %$fan_options, symmetry_group=>[ [0,0,2,3,4,5] ]) };
+check_boolean('not_a_permutation', $@ =~ /must be permutations of the points/);
+
+eval { secondary_fan($hexagon, %$fan_options, symmetry_group=>[ [1,0,2,3,4,5] ]) };
+check_boolean('not_linear', $@ =~ /does not preserve the point configuration/);
+
+eval { secondary_fan($hexagon, %$fan_options, restrict_to=>new Matrix<Rational>([[1,-1,0,0,0,0]]), symmetry_group=>[ $rotation ]) };
+check_boolean('restrict_to_not_invariant', $@ =~ /restrict_to is not invariant/);
+
+# Local Variables:
+# mode: perl
+# cperl-indent-level:3
+# indent-tabs-mode:nil
+# End:
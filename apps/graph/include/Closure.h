@@ -21,7 +21,11 @@
 #include "polymake/list"
 #include "polymake/FaceMap.h"
 #include "polymake/FacetList.h"
+#include "polymake/Bitset.h"
+#include "polymake/DenseIncidenceMatrix.h"
+#include "polymake/parallel.h"
 #include "polymake/graph/Decoration.h"
+#include <vector>
 
 namespace polymake { namespace graph { namespace lattice {
 
@@ -131,8 +135,15 @@ protected:
  *     an initial lattice given to the algorithm), this computes all the necessary closure data.
  *   - Iterator get_closure_iterator(const ClosureData& d) const: Given a node in the lattice, this provides
  *     an iterator over all the nodes lying "above" this node.
+ * - Optionally, if has_parallel_closures is specialized as true_type for it, it provides
+ *   - std::vector<std::vector<ClosureData>> compute_closures_above(const std::vector<const ClosureData*>& faces) const:
+ *     For each given node, this returns the nodes lying "above" it in the order of get_closure_iterator.
+ *     The nodes may be processed concurrently.
  */
 
+template <typename ClosureOperator>
+struct has_parallel_closures : std::false_type {};
+
 /*
  * The basic closure operator: The closure of a set is the intersection of all "facets" containing it.
  * If no facet contains the set, the closure is the full set.
@@ -218,6 +229,58 @@ public:
     return FaceIndexingData(fi, fi == -1, fi == -2);
   }
 
+  // The same closures as closures_above_iterator delivers, computed on bit sets in parallel.
+  // The threads only read the bit sets prepared in advance, as the reference counters of shared sets and matrices are not thread-safe.
+  // The number of threads is left to a ThreadLimit set up by the caller.
+  std::vector<std::vector<ClosureData>> compute_closures_above(const std::vector<const ClosureData*>& faces) const
+  {
+    if (facet_bits.rows() != facets.rows() || facet_bits.cols() != facets.cols())
+      facet_bits = DenseIncidenceMatrix(facets);
+
+    const Int n = faces.size();
+    std::vector<Bitset> face_bits(n), dual_face_bits(n);
+    for (Int i = 0; i < n; ++i) {
+      face_bits[i] = Bitset(faces[i]->get_face());
+      dual_face_bits[i] = Bitset(faces[i]->get_dual_face());
+    }
+    std::vector<std::vector<std::pair<Bitset, Bitset>>> closure_bits(n);
+
+    parallel::for_each(sequence(0, n), [&](Int i) {
+      Bitset candidates(total_size, true), minimal(total_size), face, dual_face, common;
+      candidates -= face_bits[i];
+      while (!candidates.empty()) {
+        const Int v = candidates.front();
+        candidates -= v;
+        dual_face = dual_face_bits[i];
+        dual_face *= facet_bits.col(v);
+        if (dual_face.empty())
+          face = Bitset(total_size, true);
+        else
+          face = facet_bits.rows_intersection(dual_face);
+        // The full set is rarely the minimal set - and if so, it is so for the last candidate
+        if (face.size() == total_size && !candidates.empty()) continue;
+        common = face;
+        common *= candidates;
+        if (common.empty()) {
+          common = face;
+          common *= minimal;
+          if (common.empty()) {
+            minimal += v;
+            closure_bits[i].emplace_back(face, dual_face);
+          }
+        }
+      }
+    }, 16);
+
+    std::vector<std::vector<ClosureData>> closures(n);
+    for (Int i = 0; i < n; ++i) {
+      closures[i].reserve(closure_bits[i].size());
+      for (const auto& c : closure_bits[i])
+        closures[i].emplace_back(Set<Int>(c.first), Set<Int>(c.second));
+    }
+    return closures;
+  }
+
   // Auxiliary methods
 
   Int total_set_size() const { return total_size; }
@@ -230,8 +293,13 @@ protected:
   Set<Int> total_set;
   ClosureData total_data;
   FaceMap<> face_index_map;
+  // facets as bit sets for compute_closures_above
+  mutable DenseIncidenceMatrix facet_bits;
 };
 
+template <typename Decoration>
+struct has_parallel_closures<BasicClosureOperator<Decoration>> : std::true_type {};
+
 } } }
 
 #endif
@@ -37,6 +37,7 @@ protected:
    double viscosity, inertion, epsilon, epsilon_2;
    double scale, eff_scale, rep, z_factor;
    double min_edge_weight, avg_edge_weight;
+   double theta;                // opening angle for the approximation of repulsion forces, 0 = exact computation
    Vector<double> z_ordering;
    double z_min, z_max;
    Set<Int> fixed_vertices;
@@ -50,6 +51,7 @@ protected:
 #endif
    void init_params(const OptionSet& options);
    void calculate_forces(const Matrix<double>& X, RandomSpherePoints<double>& random_points, Matrix<double>& F);
+   void add_approximate_forces(const Matrix<double>& X, RandomSpherePoints<double>& random_points, Matrix<double>& F);
 
 public:
    SpringEmbedder(const Graph<>& G_arg, const OptionSet& options)
@@ -63,6 +65,7 @@ public:
    double set_viscosity(double x) { double old=viscosity; viscosity=x; return old; }
    double set_inertion(double x) { double old=inertion; inertion=x; return old; }
    void set_eps(double eps) { epsilon=eps; epsilon_2 = eps*eps; }
+   double set_theta(double t) { double old=theta; theta=t; return old; }
 
    double get_viscosity() const { return viscosity; }
    double get_inertion() const { return inertion; }
@@ -24,6 +24,8 @@
 #include "polymake/graph/Decoration.h"
 #include "polymake/graph/Lattice.h"
 #include "polymake/graph/BasicLatticeTypes.h"
+#include "polymake/parallel.h"
+#include <vector>
 
 namespace polymake { namespace graph { namespace lattice_builder {
 
@@ -39,6 +41,40 @@ void add_edge(LType& lattice, Int from, Int to, bool_constant<dual>)
 using Primal = std::false_type;
 using Dual = std::true_type;
 
+// Process the queue node by node, computing the closures above each one on demand.
+template <typename ClosureOperator, typename Queue, typename Processor>
+void process_queue(ClosureOperator& cl, Queue& Q, const Processor& process, std::false_type)
+{
+  while (__builtin_expect(!Q.empty(),1)) {
+    const auto H = Q.front(); Q.pop_front();
+    process(H, cl.get_closure_iterator(H.first));
+  }
+}
+
+// Process the queue in batches: The closures above all nodes of a batch are computed in advance
+// (concurrently, if the closure operator supports it), then the nodes are processed in queue order as above.
+template <typename ClosureOperator, typename Queue, typename Processor>
+void process_queue(ClosureOperator& cl, Queue& Q, const Processor& process, std::true_type)
+{
+  using FaceData = typename ClosureOperator::ClosureData;
+  const size_t max_batch_size = 4096;
+  const parallel::ThreadLimit threads;
+  std::vector<std::pair<FaceData, Int>> batch;
+  std::vector<const FaceData*> batch_faces;
+  while (__builtin_expect(!Q.empty(),1)) {
+    batch.clear();
+    batch_faces.clear();
+    while (!Q.empty() && batch.size() < max_batch_size) {
+      batch.push_back(std::move(Q.front())); Q.pop_front();
+    }
+    for (const auto& H : batch)
+      batch_faces.push_back(&H.first);
+    const std::vector<std::vector<FaceData>> closures = cl.compute_closures_above(batch_faces);
+    for (size_t i = 0; i < batch.size(); ++i)
+      process(batch[i], entire(closures[i]));
+  }
+}
+
 /*
  * This runs the algorithm by Ganter / Kaibel,Pfetsch for a general closure system to compute the
  * lattice of all closed sets.
@@ -98,11 +134,10 @@ Lattice<Decoration, SeqType> compute_lattice_from_closure(
 
   std::list<Int> max_faces;
 
-  while (__builtin_expect(!Q.empty(),1)) {
-    std::pair<FaceData, Int> H = Q.front(); Q.pop_front();
+  auto process = [&](const std::pair<FaceData, Int>& H, auto&& faces) {
     const Decoration H_data = decor[H.second];
     bool is_max_face = true;
-    for (auto faces = cl.get_closure_iterator(H.first); !faces.at_end(); ++faces) {
+    for (; !faces.at_end(); ++faces) {
       lattice::FaceIndexingData node_index_data = cl.get_indexing_data(*faces);
       if (node_index_data.is_unknown) {
         Decoration node_data = decorator.compute_decoration(*faces, H_data);
@@ -120,7 +155,8 @@ Lattice<Decoration, SeqType> compute_lattice_from_closure(
       is_max_face = false;
     }
     if (is_max_face) max_faces.push_back(H.second);
-  }
+  };
+  process_queue(cl, Q, process, bool_constant<lattice::has_parallel_closures<ClosureOperator>::value>());
 
   if (wants_artificial_top_node) {
     Decoration max_decoration = decorator.compute_artificial_decoration(decor, max_faces);
@@ -20,95 +20,105 @@
 
 #include "polymake/Graph.h"
 #include "polymake/PowerSet.h"
-#include "polymake/Map.h"
+#include "polymake/SmallBitset.h"
+#include "polymake/parallel.h"
+#include <vector>
+#include <algorithm>
+#include <exception>
 
 /** @file max_cliques.h
- *  Algorithm for generating all maximal cliques of an undirected graph in lexicographical order.
- *  Based on the ideas described in:
+ *  Algorithm for generating all maximal cliques of an undirected graph:
+ *  a depth-first search with Tomita's pivoting rule, started from the nodes
+ *  in a degeneracy ordering, as described in:
  *
- *     Kazuhisa Makino and Takeaki Uno,
- *     New Algorithms for Enumerating All Maximal Cliques,
+ *     David Eppstein, Maarten Löffler, and Darren Strash,
+ *     Listing All Maximal Cliques in Sparse Graphs in Near-Optimal Time,
  *       in:
- *     T. Hagerup and J. Katajainen (Eds.),
- *     SWAT 2004: 9th Scandinavian Workshop On Algorithm Theory,
- *     Springer LNCS 3111, pp. 260-272, 2004
+ *     O. Cheong, K.-Y. Chwa, and K. Park (Eds.),
+ *     ISAAC 2010: 21st International Symposium on Algorithms and Computation,
+ *     Springer LNCS 6506, pp. 403-414, 2010
  */
 
 namespace polymake { namespace graph {
 
-template <typename Graph>
-class max_cliques_iterator {
-protected:
-   const Graph *G;
-   Map<Set<Int>, Int> Q;
-
-   void complete_clique(Set<Int>& set, Set<Int> neighbors);
-   Set<Int>& lex_min_clique(Set<Int>& set);
-   Set<Int> lex_min_clique(Int v);
-   void init();
+/** Enumeration of all maximal cliques of a graph at once.
+    Every node v starts an independent search for the cliques where it comes first in the degeneracy ordering.
+    Such a search only deals with the neighborhood of v, whose adjacency is encoded in bit sets local to the search;
+    the searches are distributed among parallel threads.
+*/
+class max_cliques_enumerator {
 public:
-   typedef Set<Int> value_type;
-   typedef const value_type& reference;
-   typedef const value_type* pointer;
-   typedef std::forward_iterator_tag iterator_category;
-   typedef ptrdiff_t difference_type;
-   typedef max_cliques_iterator iterator;
-   typedef max_cliques_iterator const_iterator;
-
-   max_cliques_iterator() : G(0) {}
-   max_cliques_iterator(const Graph& G_arg) : G(&G_arg) { init(); }
-
-   reference operator* () const { return Q.front().first; }
-   pointer operator-> () const { return &(operator*()); }
-
-   iterator& operator++();
-   const iterator operator++ (int) { iterator copy(*this); operator++(); return *this; }
-
-   bool at_end() const { return Q.empty(); }
-   bool operator== (const iterator& it) const
-   {
-      if (at_end()) return it.at_end();
-      return !it.at_end() && *(*this)==*it;
-   }
-   bool operator!= (const iterator& it) const { return !operator==(it); }
+   template <typename TGraph>
+   explicit max_cliques_enumerator(const GenericGraph<TGraph, Undirected>& G);
 
-   void rewind() { Q.clear(); init(); }
-};
+   /// Pass every maximal clique as a Set<Int> to @a consumer.
+   /// The order is not specified; the consumer is not called concurrently.
+   template <typename Consumer>
+   void for_each(Consumer&& consumer) const;
 
-} }
+   /// All maximal cliques in lexicographical order.
+   PowerSet<Int> lex_ordered() const;
 
-namespace pm {
+protected:
+   using local_set = SmallBitset<>;
 
-template <typename GraphRef>
-class generic_of_GraphComponents<GraphRef, polymake::graph::max_cliques_iterator>
-   : public GenericSet< GraphComponents<GraphRef,polymake::graph::max_cliques_iterator>, Set<Int>, operations::cmp > {};
+   void compute_degeneracy_ordering();
 
-}
+   template <typename Consumer>
+   void search_from(Int v, std::vector<Int>& local_index, Consumer& consumer) const;
 
-namespace polymake { namespace graph {
+   template <typename Report>
+   static void expand(std::vector<Int>& clique, local_set& P, local_set& X, const std::vector<local_set>& adj, const Report& report);
 
+   // sorted neighbor lists, empty for deleted nodes
+   std::vector<std::vector<Int>> adjacency;
+   std::vector<Int> order, position;
+};
+
+// all maximal cliques in lexicographical order
 template <typename TGraph>
-auto max_cliques(const GenericGraph<TGraph, Undirected>& G)
+PowerSet<Int> max_cliques(const GenericGraph<TGraph, Undirected>& G)
 {
-   return pm::GraphComponents<const TGraph&, max_cliques_iterator>(G.top());
+   return max_cliques_enumerator(G).lex_ordered();
 }
 
+// all maximal independent sets in lexicographical order
 template <typename TGraph>
-auto max_independent_sets(const GenericGraph<TGraph, Undirected>& G)
+PowerSet<Int> max_independent_sets(const GenericGraph<TGraph, Undirected>& G)
 {
-   return pm::GraphComponents<Graph<>&&, max_cliques_iterator>(~G);
+   // the complement graph is built on consecutively numbered nodes, deleted nodes are skipped
+   const Int n = G.top().nodes();
+   std::vector<Int> node_of;
+   node_of.reserve(n);
+   for (auto v = entire(nodes(G.top())); !v.at_end(); ++v)
+      node_of.push_back(v.index());
+
+   Graph<> complement(n);
+   for (Int i = 0; i < n; ++i)
+      for (Int j = i+1; j < n; ++j)
+         if (!G.top().edge_exists(node_of[i], node_of[j]))
+            complement.edge(i, j);
+
+   // renumbering preserves the order of nodes, hence the lexicographical order of the sets
+   PowerSet<Int> result;
+   for (const auto& K : max_cliques(complement)) {
+      Set<Int> S;
+      for (const Int i : K)
+         S.push_back(node_of[i]);
+      result.push_back(S);
+   }
+   return result;
 }
 
-} }
-
-namespace pm {
-template <typename Graph>
-struct check_iterator_feature<polymake::graph::max_cliques_iterator<Graph>, end_sensitive> : std::true_type {};
-template <typename Graph>
-struct check_iterator_feature<polymake::graph::max_cliques_iterator<Graph>, rewindable> : std::true_type {};
-
+// pass all maximal cliques to a consumer as soon as they are found, in no particular order
+template <typename TGraph, typename Consumer>
+void for_each_max_clique(const GenericGraph<TGraph, Undirected>& G, Consumer&& consumer)
+{
+   max_cliques_enumerator(G).for_each(std::forward<Consumer>(consumer));
 }
 
+} }
+
 #include "polymake/graph/max_cliques.tcc"
 
 #endif // POLYMAKE_GRAPH_MAX_CLIQUES_H
@@ -17,102 +17,177 @@
 
 namespace polymake { namespace graph {
 
-// complete the node set to the lexically minimal max. clique containing it
-template <typename Graph> inline
-void max_cliques_iterator<Graph>::complete_clique(Set<Int>& set, Set<Int> neighbors)
+template <typename TGraph>
+max_cliques_enumerator::max_cliques_enumerator(const GenericGraph<TGraph, Undirected>& G)
+   : adjacency(G.top().dim())
 {
-   while (!neighbors.empty()) {
-      const Int v = neighbors.front();
-      set += v;
-      neighbors *= G->adjacent_nodes(v);
+   std::vector<bool> valid(adjacency.size(), false);
+   for (auto n = entire(nodes(G.top())); !n.at_end(); ++n) {
+      adjacency[n.index()].assign(n.adjacent_nodes().begin(), n.adjacent_nodes().end());
+      valid[n.index()] = true;
    }
+   compute_degeneracy_ordering();
+   // deleted nodes don't start any search
+   order.erase(std::remove_if(order.begin(), order.end(), [&valid](Int v) { return !valid[v]; }),
+               order.end());
 }
 
-template <typename Graph>
-Set<Int>& max_cliques_iterator<Graph>::lex_min_clique(Set<Int>& set)
+// bucket algorithm of Batagelj and Zaversnik: repeatedly remove a node of minimal degree
+inline
+void max_cliques_enumerator::compute_degeneracy_ordering()
 {
-   complete_clique(set, accumulate(select(rows(adjacency_matrix(*G)), set), operations::mul()));
-   return set;
-}
-
-template <typename Graph>
-Set<Int> max_cliques_iterator<Graph>::lex_min_clique(Int v)
-{
-   Set<Int> set = scalar2set(v);
-   complete_clique(set, G->adjacent_nodes(v));
-   return set;
-}
+   const Int n = adjacency.size();
+   std::vector<Int> degree(n);
+   Int max_degree = 0;
+   for (Int v = 0; v < n; ++v) {
+      degree[v] = adjacency[v].size();
+      assign_max(max_degree, degree[v]);
+   }
 
-template <typename Graph>
-void max_cliques_iterator<Graph>::init()
-{
-   // Different from the cited paper, we start here with all locally lex-min cliques.
-   // (They are direct children of the globally lex-min clique anyway.)
-   // The reverse search part in the increment operator can be efficiently constrained to the neighborhood
-   // of the current clique.
-
-   for (auto n = entire(nodes(*G)); !n.at_end(); ++n) {
-      const Int v = n.index();
-      if (!n.degree() || n.adjacent_nodes().front()>v)
-         Q.push_back(lex_min_clique(v),v);
+   // bin_start[d] = position of the first node with degree d in order
+   std::vector<Int> bin_start(max_degree+1, 0);
+   for (Int v = 0; v < n; ++v)
+      ++bin_start[degree[v]];
+   for (Int d = 0, start = 0; d <= max_degree; ++d) {
+      const Int bin_size = bin_start[d];
+      bin_start[d] = start;
+      start += bin_size;
+   }
+   order.resize(n);
+   position.resize(n);
+   for (Int v = 0; v < n; ++v) {
+      position[v] = bin_start[degree[v]]++;
+      order[position[v]] = v;
+   }
+   for (Int d = max_degree; d > 0; --d)
+      bin_start[d] = bin_start[d-1];
+   bin_start[0] = 0;
+
+   for (Int i = 0; i < n; ++i) {
+      const Int v = order[i];
+      for (const Int u : adjacency[v]) {
+         if (degree[u] > degree[v]) {
+            // move u to the front of its bin and shift the bin boundary behind it
+            const Int du = degree[u], pu = position[u], pw = bin_start[du], w = order[pw];
+            if (u != w) {
+               position[u] = pw;  order[pw] = u;
+               position[w] = pu;  order[pu] = w;
+            }
+            ++bin_start[du];
+            --degree[u];
+         }
+      }
    }
 }
 
-template <typename Graph>
-max_cliques_iterator<Graph>& max_cliques_iterator<Graph>::operator++()
+// Bron-Kerbosch step: extend the clique by nodes from P; X contains the nodes excluded by earlier branches.
+// Branching on the neighbors of a pivot node u is redundant, u is chosen such that they are as many as possible.
+template <typename Report>
+void max_cliques_enumerator::expand(std::vector<Int>& clique, local_set& P, local_set& X, const std::vector<local_set>& adj, const Report& report)
 {
-   Set<Int> K = Q.front().first;
-   const Int parent_index = Q.front().second;
-   Q.pop_front();
-
-   // 1. Gather candidate expansion nodes from the neighborhood of K
-   // Only those with adj(i)*K_{<i} non-empty are interesting;
-   // since we are visiting the K's members in increasing order, this is equivalent to (adj(k)_{>k}) \ K
+   if (P.empty()) {
+      if (X.empty()) report(clique);
+      return;
+   }
 
-   Set<Int> candidates, neighborhood;
-   for (const Int k_el : K) {
-      candidates += (G->adjacent_nodes(k_el) >> std::max(k_el, parent_index)) - K;
+   Int pivot = -1, max_covered = -1;
+   for (const local_set* S : { &P, &X }) {
+      for (const Int u : *S) {
+         const Int covered = intersection_size(P, adj[u]);
+         if (covered > max_covered) {
+            max_covered = covered;
+            pivot = u;
+         }
+      }
    }
 
-   // 2. Check each candidate according to lemmas 3. and 4.
-   Set<Int> neighbors_of_K_i;
-   Set<Int>::const_iterator k_it = K.begin();
+   local_set branches(P);
+   branches -= adj[pivot];
+   for (const Int u : branches) {
+      local_set P_u(P), X_u(X);
+      P_u *= adj[u];
+      X_u *= adj[u];
+      clique.push_back(u);
+      expand(clique, P_u, X_u, adj, report);
+      clique.pop_back();
+      P -= u;
+      X += u;
+   }
+}
 
-   for (const Int i : candidates) {
-      while (!k_it.at_end()) {
-         if (*k_it > i) break;
-         neighbors_of_K_i += G->adjacent_nodes(*k_it) - K;
-         ++k_it;
+// all maximal cliques containing v and otherwise only neighbors of v later in the degeneracy ordering
+template <typename Consumer>
+void max_cliques_enumerator::search_from(Int v, std::vector<Int>& local_index, Consumer& consumer) const
+{
+   const std::vector<Int>& nb = adjacency[v];
+   const Int n_local = nb.size();
+   for (Int i = 0; i < n_local; ++i)
+      local_index[nb[i]] = i;
+
+   std::vector<local_set> adj(n_local, local_set(n_local));
+   local_set P(n_local), X(n_local);
+   for (Int i = 0; i < n_local; ++i) {
+      const Int u = nb[i];
+      if (position[u] > position[v])
+         P += i;
+      else
+         X += i;
+      for (const Int w : adjacency[u]) {
+         const Int j = local_index[w];
+         if (j >= 0) adj[i] += j;
       }
-      Set<Int> germ = (K << i) * G->adjacent_nodes(i);
-      auto nb_i = G->adjacent_nodes(i).begin();
-
-      // check other candidates whether they could have produced the same clique as this germ
-      for (Set<Int>::const_iterator j_it = neighbors_of_K_i.begin(); ; ++j_it) {
-         Int j;
-         if (j_it.at_end() || (j = *j_it) >= i) {
-            // no obstacles: bear a new child clique
-            Q[lex_min_clique(germ += i)] = i;
-            break;
+   }
+   for (const Int u : nb)
+      local_index[u] = -1;
+
+   std::vector<Int> clique;
+   expand(clique, P, X, adj, [&](const std::vector<Int>& local_clique) {
+      std::vector<Int> members(1, v);
+      members.reserve(local_clique.size()+1);
+      for (const Int i : local_clique)
+         members.push_back(nb[i]);
+      std::sort(members.begin(), members.end());
+      // The Set is created and destroyed under the lock too, as the consumer may share it with its own data.
+      // An exception must not leave the critical section; it is passed on behind it.
+      std::exception_ptr error;
+#pragma omp critical(max_cliques_consumer)
+      {
+         try {
+            Set<Int> K;
+            for (const Int u : members)
+               K.push_back(u);
+            consumer(K);
          }
-
-         if (incl(germ, G->adjacent_nodes(j)) <= 0) {
-            // the O(log(degree)) containment queries for each j in adj(i) replaced by parallel increasing of both iterators
-            bool j_in_nb_i = false;
-            while (!nb_i.at_end()) {
-               if (*nb_i == j) {
-                  j_in_nb_i = true;
-                  break;
-               }
-               if (*nb_i > j) break;
-               ++nb_i;
-            }
-            if (j_in_nb_i || incl(K << j, G->adjacent_nodes(j)) <= 0) break;
+         catch (...) {
+            error = std::current_exception();
          }
       }
-   }
+      if (error) std::rethrow_exception(error);
+   });
+}
+
+template <typename Consumer>
+void max_cliques_enumerator::for_each(Consumer&& consumer) const
+{
+   const parallel::ThreadLimit threads;
+   // scratch space of the searches, one per thread
+   std::vector<std::vector<Int>> local_index(parallel::max_threads(), std::vector<Int>(adjacency.size(), -1));
+   parallel::for_each(order, [&](Int v) {
+      search_from(v, local_index[parallel::thread_num()], consumer);
+   }, 16);
+}
 
-   return *this;
+inline
+PowerSet<Int> max_cliques_enumerator::lex_ordered() const
+{
+   std::vector<Set<Int>> cliques;
+   for_each([&cliques](const Set<Int>& K) { cliques.push_back(K); });
+   std::sort(cliques.begin(), cliques.end(),
+             [](const Set<Int>& K1, const Set<Int>& K2) { return operations::cmp()(K1, K2) == pm::cmp_lt; });
+   PowerSet<Int> result;
+   for (const Set<Int>& K : cliques)
+      result.push_back(K);
+   return result;
 }
 
 } }
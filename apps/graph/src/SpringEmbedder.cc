@@ -17,14 +17,28 @@
 
 #include "polymake/graph/SpringEmbedder.h"
 #include <cmath>
+#include <algorithm>
+#include <numeric>
 
 namespace polymake { namespace graph {
 
+namespace {
+
+// graphs with at least that many nodes are embedded with approximated repulsion forces by default
+constexpr Int approximation_threshold = 1000;
+constexpr double default_theta = 0.7;
+
+}
+
 void SpringEmbedder::init_params(const OptionSet& options)
 {
    if (!(options["eps"] >> epsilon)) epsilon=1e-4;
    epsilon_2=epsilon*epsilon;
 
+   if (!(options["theta"] >> theta)) theta = G.nodes() >= approximation_threshold ? default_theta : 0;
+   if (theta < 0)
+      throw std::runtime_error("negative opening angle theta");
+
    if (!(options["viscosity"] >> viscosity)) viscosity=1;
    if (!(options["inertion"] >> inertion)) inertion=1;
    if (!(options["scale"] >> scale)) scale=1;
@@ -115,6 +129,8 @@ void SpringEmbedder::calculate_forces(const Matrix<double>& X, RandomSpherePoint
    double new_z_min = X[0].back(), new_z_max=new_z_min;
    z_max -= z_min;
    if (gravity) barycenter.fill(0.);
+   // the octree is only implemented for 3-d embeddings without gaps in the node numbering
+   const bool approximate = theta > 0 && X.cols() == 3 && !G.has_gaps();
 
    for (auto this_node = entire(nodes(G)); !this_node.at_end(); ++this_node, ++f) {
       f->fill(0.);
@@ -127,6 +143,8 @@ void SpringEmbedder::calculate_forces(const Matrix<double>& X, RandomSpherePoint
          ++z;
       }
 
+      if (approximate) continue;
+
       auto edge = this_node.out_edges().begin();
 
       for (auto n2 = entire(nodes(G)); n2 != this_node; ++n2) {
@@ -158,6 +176,8 @@ void SpringEmbedder::calculate_forces(const Matrix<double>& X, RandomSpherePoint
       }
    }
 
+   if (approximate) add_approximate_forces(X, random_points, F);
+
    z_min = new_z_min;
    z_max = new_z_max;
    if (gravity) {
@@ -180,6 +200,273 @@ void SpringEmbedder::calculate_forces(const Matrix<double>& X, RandomSpherePoint
 
 namespace {
 
+/* Octree over the node positions for the approximation of repulsion forces following
+     Josh Barnes and Piet Hut:
+     A hierarchical O(N log N) force-calculation algorithm.
+     Nature Vol. 324, 446-449 (1986).
+   The repulsion exerted by all nodes in a cell is replaced by that of a single node of the joint weight placed in their
+   center of mass, as soon as the cell appears under an angle smaller than theta from the affected nodes.
+   The nodes are processed in groups, namely the leaves of the tree, sharing one list of interacting cells and nodes.
+*/
+class repulsion_octree {
+public:
+   explicit repulsion_octree(const Matrix<double>& X)
+      : n(X.rows())
+      , perm(n)
+      , pos(3*n)
+   {
+      std::iota(perm.begin(), perm.end(), 0);
+      const double* x = &*concat_rows(X).begin();
+      double lo[3], hi[3];
+      for (Int k = 0; k < 3; ++k) lo[k] = hi[k] = x[k];
+      for (Int i = 1; i < n; ++i)
+         for (Int k = 0; k < 3; ++k)
+            pm::assign_min_max(lo[k], hi[k], x[3*i+k]);
+
+      cells.emplace_back();
+      cell& root = cells.back();
+      root.half_width = 0;
+      for (Int k = 0; k < 3; ++k) {
+         root.center[k] = (lo[k]+hi[k])/2;
+         pm::assign_max(root.half_width, (hi[k]-lo[k])/2);
+      }
+      root.begin = 0;
+      root.end = n;
+      std::vector<Int> buffer(n), octant(n);
+      build(0, 0, x, buffer, octant);
+
+      for (Int p = 0; p < n; ++p)
+         std::copy(x + 3*perm[p], x + 3*perm[p] + 3, pos.begin() + 3*p);
+      compute_mass_centers();
+   }
+
+   // working storage for the interaction list of a leaf: nodes and centers of mass of entire cells
+   struct interaction_list {
+      std::vector<double> x, y, z, weight;
+      std::vector<Int> node;    // -1 for cells
+      std::vector<Int> stack;
+
+      void clear()
+      {
+         x.clear();  y.clear();  z.clear();  weight.clear();  node.clear();
+      }
+      void push(const double* p, double w, Int nd)
+      {
+         x.push_back(p[0]);  y.push_back(p[1]);  z.push_back(p[2]);  weight.push_back(w);  node.push_back(nd);
+      }
+   };
+
+   Int n_leaves() const { return leaves.size(); }
+
+   /* Add the repulsion acting on the nodes of the l-th leaf to their rows in f.
+      The interaction list is gathered once for all nodes of the leaf, and evaluated in a loop without branches.
+      Pairs of nodes closer than sqrt(epsilon_2) are reported in glued.
+   */
+   void leaf_repulsion(Int l, double rep, double theta_2, double epsilon_2, double* f,
+                       interaction_list& list, std::vector<std::pair<Int, Int>>& glued) const
+   {
+      const cell& leaf = cells[leaves[l]];
+      double lo[3], hi[3];
+      for (Int k = 0; k < 3; ++k) lo[k] = hi[k] = pos[3*leaf.begin+k];
+      for (Int p = leaf.begin+1; p < leaf.end; ++p)
+         for (Int k = 0; k < 3; ++k)
+            pm::assign_min_max(lo[k], hi[k], pos[3*p+k]);
+
+      list.clear();
+      list.stack.assign(1, 0);
+      while (!list.stack.empty()) {
+         const cell& c = cells[list.stack.back()];
+         list.stack.pop_back();
+         if (leaf.begin < c.begin || leaf.begin >= c.end) {
+            // c is neither the leaf itself nor one of its ancestors: measure the distance to the bounding box of the leaf
+            double d_sqr = 0;
+            for (Int k = 0; k < 3; ++k) {
+               const double m = c.mass_center[k],
+                            d = m < lo[k] ? lo[k]-m : m > hi[k] ? m-hi[k] : 0;
+               d_sqr += d*d;
+            }
+            const double width = 2*c.half_width;
+            if (width*width < theta_2*d_sqr) {
+               list.push(c.mass_center, double(c.end-c.begin), -1);
+               continue;
+            }
+         }
+         if (c.first_child >= 0) {
+            for (Int ch = c.first_child, ch_end = ch + c.n_children; ch < ch_end; ++ch)
+               list.stack.push_back(ch);
+         } else {
+            for (Int q = c.begin; q < c.end; ++q)
+               list.push(&pos[3*q], 1, perm[q]);
+         }
+      }
+
+      const Int n_list = list.x.size();
+      const double *lx = list.x.data(), *ly = list.y.data(), *lz = list.z.data(), *lw = list.weight.data();
+      for (Int p = leaf.begin; p < leaf.end; ++p) {
+         const double px = pos[3*p], py = pos[3*p+1], pz = pos[3*p+2];
+         double fx = 0, fy = 0, fz = 0;
+         Int n_close = 0;
+#pragma omp simd reduction(+:fx,fy,fz,n_close)
+         for (Int j = 0; j < n_list; ++j) {
+            const double dx = lx[j]-px, dy = ly[j]-py, dz = lz[j]-pz,
+                         d_sqr = dx*dx + dy*dy + dz*dz;
+            const bool apart = d_sqr > epsilon_2;
+            const double scale = apart ? -rep*lw[j] / (d_sqr*std::sqrt(d_sqr)) : 0;
+            n_close += !apart;
+            fx += scale*dx;  fy += scale*dy;  fz += scale*dz;
+         }
+         const Int this_node = perm[p];
+         double* fp = f + 3*this_node;
+         fp[0] += fx;  fp[1] += fy;  fp[2] += fz;
+
+         // the node itself is always among the close ones
+         if (n_close > 1) {
+            for (Int j = 0; j < n_list; ++j) {
+               const Int other = list.node[j];
+               if (other >= 0 && other < this_node) {
+                  const double dx = lx[j]-px, dy = ly[j]-py, dz = lz[j]-pz;
+                  if (dx*dx + dy*dy + dz*dz <= epsilon_2)
+                     glued.emplace_back(this_node, other);
+               }
+            }
+         }
+      }
+   }
+
+protected:
+   static constexpr Int leaf_size = 16;
+   // coinciding points can't be separated by further subdivision
+   static constexpr Int max_depth = 40;
+
+   struct cell {
+      double center[3], half_width;
+      double mass_center[3];
+      Int begin, end;           // range of points in tree order
+      Int first_child = -1, n_children = 0;
+   };
+
+   void build(Int c_index, Int depth, const double* x, std::vector<Int>& buffer, std::vector<Int>& octant)
+   {
+      const Int begin = cells[c_index].begin, end = cells[c_index].end;
+      if (end - begin <= leaf_size || depth == max_depth) {
+         leaves.push_back(c_index);
+         return;
+      }
+
+      Int counts[8] = { 0 };
+      const double* center = cells[c_index].center;
+      for (Int p = begin; p < end; ++p) {
+         const double* xp = x + 3*perm[p];
+         octant[p] = (xp[0] > center[0]) | (xp[1] > center[1]) << 1 | (xp[2] > center[2]) << 2;
+         ++counts[octant[p]];
+      }
+      Int starts[8];
+      for (Int o = 0, start = begin; o < 8; ++o) {
+         starts[o] = start;
+         start += counts[o];
+      }
+      Int fill[8];
+      std::copy(starts, starts+8, fill);
+      for (Int p = begin; p < end; ++p)
+         buffer[fill[octant[p]]++] = perm[p];
+      std::copy(buffer.begin()+begin, buffer.begin()+end, perm.begin()+begin);
+
+      const Int first_child = cells.size();
+      const double child_width = cells[c_index].half_width/2;
+      for (Int o = 0; o < 8; ++o) {
+         if (counts[o] == 0) continue;
+         cells.emplace_back();
+         cell& child = cells.back();
+         const cell& parent = cells[c_index];
+         for (Int k = 0; k < 3; ++k)
+            child.center[k] = parent.center[k] + ((o >> k) & 1 ? child_width : -child_width);
+         child.half_width = child_width;
+         child.begin = starts[o];
+         child.end = starts[o] + counts[o];
+      }
+      cells[c_index].first_child = first_child;
+      cells[c_index].n_children = cells.size() - first_child;
+      for (Int ch = first_child, ch_end = cells.size(); ch < ch_end; ++ch)
+         build(ch, depth+1, x, buffer, octant);
+   }
+
+   void compute_mass_centers()
+   {
+      // children are always created after their parents
+      for (auto c = cells.rbegin(); c != cells.rend(); ++c) {
+         double sum[3] = { 0, 0, 0 };
+         if (c->first_child >= 0) {
+            for (Int ch = c->first_child, ch_end = ch + c->n_children; ch < ch_end; ++ch)
+               for (Int k = 0; k < 3; ++k)
+                  sum[k] += cells[ch].mass_center[k] * double(cells[ch].end - cells[ch].begin);
+         } else {
+            for (Int p = c->begin; p < c->end; ++p)
+               for (Int k = 0; k < 3; ++k)
+                  sum[k] += pos[3*p+k];
+         }
+         for (Int k = 0; k < 3; ++k)
+            c->mass_center[k] = sum[k] / double(c->end - c->begin);
+      }
+   }
+
+   const Int n;
+   std::vector<Int> perm;       // tree order -> node
+   std::vector<double> pos;     // coordinates in tree order
+   std::vector<cell> cells;
+   std::vector<Int> leaves;
+};
+
+}
+
+// Repulsion between all nodes is approximated with the octree, the attraction along the edges is computed exactly.
+// The repulsion between neighbors, which is included in the former, is cancelled out.
+void SpringEmbedder::add_approximate_forces(const Matrix<double>& X, RandomSpherePoints<double>& random_points, Matrix<double>& F)
+{
+   const repulsion_octree tree(X);
+   const Int n_leaves = tree.n_leaves();
+   const double theta_2 = theta*theta;
+   double* const forces = &*concat_rows(F).begin();
+   std::vector<std::pair<Int, Int>> glued;
+
+#pragma omp parallel
+   {
+      repulsion_octree::interaction_list list;
+      std::vector<std::pair<Int, Int>> glued_here;
+#pragma omp for schedule(dynamic, 16)
+      for (Int l = 0; l < n_leaves; ++l)
+         tree.leaf_repulsion(l, rep, theta_2, epsilon_2, forces, list, glued_here);
+#pragma omp critical(spring_embedder_glued)
+      glued.insert(glued.end(), glued_here.begin(), glued_here.end());
+   }
+
+   // the nodes have been glued together: apply a moderate repulsion force in a random direction
+   std::sort(glued.begin(), glued.end());
+   for (const auto& g : glued) {
+      const Vector<double> repulsion=random_points.get();
+      F[g.first] -= repulsion;
+      F[g.second] += repulsion;
+   }
+
+   const double* const x = &*concat_rows(X).begin();
+   for (auto e = entire(edges(G)); !e.at_end(); ++e) {
+      const Int n1 = e.from_node(), n2 = e.to_node();
+      double delta[3];
+      for (Int k = 0; k < 3; ++k)
+         delta[k] = x[3*n2+k] - x[3*n1+k];
+      const double delta_sqr = delta[0]*delta[0] + delta[1]*delta[1] + delta[2]*delta[2];
+      if (delta_sqr > epsilon_2) {
+         const double delta_abs = std::sqrt(delta_sqr),
+                      scale = inv_wanted_length[*e] - 1/delta_abs + rep/delta_sqr/delta_abs;
+         for (Int k = 0; k < 3; ++k) {
+            forces[3*n1+k] += scale*delta[k];
+            forces[3*n2+k] -= scale*delta[k];
+         }
+      }
+   }
+}
+
+namespace {
+
 void calc_internal_constants(double& a, double& b, double& c, double& d, double viscosity, double inertion)
 {
    a=std::exp(-viscosity/inertion);
@@ -18,6 +18,7 @@
 #include "polymake/client.h"
 #include "polymake/graph/SpringEmbedder.h"
 #include "polymake/graph/connected.h"
+#include "polymake/parallel.h"
 
 namespace polymake { namespace graph {
 
@@ -43,6 +44,7 @@ Matrix<double> spring_embedder(const Graph<>& G, OptionSet options)
    SE.start_points(X,random_points.begin());
    Int max_iter;
    if (!(options["max-iterations"] >> max_iter)) max_iter=10000;
+   const parallel::ThreadLimit threads;
    if (! SE.calculate(X,random_points,max_iter))
       cerr << "WARNING: spring_embedder not converged after " << max_iter << " iterations" << endl;
    return con ? X : X.minor(~scalar2set(n),All);
@@ -75,6 +77,11 @@ UserFunction4perl("# @category Visualization"
                   "# @option Float eps a threshold for point movement between iterations, below that it is considered to stand still"
                   "# @option Int max-iterations hard limit for computational efforts."
                   "#  The algorithm terminates at latest after that many iterations regardless of the convergence achieved so far."
+                  "# @option Float theta accuracy of the repulsion forces between the nodes:"
+                  "#  they are approximated by a hierarchical subdivision of the space, treating node clusters"
+                  "#  visible under an angle smaller than theta as single nodes."
+                  "#  0 means exact computation, which costs quadratic time in the number of nodes."
+                  "#  By default, graphs with at least 1000 nodes are embedded with theta=0.7."
                   "# @example [nocompare] The following prints a 3-dimensional embedding of the complete graph on 3 nodes using a specific seed and scaled edge lengths:"
                   "# > print spring_embedder(complete(3)->ADJACENCY, scale=>5, seed=>123);"
                   "# | 0.9512273649 -10.00210559 10.36309695"
@@ -86,7 +93,7 @@ UserFunction4perl("# @category Visualization"
                   "spring_embedder(props::Graph<Undirected>, "
                   "   { scale => 1, balance => 1, viscosity => 1, inertion => 1, eps => undef,"
                   "     'z-ordering' => undef, 'z-factor' => undef, 'edge-weights' => undef,"
-                  "      seed => undef, 'max-iterations' => 10000 }) ");
+                  "      seed => undef, 'max-iterations' => 10000, theta => undef }) ");
 } }
 
 // Local Variables:
@@ -0,0 +1,42 @@
+#  Copyright (c) 1997-2020
+#  Ewgenij Gawrilow, Michael Joswig, and the polymake team
+#  Technische Universität Berlin, Germany
+#  https://polymake.org
+#
+#  This program is free software; you can redistribute it and/or modify it
+#  under the terms of the GNU General Public License as published by the
+#  Free Software Foundation; either version 2, or (at your option) any
+#  later version: http://www.gnu.org/licenses/gpl.txt.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#-------------------------------------------------------------------------------
+
+# maximal cliques of different sizes sharing nodes
+my $g = graph_from_edges([[2,0],[3,1],[4,0],[5,0],[5,1],[5,3],[6,1],[7,0]]);
+
+compare_values('cliques', new PowerSet<Int>([[0,2],[0,4],[0,5],[0,7],[1,3,5],[1,6]]), $g->MAX_CLIQUES);
+
+compare_values('independent_sets', new PowerSet<Int>([[0,1],[0,3,6],[1,2,4,7],[2,3,4,6,7],[2,4,5,6,7]]),
+               max_independent_sets($g->ADJACENCY));
+
+compare_values('two_triangles', new PowerSet<Int>([[0,1,2],[2,3],[3,4,5]]),
+               (new Graph<Undirected>(ADJACENCY=>[[1,2],[0,2],[0,1,3],[2,4,5],[3,5],[3,4]]))->MAX_CLIQUES);
+
+# deleted nodes keep their numbers
+my $a = new props::Graph(7);
+$a->edge(@$_) for [0,1],[1,2],[2,3],[3,4],[4,0],[0,5],[1,5];
+$a->delete_node(6);
+$a->delete_node(2);
+
+compare_values('gaps_cliques', new PowerSet<Int>([[0,1,5],[0,4],[3,4]]), max_cliques($a));
+
+compare_values('gaps_independent_sets', new PowerSet<Int>([[0,3],[1,3],[1,4],[3,5],[4,5]]), max_independent_sets($a));
+
+# Local Variables:
+# mode: perl
+# cperl-indent-level:3
+# indent-tabs-mode:nil
+# End:
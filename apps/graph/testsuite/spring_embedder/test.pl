@@ -0,0 +1,75 @@
+#  Copyright (c) 1997-2020
+#  Ewgenij Gawrilow, Michael Joswig, and the polymake team
+#  Technische Universität Berlin, Germany
+#  https://polymake.org
+#
+#  This program is free software; you can redistribute it and/or modify it
+#  under the terms of the GNU General Public License as published by the
+#  Free Software Foundation; either version 2, or (at your option) any
+#  later version: http://www.gnu.org/licenses/gpl.txt.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#-------------------------------------------------------------------------------
+
+# The repulsion forces between the nodes are approximated with an octree if theta > 0.
+# Below 1000 nodes the exact computation is the default, and the approximation
+# must lead to a layout of the same shape.
+
+my $C = cycle_graph(12)->ADJACENCY;
+compare_values('default_exact', spring_embedder($C, seed=>5, theta=>0), spring_embedder($C, seed=>5));
+
+eval { spring_embedder($C, theta=>-1) };
+check_boolean('negative_theta', $@ =~ /negative opening angle theta/);
+
+# 12x12 grid
+my $k = 12;
+my @edges;
+for my $i (0..$k-1) {
+   for my $j (0..$k-1) {
+      my $v = $i*$k+$j;
+      push @edges, [$v, $v+1] if $j+1 < $k;
+      push @edges, [$v, $v+$k] if $i+1 < $k;
+   }
+}
+my @adj;
+foreach (@edges) {
+   push @{$adj[$_->[0]]}, $_->[1];
+   push @{$adj[$_->[1]]}, $_->[0];
+}
+my $G = new props::Graph<Undirected>(\@adj);
+
+# mean edge length relative to the mean distance between any two nodes
+sub edge_ratio {
+   my ($X) = @_;
+   my $n = $X->rows;
+   my ($el, $rd, $pairs) = (0, 0, 0);
+   foreach (@edges) {
+      my $d = $X->row($_->[0]) - $X->row($_->[1]);
+      $el += sqrt($d*$d);
+   }
+   for my $a (0..$n-1) {
+      for my $b ($a+1..$n-1) {
+         my $d = $X->row($a) - $X->row($b);
+         $rd += sqrt($d*$d);
+         ++$pairs;
+      }
+   }
+   return ($el/@edges) / ($rd/$pairs);
+}
+
+my $exact = spring_embedder($G, seed=>1, theta=>0);
+my $approx = spring_embedder($G, seed=>1, theta=>0.7);
+check_boolean('dims', $approx->rows == $k*$k && $approx->cols == 3);
+
+my ($r_exact, $r_approx) = (edge_ratio($exact), edge_ratio($approx));
+check_boolean('grid_spread', $r_exact < 0.2 && $r_approx < 0.2);
+check_boolean('approx_shape', abs($r_approx-$r_exact) < 0.01*$r_exact);
+
+# Local Variables:
+# mode: perl
+# cperl-indent-level:3
+# indent-tabs-mode:nil
+# End:
@@ -21,21 +21,54 @@
 
 #include <polymake/Array.h>
 #include <polymake/Set.h>
+#include <polymake/Integer.h>
 #include <polymake/hash_set>
+#include <polymake/flat_hash_set>
 #include <polymake/Matrix.h>
 #include <polymake/group/action.h>
+#include <polymake/parallel.h>
 #include <queue>
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <algorithm>
 
 namespace polymake {
 namespace group {
 
-/*
- * Computes the orbit of element, where the group is spanned by generators
- */
-template<typename action_t, typename Perm, typename Element, typename Container=hash_set<Element>>
-auto
+// Containers whose elements are identified by hash_func and equality, so that the orbit can be split into shards by hash values.
+template <typename Container>
+struct orbit_in_shards : std::false_type {};
+
+template <typename Element>
+struct orbit_in_shards<flat_hash_set<Element>> : std::true_type {};
+
+template <typename Element>
+struct orbit_in_shards<hash_set<Element>> : std::true_type {};
+
+// Generators of which each thread can get its own copy: the actions create aliases of the generators,
+// whose reference counters must not be touched by several threads concurrently.
+template <typename Perm>
+struct copyable_per_thread : std::false_type {};
+
+template <>
+struct copyable_per_thread<Array<Int>> : std::true_type {
+   static Array<Int> copy(const Array<Int>& a) { return Array<Int>(a.size(), a.begin()); }
+};
+
+template <typename E>
+struct copyable_per_thread<Matrix<E>> : std::true_type {
+   static Matrix<E> copy(const Matrix<E>& m) { return Matrix<E>(m.rows(), m.cols(), concat_rows(m).begin()); }
+};
+
+// number of parts of the orbit merged independently from each other
+constexpr Int orbit_n_shards = 64;
+
+template <typename action_t, typename Perm, typename Element, typename Container>
+Container
 orbit_impl(const Array<Perm>& generators,
-           const Element& element)
+           const Element& element,
+           std::false_type)
 {
    std::vector<action_t> g_actions; g_actions.reserve(generators.size());
    for (const auto& g: generators)
@@ -58,7 +91,98 @@ orbit_impl(const Array<Perm>& generators,
    return orbit;
 }
 
-template<typename action_type, typename Perm, typename Element, typename Container=hash_set<Element>,
+/*
+ * Breadth-first search level by level.  The images of the elements found in the previous level are computed in parallel,
+ * each thread sorting the new ones into its own buffers by shards of the orbit.  Then each shard is merged by one thread.
+ * The threads only create new elements and read the shards and the previous level otherwise,
+ * and each of them applies its own copies of the generators,
+ * so that no reference counts of shared elements are touched concurrently.
+ */
+template <typename action_t, typename Perm, typename Element, typename Container>
+Container
+orbit_impl(const Array<Perm>& generators,
+           const Element& element,
+           std::true_type)
+{
+   const parallel::ThreadLimit threads;
+   const Int n_threads = parallel::max_threads();
+
+   std::vector<std::vector<Perm>> thread_generators(n_threads);
+   std::vector<std::vector<action_t>> thread_actions(n_threads);
+   for (Int t = 0; t < n_threads; ++t) {
+      thread_generators[t].reserve(generators.size());
+      for (const auto& g: generators)
+         thread_generators[t].push_back(copyable_per_thread<Perm>::copy(g));
+      for (const auto& g: thread_generators[t])
+         thread_actions[t].push_back(action_t(g));
+   }
+
+   const pm::hash_func<Element> hasher;
+   auto shard_of = [&hasher](const Element& e) -> Int {
+      const size_t h = hasher(e);
+      return (h ^ (h >> 29)) % orbit_n_shards;
+   };
+
+   std::vector<flat_hash_set<Element>> shards(orbit_n_shards);
+   shards[shard_of(element)].insert(element);
+   std::vector<Element> level{ element };
+   std::vector<std::vector<std::vector<Element>>> found(n_threads, std::vector<std::vector<Element>>(orbit_n_shards));
+   std::vector<std::vector<Element>> next_level(orbit_n_shards);
+
+   while (!level.empty()) {
+      const Int level_size = level.size();
+#pragma omp parallel for schedule(dynamic, 64) if (level_size >= 256)
+      for (Int i = 0; i < level_size; ++i) {
+         const Int thread = parallel::thread_num();
+         for (const auto& a: thread_actions[thread]) {
+            Element next = a(level[i]);
+            const Int s = shard_of(next);
+            if (!shards[s].exists(next))
+               found[thread][s].push_back(std::move(next));
+         }
+      }
+
+#pragma omp parallel for schedule(dynamic, 1) if (level_size >= 256)
+      for (Int s = 0; s < orbit_n_shards; ++s) {
+         for (auto& buffers : found) {
+            for (auto& e : buffers[s])
+               if (shards[s].insert(e).second)
+                  next_level[s].push_back(std::move(e));
+            buffers[s].clear();
+         }
+      }
+
+      level.clear();
+      for (auto& part : next_level) {
+         for (auto& e : part)
+            level.push_back(std::move(e));
+         part.clear();
+      }
+   }
+
+   Int orbit_size = 0;
+   for (const auto& shard : shards)
+      orbit_size += shard.size();
+   Container orbit(orbit_size);
+   for (const auto& shard : shards)
+      for (const auto& e : shard)
+         orbit.insert(e);
+   return orbit;
+}
+
+/*
+ * Computes the orbit of element, where the group is spanned by generators
+ */
+template<typename action_t, typename Perm, typename Element, typename Container=flat_hash_set<Element>>
+auto
+orbit_impl(const Array<Perm>& generators,
+           const Element& element)
+{
+   return orbit_impl<action_t, Perm, Element, Container>(generators, element,
+                                                         bool_constant<orbit_in_shards<Container>::value && copyable_per_thread<Perm>::value>());
+}
+
+template<typename action_type, typename Perm, typename Element, typename Container=flat_hash_set<Element>,
          typename op_tag=typename pm::object_traits<Element>::generic_tag, 
          typename perm_tag=typename pm::object_traits<Perm>::generic_tag,
          typename stores_ref=std::true_type>
@@ -70,7 +194,7 @@ unordered_orbit(const Array<Perm>& generators,
    return orbit_impl<action_t, Perm, Element, Container>(generators, element);
 }
    
-template<typename action_type, typename Perm, typename Element, typename Container=hash_set<Element>,
+template<typename action_type, typename Perm, typename Element, typename Container=flat_hash_set<Element>,
          typename op_tag=typename pm::object_traits<Element>::generic_tag, 
          typename perm_tag=typename pm::object_traits<Perm>::generic_tag,
          typename stores_ref=std::true_type>
@@ -83,6 +207,173 @@ orbit(const Array<Perm>& generators,
    return Set<Element>(entire(orbit_impl<action_t, Perm, Element, Container>(generators, element)));
 }
 
+
+/*
+ * The k-subsets of {0,...,n-1} as a bitmap indexed by their colexicographic rank,
+ * which is the sum of (b_i choose i) over the elements b_1 < ... < b_k.
+ * With one bit per subset it needs far less memory than a hash set of the subsets themselves.
+ * Elements are recorded with atomic operations, so that several threads may collect them concurrently.
+ */
+class SubsetBitmap {
+public:
+   // largest number of subsets handled, i.e. 1 GiB of bits
+   static constexpr Int max_size = Int(1) << 33;
+
+   static bool fits(Int n, Int k)
+   {
+      return k >= 0 && k <= n && Integer::binom(n, k) <= max_size;
+   }
+
+   SubsetBitmap(Int n_arg, Int k_arg)
+      : n(n_arg)
+      , k(k_arg)
+      , binom(k+1, std::vector<Int>(n+1, 0))
+   {
+      // entries beyond the number of subsets are never used for ranking, they are only kept from overflowing
+      const Int saturated = Int(1) << 61;
+      for (Int v = 0; v <= n; ++v) {
+         binom[0][v] = 1;
+         for (Int j = 1; j <= k && j <= v; ++j)
+            binom[j][v] = std::min(binom[j-1][v-1] + binom[j][v-1], saturated);
+      }
+      const Int n_words = (size() + 63) / 64;
+      words.reset(new std::atomic<uint64_t>[n_words]);
+      for (Int i = 0; i < n_words; ++i)
+         words[i].store(0, std::memory_order_relaxed);
+   }
+
+   Int size() const { return binom[k][n]; }
+   Int subset_size() const { return k; }
+
+   // subset must be sorted
+   Int rank(const std::vector<Int>& subset) const
+   {
+      Int r = 0;
+      for (Int i = 0; i < k; ++i)
+         r += binom[i+1][subset[i]];
+      return r;
+   }
+
+   void unrank(Int r, std::vector<Int>& subset) const
+   {
+      subset.resize(k);
+      for (Int i = k; i > 0; --i) {
+         // largest b with (b choose i) <= r
+         const Int b = std::upper_bound(binom[i].begin(), binom[i].begin()+n, r) - binom[i].begin() - 1;
+         r -= binom[i][b];
+         subset[i-1] = b;
+      }
+   }
+
+   bool contains(Int r) const
+   {
+      return words[r >> 6].load(std::memory_order_relaxed) & bit(r);
+   }
+
+   /// Add to the set, report true if existed formerly.
+   bool collect(Int r)
+   {
+      return words[r >> 6].fetch_or(bit(r), std::memory_order_relaxed) & bit(r);
+   }
+
+   /// The smallest rank not contained from r on, or size() if there is none.
+   Int next_missing(Int r) const
+   {
+      const Int n_ranks = size();
+      while (r < n_ranks) {
+         if ((r & 63) == 0 && words[r >> 6].load(std::memory_order_relaxed) == ~uint64_t(0)) {
+            r += 64;
+         } else {
+            if (!contains(r)) return r;
+            ++r;
+         }
+      }
+      return n_ranks;
+   }
+
+protected:
+   Int n, k;
+   // binom[j][v] = v choose j
+   std::vector<std::vector<Int>> binom;
+   std::unique_ptr<std::atomic<uint64_t>[]> words;
+
+   static uint64_t bit(Int r) { return uint64_t(1) << (r & 63); }
+};
+
+/*
+ * Explores the orbit of the subset with rank start under the permutations, marking its elements in the bitmap.
+ * Returns the size of the orbit; the subsets themselves are never materialized.
+ * The number of threads is left to a ThreadLimit set up by the caller.
+ */
+inline
+Int subset_orbit_size(const std::vector<std::vector<Int>>& generators, SubsetBitmap& visited, Int start)
+{
+   const Int n_threads = parallel::max_threads();
+   std::vector<std::vector<Int>> found(n_threads);
+   std::vector<Int> level{ start };
+   visited.collect(start);
+   Int orbit_size = 1;
+
+   while (!level.empty()) {
+      const Int level_size = level.size();
+#pragma omp parallel if (level_size >= 256) reduction(+:orbit_size)
+      {
+         const Int thread = parallel::thread_num();
+         std::vector<Int> subset, image(visited.subset_size());
+#pragma omp for schedule(dynamic, 256)
+         for (Int i = 0; i < level_size; ++i) {
+            visited.unrank(level[i], subset);
+            for (const auto& g : generators) {
+               for (Int j = 0; j < visited.subset_size(); ++j)
+                  image[j] = g[subset[j]];
+               std::sort(image.begin(), image.end());
+               const Int r = visited.rank(image);
+               if (!visited.collect(r)) {
+                  found[thread].push_back(r);
+                  ++orbit_size;
+               }
+            }
+         }
+      }
+      level.clear();
+      for (auto& f : found) {
+         level.insert(level.end(), f.begin(), f.end());
+         f.clear();
+      }
+   }
+   return orbit_size;
+}
+
+/// The size of the orbit, computed without storing the orbit elements if possible.
+template <typename action_type, typename Perm, typename Element>
+Int
+orbit_size(const Array<Perm>& generators,
+           const Element& element)
+{
+   return unordered_orbit<action_type, Perm, Element>(generators, element).size();
+}
+
+// sets of indices are counted in a SubsetBitmap
+template <typename action_type>
+std::enable_if_t<std::is_same<action_type, on_container>::value, Int>
+orbit_size(const Array<Array<Int>>& generators,
+           const Set<Int>& element)
+{
+   if (generators.empty()) return 1;
+   const Int n = generators[0].size();
+   if (!element.empty() && (element.front() < 0 || element.back() >= n))
+      throw std::runtime_error("orbit_size: set elements out of range");
+   if (!SubsetBitmap::fits(n, element.size()))
+      return unordered_orbit<on_container, Array<Int>, Set<Int>>(generators, element).size();
+
+   SubsetBitmap visited(n, element.size());
+   std::vector<std::vector<Int>> gens;
+   for (const auto& g : generators)
+      gens.emplace_back(g.begin(), g.end());
+   const parallel::ThreadLimit threads;
+   return subset_orbit_size(gens, visited, visited.rank(std::vector<Int>(element.begin(), element.end())));
+}
+
    
 namespace {
 
@@ -33,7 +33,7 @@ namespace {
 
 template <typename Element>
 struct set_chooser {
-   typedef hash_set<Element> type;
+   typedef flat_hash_set<Element> type;
 };
 
 template <>
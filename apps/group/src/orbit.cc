@@ -25,7 +25,7 @@ template<typename Scalar>
 auto
 orbit(const Array<Matrix<Scalar>>& gens, const Vector<Scalar>& v)
 {
-  return orbit<on_elements, Matrix<Scalar>, Vector<Scalar>, hash_set<Vector<Scalar>>, pm::is_vector, pm::is_matrix>(gens, v);
+  return orbit<on_elements, Matrix<Scalar>, Vector<Scalar>, flat_hash_set<Vector<Scalar>>, pm::is_vector, pm::is_matrix>(gens, v);
 }
 
 template<>
@@ -34,6 +34,31 @@ orbit(const Array<Matrix<double>>& gens, const Vector<double>& v)
 {
   return orbit<on_elements, Matrix<double>, Vector<double>, ApproximateSet<Vector<double>>, pm::is_vector, pm::is_matrix>(gens, v);
 }
+
+std::pair<Array<Set<Int>>, Array<Int>>
+subset_orbit_reps_and_sizes(const Array<Array<Int>>& generators, Int k)
+{
+  const Int n = generators.empty() ? 0 : generators[0].size();
+  if (!SubsetBitmap::fits(n, k))
+    throw std::runtime_error("subset_orbit_reps_and_sizes: too many subsets");
+
+  SubsetBitmap visited(n, k);
+  std::vector<std::vector<Int>> gens;
+  for (const auto& g : generators)
+    gens.emplace_back(g.begin(), g.end());
+
+  // scanning the ranks in increasing order, each orbit is first met at its colex-minimal element
+  const parallel::ThreadLimit threads;
+  std::vector<Set<Int>> reps;
+  std::vector<Int> sizes;
+  std::vector<Int> subset;
+  for (Int r = visited.next_missing(0); r < visited.size(); r = visited.next_missing(r+1)) {
+    visited.unrank(r, subset);
+    reps.push_back(Set<Int>(subset.begin(), subset.end()));
+    sizes.push_back(subset_orbit_size(gens, visited, r));
+  }
+  return std::make_pair(Array<Set<Int>>(reps.size(), reps.begin()), Array<Int>(sizes.size(), sizes.begin()));
+}
     
 UserFunctionTemplate4perl("# @category Utilities"
                          "# The image of an object //O// under a group element //g//."
@@ -69,6 +94,39 @@ InsertEmbeddedRule("# @category Orbits"
                    "   orbit<action_type>($_[0]->GENERATORS, $_[1]);\n"
                    "}\n");
 
+UserFunctionTemplate4perl("# @category Orbits"
+                          "# The size of the orbit of an object //O// under a group generated by //G//."
+                          "# For a set of indices acted on by permutations, the orbit is not stored as a whole,"
+                          "# only one bit for each subset of the same size is needed."
+                          "# @param Array G Group generators"
+                          "# @param Any O"
+                          "# @tparam action_type one of: [[on_container]], [[on_elements]], [[on_rows]], [[on_cols]], [[on_nonhomog_cols]]"
+                          "# @return Int"
+                          "# @example"
+                          "# > print orbit_size(cube_group(3)->PERMUTATION_ACTION, new Set<Int>(0,1));"
+                          "# | 12",
+                          "orbit_size<action_type=on_container>(Array, *)");
+
+InsertEmbeddedRule("# @category Orbits"
+                   "# The size of the orbit of a container //C// under a group //G//."
+                   "# @param Group G"
+                   "# @param Any C"
+                   "# @return Int\n"
+                   "user_function orbit_size<action_type=on_container>(PermutationAction, $) {\n"
+                   "   orbit_size<action_type>($_[0]->GENERATORS, $_[1]);\n"
+                   "}\n");
+
+UserFunction4perl("# @category Orbits"
+                  "# Representatives and sizes of the orbits of all //k//-subsets of the domain of a permutation group."
+                  "# The orbits are marked in a bitmap with one bit per subset, so that this works for far more subsets"
+                  "# than could be stored explicitly."
+                  "# Each representative is the colexicographically smallest set of its orbit."
+                  "# @param Array<Array<Int>> G group generators"
+                  "# @param Int k size of the subsets"
+                  "# @return Pair<Array<Set<Int>>,Array<Int>>",
+                  &subset_orbit_reps_and_sizes,
+                  "subset_orbit_reps_and_sizes(Array<Array<Int>>, $)");
+
 UserFunctionTemplate4perl("# @category Orbits\n"
 			  "# The indices of one representative for each orbit under the group generated by //G//."
 			  "# @param Array<GeneratorType> G Group generators"
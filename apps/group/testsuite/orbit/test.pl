@@ -0,0 +1,40 @@
+#  Copyright (c) 1997-2020
+#  Ewgenij Gawrilow, Michael Joswig, and the polymake team
+#  Technische Universität Berlin, Germany
+#  https://polymake.org
+#
+#  This program is free software; you can redistribute it and/or modify it
+#  under the terms of the GNU General Public License as published by the
+#  Free Software Foundation; either version 2, or (at your option) any
+#  later version: http://www.gnu.org/licenses/gpl.txt.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#-------------------------------------------------------------------------------
+
+# Orbits are collected in open-addressing hash sets.
+
+# symmetries of the 3-cube acting on its vertices, numbered by the binary representation of their coordinates
+my $cube_gens = new Array<Array<Int>>([[1,0,3,2,5,4,7,6], [0,2,1,3,4,6,5,7], [0,1,4,5,2,3,6,7]]);
+
+compare_values('cube_edges', new Set<Set<Int>>([[0,1],[0,2],[0,4],[1,3],[1,5],[2,3],[2,6],[3,7],[4,5],[4,6],[5,7],[6,7]]),
+               orbit($cube_gens, new Set<Int>(0,1)));
+compare_values('cube_face_diagonals', new Set<Set<Int>>([[0,3],[0,5],[0,6],[1,2],[1,4],[1,7],[2,4],[2,7],[3,5],[3,6],[4,7],[5,6]]),
+               orbit($cube_gens, new Set<Int>(0,3)));
+compare_values('cube_diagonals', new Set<Set<Int>>([[0,7],[1,6],[2,5],[3,4]]),
+               orbit($cube_gens, new Set<Int>(0,7)));
+
+# the dihedral group of order 8 acting on the plane
+my $square_gens = new Array<Matrix<Rational>>([ [[0,-1],[1,0]], [[1,0],[0,-1]] ]);
+compare_values('square_vector', new Set<Vector<Rational>>([[-2,-1],[-2,1],[-1,-2],[-1,2],[1,-2],[1,2],[2,-1],[2,1]]),
+               orbit($square_gens, new Vector<Rational>([1,2])));
+compare_values('square_axis', new Set<Vector<Rational>>([[-1,0],[0,-1],[0,1],[1,0]]),
+               orbit($square_gens, new Vector<Rational>([0,1])));
+
+# Local Variables:
+# mode: perl
+# cperl-indent-level:3
+# indent-tabs-mode:nil
+# End:
@@ -0,0 +1,55 @@
+#  Copyright (c) 1997-2020
+#  Ewgenij Gawrilow, Michael Joswig, and the polymake team
+#  Technische Universität Berlin, Germany
+#  https://polymake.org
+#
+#  This program is free software; you can redistribute it and/or modify it
+#  under the terms of the GNU General Public License as published by the
+#  Free Software Foundation; either version 2, or (at your option) any
+#  later version: http://www.gnu.org/licenses/gpl.txt.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#-------------------------------------------------------------------------------
+
+# Orbit sizes of index sets are counted in a bitmap of all subsets of the same size;
+# large orbits are enumerated level by level in parallel.
+
+# symmetries of the 3-cube acting on its vertices, numbered by the binary representation of their coordinates
+my $cube_gens = new Array<Array<Int>>([[1,0,3,2,5,4,7,6], [0,2,1,3,4,6,5,7], [0,1,4,5,2,3,6,7]]);
+
+compare_values('edge_orbit_size', 12, orbit_size($cube_gens, new Set<Int>(0,1)));
+compare_values('diagonal_orbit_size', 4, orbit_size($cube_gens, new Set<Int>(0,7)));
+compare_values('vertex_orbit_size', 8, orbit_size($cube_gens, new Set<Int>(5)));
+compare_values('empty_orbit_size', 1, orbit_size($cube_gens, new Set<Int>()));
+
+my $pairs = subset_orbit_reps_and_sizes($cube_gens, 2);
+compare_values('pair_reps', new Array<Set<Int>>([[0,1],[1,2],[3,4]]), $pairs->first);
+compare_values('pair_sizes', new Array<Int>([12,12,4]), $pairs->second);
+
+my $triples = subset_orbit_reps_and_sizes($cube_gens, 3);
+compare_values('triple_reps', new Array<Set<Int>>([[0,1,2],[1,2,4],[0,3,4]]), $triples->first);
+compare_values('triple_sizes', new Array<Int>([24,8,24]), $triples->second);
+
+eval { orbit_size($cube_gens, new Set<Int>(3,8)) };
+check_boolean('out_of_range', $@ =~ /out of range/);
+
+# the symmetric group on 16 points, generated by the adjacent transpositions:
+# the breadth-first search from a 6-set passes through levels of more than 300 subsets
+my $n = 16;
+my $sym_gens = new Array<Array<Int>>([ map { my $i = $_; [ map { $_ == $i ? $i+1 : $_ == $i+1 ? $i : $_ } 0..$n-1 ] } 0..$n-2 ]);
+my $six = new Set<Int>(0..5);
+
+compare_values('sym_orbit', new Set<Set<Int>>(all_subsets_of_k(range(0, $n-1), 6)), orbit($sym_gens, $six));
+compare_values('sym_orbit_size', 8008, orbit_size($sym_gens, $six));
+my $sym_six = subset_orbit_reps_and_sizes($sym_gens, 6);
+compare_values('sym_reps', new Array<Set<Int>>([$six]), $sym_six->first);
+compare_values('sym_sizes', new Array<Int>([8008]), $sym_six->second);
+
+# Local Variables:
+# mode: perl
+# cperl-indent-level:3
+# indent-tabs-mode:nil
+# End:
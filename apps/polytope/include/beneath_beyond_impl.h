@@ -26,10 +26,14 @@
 #include "polymake/IncidenceMatrix.h"
 #include "polymake/Graph.h"
 #include "polymake/Bitset.h"
+#include "polymake/SmallBitset.h"
 #include "polymake/Set.h"
 #include "polymake/Array.h"
 #include "polymake/list"
+#include "polymake/parallel.h"
 #include <deque>
+#include <numeric>
+#include <cmath>
 
 namespace polymake { namespace polytope {
 
@@ -46,6 +50,9 @@ public:
       , make_triangulation(true)
       , is_cone(false)
       , compute_vertices(false)
+      , batch_size(0)
+      , batch_row(-1)
+      , track_changes(false)
    {
       dual_graph.attach(facets);
       dual_graph.attach(ridges);
@@ -83,6 +90,17 @@ public:
       return *this;
    }
 
+   /// size>1: evaluate the positions of the next size points relative to all current facets in parallel
+   /// size<=1: evaluate each scalar product on demand (default)
+   /// The results do not depend on this setting.
+   /// A batch costs more scalar products than the search for the visible facets of its points,
+   /// which only visits the facets around the visible region; hence batches are formed only if more than one thread is allowed.
+   beneath_beyond_algo& parallel_visibility(Int size)
+   {
+      batch_size = size;
+      return *this;
+   }
+
    void compute(const Matrix<E>& rays, const Matrix<E>& lins)
    {
 #if POLYMAKE_DEBUG
@@ -95,7 +113,18 @@ public:
    template <typename Iterator>
    void compute(const Matrix<E>& rays, const Matrix<E>& lins, Iterator perm);
 
+   /// Continue a computation which has produced a full-dimensional polytope or cone without linealities.
+   /// The new points must have been appended to the matrix passed to compute() as rays;
+   /// perm enumerates their row indices.
+   /// The facets keep their numbers, which are only valid until the next call.
+   /// Facets deleted, created, or gaining new vertices are reported by getChangedFacets().
+   template <typename Iterator>
+   void add_points(Iterator perm);
+
    Matrix<E> getFacets() const;
+   // the rows of getFacets() one at a time, until consume returns false
+   template <typename Consumer>
+   void visitFacets(Consumer&& consume) const;
    IncidenceMatrix<> getVertexFacetIncidence() const;
    Matrix<E> getAffineHull() const;
    Matrix<E> getVertices() const;
@@ -137,6 +166,27 @@ public:
       return generic_position;
    }
 
+   /// numbers of the facets touched by the last call of add_points()
+   const Bitset& getChangedFacets() const
+   {
+      return changed_facets;
+   }
+
+   bool facetExists(Int f) const
+   {
+      return dual_graph.node_exists(f);
+   }
+
+   const Set<Int>& getFacetVertices(Int f) const
+   {
+      return facets[f].vertices;
+   }
+
+   const Vector<E>& getFacetNormal(Int f) const
+   {
+      return facets[f].normal;
+   }
+
 protected:
    // connects a facet with a triangulation simplex
    struct incident_simplex {
@@ -174,7 +224,7 @@ protected:
       friend void relocate(facet_info* from, facet_info* to)
       {
          relocate(&from->normal, &to->normal);
-         relocate(&from->sqr_normal, &to->sqr_normal);
+         pm::relocate(&from->sqr_normal, &to->sqr_normal);
          to->orientation = from->orientation;
          relocate(&from->vertices, &to->vertices);
          pm::relocate(&from->simplices, &to->simplices);
@@ -199,6 +249,7 @@ protected:
    bool make_triangulation;
    bool is_cone;
    bool compute_vertices;
+   Int batch_size;
 
    enum class compute_state { zero, one, low_dim, full_dim };
    compute_state state;
@@ -222,11 +273,20 @@ protected:
    // These are working variables valid within one algo step.
    // We define them as instance variables nevertheless to avoid the repeating allocation and deallocation.
    Bitset vertices_this_step,           // points proved to be non-redundant
-          interior_points_this_step,    // points that could be redundant
-          visited_facets;               // facets seen
+          interior_points_this_step;    // points that could be redundant
+   SmallBitset<> visited_facets;        // facets seen
 
    std::deque<Int> facet_queue;   // BFS queue for update_facets()
 
+   // Scalar products of facet normals with the points of the current batch, computed in advance in parallel.
+   // batch_products is a row-wise matrix batch_points.size() x batch_width, indexed by the node numbers of facets.
+   // Facets created or deleted after the evaluation are not in batch_facets; their products are computed on demand.
+   std::vector<Int> batch_points;
+   std::vector<E> batch_products;
+   Int batch_width;
+   Int batch_row;                 // position of the point currently being processed in batch_points, or -1
+   SmallBitset<> batch_facets;
+
    // accumulates the non-redundant points; is filled until the polytope turns out to be full-dimensional
    Set<Int> vertices_so_far;
    Int triang_size;     // = triangulation.size();
@@ -236,6 +296,18 @@ protected:
    bool generic_position;
    bool facet_normals_valid;
 
+   // only collected during add_points()
+   bool track_changes;
+   Bitset changed_facets;
+
+   void facet_changed(Int f)
+   {
+      if (track_changes) changed_facets += f;
+   }
+
+   template <typename Iterator>
+   void process_points(Iterator& perm);
+
    void process_point(Int p);
 
    void add_second_point(Int p);
@@ -250,6 +322,57 @@ protected:
    // helper function for add_point_full_dim
    Int descend_to_violated_facet(Int f, Int p);
 
+   // facets[f].normal * points->row(p), taken from the batch if available
+   E facet_times_point(Int f, Int p) const;
+
+   // compute the scalar products of all current facets with all points in batch_points
+   void evaluate_batch();
+
+   // same evaluation order in sequential and parallel mode guarantees identical results for inexact types too
+   template <typename T>
+   static T scalar_product(const T* normal, const T* point, Int d)
+   {
+      T x = normal[0] * point[0];
+      for (Int i = 1; i < d; ++i)
+         x += normal[i] * point[i];
+      return x;
+   }
+
+   // four independent partial sums, to be kept in one SIMD register
+   static double scalar_product(const double* normal, const double* point, Int d)
+   {
+      double x[4] = { 0., 0., 0., 0. };
+      Int i = 0;
+      for (; i+4 <= d; i += 4)
+         for (Int k = 0; k < 4; ++k)
+            x[k] += normal[i+k] * point[i+k];
+      for (; i < d; ++i)
+         x[0] += normal[i] * point[i];
+      return (x[0] + x[1]) + (x[2] + x[3]);
+   }
+
+   // orientation of a point w.r.t. a facet, given the scalar product
+   template <typename T>
+   static Int product_sign(const T& x)
+   {
+      return sign(x);
+   }
+
+   // floating-point products are tested against the EPSILON of the cone
+   static Int product_sign(double x)
+   {
+      return is_zero(x) ? 0 : sign(x);
+   }
+
+   // a normal vector of the hyperplane through the given points
+   template <typename T>
+   static Vector<T> hyperplane_normal(const Matrix<T>& pts, const Set<Int>& vertices)
+   {
+      return rows(null_space(pts.minor(vertices, All))).front();
+   }
+
+   static Vector<double> hyperplane_normal(const Matrix<double>& pts, const Set<Int>& vertices);
+
    // helper functions
    void facet_normals_low_dim();
    bool reduce_nullspace(ListMatrix<SparseVector<E>>& M, Int p) const;
@@ -315,6 +438,19 @@ Matrix<E> beneath_beyond_algo<E>::getFacets() const
    }
 }
 
+template <typename E>
+template <typename Consumer>
+void beneath_beyond_algo<E>::visitFacets(Consumer&& consume) const
+{
+   if (linealities->rows() != 0) {
+      for (auto f = entire(facets); !f.at_end(); ++f)
+         if (!consume(Vector<E>(lineality_transform * (f->normal | zero_vector<E>(linealities->rows()))))) return;
+   } else {
+      for (auto f = entire(facets); !f.at_end(); ++f)
+         if (!consume(f->normal)) return;
+   }
+}
+
 template <typename E>
 Matrix<E> beneath_beyond_algo<E>::getAffineHull() const
 {
@@ -402,12 +538,14 @@ void beneath_beyond_algo<E>::compute(const Matrix<E>& rays, const Matrix<E>& lin
          interior_points_this_step.resize(points->rows());
       }
 
-      for (state = compute_state::zero; !perm.at_end(); ++perm)
-         process_point(*perm);
+      state = compute_state::zero;
+      process_points(perm);
       if (state == compute_state::low_dim && !facet_normals_valid)
          facet_normals_low_dim();
    }
    catch (const stop_calculation&) {
+      batch_row = -1;
+      batch_facets.clear();
 #if POLYMAKE_DEBUG
       if (debug >= do_dump) cout << "stop: degenerated to full linear space" << endl;
 #endif
@@ -452,6 +590,49 @@ void beneath_beyond_algo<E>::compute(const Matrix<E>& rays, const Matrix<E>& lin
 #endif
 }
 
+template <typename E>
+template <typename Iterator>
+void beneath_beyond_algo<E>::add_points(Iterator perm)
+{
+   if (state != compute_state::full_dim || points != source_points)
+      throw std::runtime_error("beneath_beyond_algo: can only add points to a full-dimensional hull without linealities");
+
+   if (expect_redundant) {
+      interior_points.resize(points->rows());
+      vertices_this_step.resize(points->rows());
+      interior_points_this_step.resize(points->rows());
+   }
+   // the facets might have been renumbered at the end of compute()
+   if (dual_graph.invalid_node(valid_facet))
+      valid_facet = nodes(dual_graph).front();
+
+   changed_facets.clear();
+   track_changes = true;
+   process_points(perm);
+   track_changes = false;
+}
+
+template <typename E>
+template <typename Iterator>
+void beneath_beyond_algo<E>::process_points(Iterator& perm)
+{
+   while (!perm.at_end()) {
+      if (batch_size > 1 && state == compute_state::full_dim && parallel::max_threads() > 1) {
+         batch_points.clear();
+         for (Int i = 0; i < batch_size && !perm.at_end(); ++i, ++perm)
+            batch_points.push_back(*perm);
+         evaluate_batch();
+         for (batch_row = 0; batch_row < Int(batch_points.size()); ++batch_row)
+            process_point(batch_points[batch_row]);
+         batch_row = -1;
+         batch_facets.clear();
+      } else {
+         process_point(*perm);
+         ++perm;
+      }
+   }
+}
+
 template <typename E>
 void beneath_beyond_algo<E>::process_point(const Int p)
 {
@@ -575,8 +756,8 @@ template <typename E>
 Int beneath_beyond_algo<E>::descend_to_violated_facet(Int f, Int p)
 {
    visited_facets += f;
-   E fxp = facets[f].normal * points->row(p);
-   if ((facets[f].orientation = sign(fxp)) <= 0) return f;
+   E fxp = facet_times_point(f, p);
+   if ((facets[f].orientation = product_sign(fxp)) <= 0) return f;
 
    // starting facet stays valid in this step: let's look for another one violated by p.
    // The search is performed in the dual graph, following the steepest descend of the
@@ -597,8 +778,8 @@ Int beneath_beyond_algo<E>::descend_to_violated_facet(Int f, Int p)
          if (visited_facets.contains(f2)) continue;
 
          visited_facets += f2;
-         E f2xp = facets[f2].normal * points->row(p);
-         if ((facets[f2].orientation = sign(f2xp)) <= 0) return f2;
+         E f2xp = facet_times_point(f2, p);
+         if ((facets[f2].orientation = product_sign(f2xp)) <= 0) return f2;
 
          if (expect_redundant) vertices_this_step += facets[f2].vertices;
          f2xp = f2xp * f2xp / facets[f2].sqr_normal;
@@ -616,6 +797,40 @@ Int beneath_beyond_algo<E>::descend_to_violated_facet(Int f, Int p)
    return f;    // -1 : local minimum of sqr(distance) reached
 }
 
+template <typename E>
+E beneath_beyond_algo<E>::facet_times_point(Int f, Int p) const
+{
+   if (batch_row >= 0 && batch_points[batch_row] == p && batch_facets.contains(f))
+      return batch_products[batch_row * batch_width + f];
+   return scalar_product(&*facets[f].normal.begin(), &*concat_rows(*points).begin() + p * points->cols(), points->cols());
+}
+
+template <typename E>
+void beneath_beyond_algo<E>::evaluate_batch()
+{
+   // collect all data pointers in advance: the parallel section must not touch any reference counters
+   batch_width = dual_graph.dim();
+   std::vector<const E*> normals;
+   normals.reserve(dual_graph.nodes());
+   std::vector<Int> facet_indices;
+   facet_indices.reserve(dual_graph.nodes());
+   batch_facets.clear();
+   const facets_t& const_facets = facets;
+   for (auto f = entire(nodes(dual_graph)); !f.at_end(); ++f) {
+      normals.push_back(&*const_facets[f.index()].normal.begin());
+      facet_indices.push_back(f.index());
+      batch_facets += f.index();
+   }
+   const Int n_facets = facet_indices.size(), n_points = batch_points.size(), d = points->cols();
+   const E* point_data = &*concat_rows(*points).begin();
+   batch_products.resize(n_points * batch_width);
+
+   parallel::for_each(sequence(0, n_facets), [&](Int k) {
+      for (Int i = 0; i < n_points; ++i)
+         batch_products[i * batch_width + facet_indices[k]] = scalar_product(normals[k], point_data + batch_points[i] * d, d);
+   }, 16);
+}
+
 namespace {
 
 template <typename TSet>
@@ -770,6 +985,7 @@ void beneath_beyond_algo<E>::update_facets(Int f, const Int p)
       facets[f].vertices += p;
       generic_position = false;
       incident_facets.push_back(f);
+      facet_changed(f);
    }
 
    /* BFS in the visible hemisphere.
@@ -810,12 +1026,13 @@ void beneath_beyond_algo<E>::update_facets(Int f, const Int p)
          facet_info& nbf = facets[f2];
          if (!visited_facets.contains(f2)) {
             visited_facets += f2;
-            nbf.orientation = sign(nbf.normal * points->row(p));
+            nbf.orientation = product_sign(facet_times_point(f2, p));
             if (nbf.orientation == 0) {
                // incident facet
                nbf.vertices += p;
                generic_position = false;
                incident_facets.push_back(f2);
+               facet_changed(f2);
             }
             if (nbf.orientation <= 0)
                facet_queue.push_back(f2);
@@ -838,6 +1055,7 @@ void beneath_beyond_algo<E>::update_facets(Int f, const Int p)
 #endif
                ridges(nf_index, f2) = ridges[*e];
                incident_facets.push_back(nf_index);
+               facet_changed(nf_index);
                if (make_triangulation) {
                   nf.add_incident_simplices(triangulation.begin(), new_simplex_end);
                }
@@ -851,7 +1069,11 @@ void beneath_beyond_algo<E>::update_facets(Int f, const Int p)
          }
       }
 
-      if (f_orientation < 0) dual_graph.delete_node(f);
+      if (f_orientation < 0) {
+         batch_facets -= f;
+         dual_graph.delete_node(f);
+         facet_changed(f);
+      }
    }
 
    if (expect_redundant) {
@@ -954,6 +1176,8 @@ void beneath_beyond_algo<E>::process_new_lineality(const Int p, const std::list<
    }
 
    add_linealities(rays_in_lineality);
+   // the points have been transformed, all precomputed products are void
+   batch_facets.clear();
    interior_points_this_step -= candidate_points;
    interior_points += interior_points_this_step;
    interior_points += p;
@@ -981,12 +1205,70 @@ void beneath_beyond_algo<E>::process_new_lineality(const Int p, const std::list<
 template <typename E>
 void beneath_beyond_algo<E>::facet_info::coord_full_dim(const beneath_beyond_algo<E>& A)
 {
-   normal = rows(null_space(A.points->minor(vertices, All))).front();
+   normal = hyperplane_normal(*A.points, vertices);
    if (normal * A.points->row((A.vertices_so_far - vertices).front()) < 0)
       normal.negate();
    sqr_normal = sqr(normal);
 }
 
+// Gaussian elimination with complete pivoting on a dense copy of the coordinates,
+// the row operations run over contiguous memory
+template <typename E>
+Vector<double> beneath_beyond_algo<E>::hyperplane_normal(const Matrix<double>& pts, const Set<Int>& vertices)
+{
+   const Int n = vertices.size(), d = pts.cols();
+   const double* const pts_data = &*concat_rows(pts).begin();
+   std::vector<double> a(n * d);
+   auto a_row = a.begin();
+   for (const Int v : vertices) {
+      a_row = std::copy(pts_data + v * d, pts_data + (v+1) * d, a_row);
+   }
+   std::vector<Int> col(d);
+   std::iota(col.begin(), col.end(), 0);
+
+   Int rank = 0;
+   for (; rank < n && rank < d; ++rank) {
+      Int pivot_row = rank, pivot_col = rank;
+      double pivot_abs = 0;
+      for (Int i = rank; i < n; ++i)
+         for (Int j = rank; j < d; ++j)
+            if (std::abs(a[i * d + col[j]]) > pivot_abs) {
+               pivot_abs = std::abs(a[i * d + col[j]]);
+               pivot_row = i;  pivot_col = j;
+            }
+      if (is_zero(pivot_abs)) break;
+      if (pivot_row != rank)
+         std::swap_ranges(a.begin() + pivot_row * d, a.begin() + (pivot_row+1) * d, a.begin() + rank * d);
+      std::swap(col[pivot_col], col[rank]);
+
+      const Int c = col[rank];
+      const double* const pr = a.data() + rank * d;
+      for (Int i = rank+1; i < n; ++i) {
+         double* const r = a.data() + i * d;
+         const double factor = r[c] / pr[c];
+         if (factor != 0) {
+            for (Int j = 0; j < d; ++j)
+               r[j] -= factor * pr[j];
+         }
+         r[c] = 0;
+      }
+   }
+   if (rank == d)
+      return rows(null_space(pts.minor(vertices, All))).front();
+
+   // back substitution with the first free coordinate set to 1
+   std::vector<double> normal(d, 0.);
+   normal[col[rank]] = 1;
+   for (Int k = rank-1; k >= 0; --k) {
+      const double* const r = a.data() + k * d;
+      double x = 0;
+      for (Int j = k+1; j <= rank; ++j)
+         x += r[col[j]] * normal[col[j]];
+      normal[col[k]] = -x / r[col[k]];
+   }
+   return Vector<double>(d, normal.begin());
+}
+
 template <typename E>
 void beneath_beyond_algo<E>::facet_info::coord_low_dim(const beneath_beyond_algo<E>& A)
 {
@@ -19,7 +19,7 @@
 #define POLYMAKE_POLYTOPE_COCIRCUIT_DATACACHE_H
 
 #include "polymake/group/permlib.h"
-#include "polymake/hash_map"
+#include "polymake/flat_hash_map"
 #include "polymake/IncidenceMatrix.h"
 #include "polymake/Bitset.h"
 
@@ -61,10 +61,10 @@ public:
    typedef Scalar ScalarType;
 
    typedef std::pair<SetType, SetType > IndexType;
-   typedef hash_map<SetType, SetType> SetMapType;
-   typedef hash_map<IndexType, boost::shared_ptr<permlib::Permutation> > PermMapType;
-   typedef hash_map<SetType, boost::shared_ptr<permlib::PermutationGroup> > GroupMapType;
-   typedef hash_map<SetType, size_t> OrderMapType;
+   typedef flat_hash_map<SetType, SetType> SetMapType;
+   typedef flat_hash_map<IndexType, boost::shared_ptr<permlib::Permutation> > PermMapType;
+   typedef flat_hash_map<SetType, boost::shared_ptr<permlib::PermutationGroup> > GroupMapType;
+   typedef flat_hash_map<SetType, size_t> OrderMapType;
 
    DataCache(const Matrix<Scalar>& _V, const IncidenceMatrix<>& _VIF, const group::PermlibGroup& _group) 
          : V(_V)
@@ -54,6 +54,14 @@ bool align_matrix_column_dim(Matrix<E>& A, Matrix<E>& B, bool prepend_0_column)
    return true;
 }
 
+//! The part of dehomogenize_cone_solution concerning the affine hull or lineality space alone.
+template <typename Scalar>
+Matrix<Scalar> dehomogenize_cone_lineality(const Matrix<Scalar>& lineality){
+   auto L = lineality.minor(All, range_from(1));
+   Set<Int> ind = indices(attach_selector(rows(L), operations::non_zero()));
+   return L.minor(ind, All);
+}
+
 //! Dehomogenize the result of a convex hull computation. If isCone is true,
 //! the leading zero is eliminated, and the trivial equation/lineality is
 //! filtered out.
@@ -61,9 +69,7 @@ bool align_matrix_column_dim(Matrix<E>& A, Matrix<E>& B, bool prepend_0_column)
 //! @param bool isCone
 template <typename Scalar>
 convex_hull_result<Scalar> dehomogenize_cone_solution(const convex_hull_result<Scalar>& solution){
-   auto L = solution.second.minor(All, range_from(1));
-   Set<Int> ind = indices(attach_selector(rows(L), operations::non_zero()));
-   return convex_hull_result<Scalar>(solution.first.minor(All, range_from(1)), L.minor(ind, All));
+   return convex_hull_result<Scalar>(solution.first.minor(All, range_from(1)), dehomogenize_cone_lineality(solution.second));
 }
 
 //! Check whether the given points give a feasible polytope, i.e. check whether
@@ -82,6 +88,17 @@ void check_points_feasibility(const GenericMatrix<TMatrix, E>& points){
 }
 
 
+//! Receives the facets or vertices (cone: rays) of a convex hull computation one at a time,
+//! see ConvexHullSolver::for_each_facet.  The solver proceeds only after consume() has returned
+//! and stops the enumeration as soon as it returns false.
+template <typename Scalar>
+class ConvexHullConsumer {
+public:
+   virtual ~ConvexHullConsumer() {}
+
+   virtual bool consume(const Vector<Scalar>& row) = 0;
+};
+
 // not every solver offers direct support of redundant point/inequality elimination
 enum class CanEliminateRedundancies { no, yes };
 
@@ -93,6 +110,33 @@ public:
    virtual convex_hull_result<Scalar> enumerate_facets(const Matrix<Scalar>& points, const Matrix<Scalar>& linealities, bool isCone) const = 0;
 
    virtual convex_hull_result<Scalar> enumerate_vertices(const Matrix<Scalar>& inequalities, const Matrix<Scalar>& equations, bool isCone) const = 0;
+
+   // The same as enumerate_facets and enumerate_vertices, but the facets or vertices are passed to the consumer
+   // instead of being collected in a matrix; only the affine hull or the lineality space is returned.
+   // The default implementations still compute the complete matrix first, solvers override them to do without.
+
+   virtual Matrix<Scalar> for_each_facet(const Matrix<Scalar>& points, const Matrix<Scalar>& linealities, bool isCone,
+                                         ConvexHullConsumer<Scalar>& consumer) const
+   {
+      convex_hull_result<Scalar> sol = enumerate_facets(points, linealities, isCone);
+      pass_rows(sol.first, consumer);
+      return sol.second;
+   }
+
+   virtual Matrix<Scalar> for_each_vertex(const Matrix<Scalar>& inequalities, const Matrix<Scalar>& equations, bool isCone,
+                                          ConvexHullConsumer<Scalar>& consumer) const
+   {
+      convex_hull_result<Scalar> sol = enumerate_vertices(inequalities, equations, isCone);
+      pass_rows(sol.first, consumer);
+      return sol.second;
+   }
+
+protected:
+   static void pass_rows(const Matrix<Scalar>& M, ConvexHullConsumer<Scalar>& consumer)
+   {
+      for (auto r = entire(rows(M)); !r.at_end(); ++r)
+         if (!consumer.consume(*r)) break;
+   }
 };
 
 template <typename Scalar>
@@ -155,6 +199,84 @@ convex_hull_result<Scalar> enumerate_facets(const GenericMatrix<Matrix1, Scalar>
    return isCone ? dehomogenize_cone_solution(solver.enumerate_facets(Points, Lineality, true)) : solver.enumerate_facets(Points, Lineality, false);
 }
 
+// for cones, the consumer of the streaming solvers is wrapped in this one, as the solution is dehomogenized
+template <typename Scalar>
+class dehomogenizing_consumer : public ConvexHullConsumer<Scalar> {
+public:
+   explicit dehomogenizing_consumer(ConvexHullConsumer<Scalar>& target_arg)
+      : target(target_arg) {}
+
+   bool consume(const Vector<Scalar>& row) override
+   {
+      return target.consume(row.slice(range_from(1)));
+   }
+
+private:
+   ConvexHullConsumer<Scalar>& target;
+};
+
+template <typename Scalar>
+class counting_consumer : public ConvexHullConsumer<Scalar> {
+public:
+   bool consume(const Vector<Scalar>&) override
+   {
+      ++n;
+      return true;
+   }
+
+   Int n = 0;
+};
+
+// streaming variants of the convenience wrappers: vertices or facets are passed to the consumer,
+// the lineality space or affine hull is returned
+template <typename Scalar, typename Matrix1, typename Matrix2>
+Matrix<Scalar> for_each_vertex(const GenericMatrix<Matrix1, Scalar>& inequalities, const GenericMatrix<Matrix2, Scalar>& equations,
+                               bool isCone, ConvexHullConsumer<Scalar>& consumer)
+{
+   const auto& solver = get_convex_hull_solver<Scalar>();
+   Matrix<Scalar> H(inequalities), EQ(equations);
+   if (!align_matrix_column_dim(H, EQ, isCone))
+      throw std::runtime_error("convex_hull_dual - dimension mismatch between FACETS|INEQUALITIES and LINEAR_SPAN|EQUATIONS");
+   if (isCone) {
+      dehomogenizing_consumer<Scalar> cone_consumer(consumer);
+      return dehomogenize_cone_lineality(solver.for_each_vertex(H, EQ, true, cone_consumer));
+   }
+   return solver.for_each_vertex(H, EQ, false, consumer);
+}
+
+template <typename Scalar, typename Matrix1, typename Matrix2>
+Matrix<Scalar> for_each_facet(const GenericMatrix<Matrix1, Scalar>& points, const GenericMatrix<Matrix2, Scalar>& linealities,
+                              bool isCone, ConvexHullConsumer<Scalar>& consumer)
+{
+   const auto& solver = get_convex_hull_solver<Scalar>();
+   Matrix<Scalar> Points(points), Lineality(linealities);
+   if(!isCone) check_points_feasibility(Points);
+   if (!align_matrix_column_dim(Points, Lineality, isCone)) throw
+      std::runtime_error("convex_hull_primal - dimension mismatch between RAYS|INPUT_RAYS and LINEALITY_SPACE|INPUT_LINEALITY");
+   if (isCone) {
+      dehomogenizing_consumer<Scalar> cone_consumer(consumer);
+      return dehomogenize_cone_lineality(solver.for_each_facet(Points, Lineality, true, cone_consumer));
+   }
+   return solver.for_each_facet(Points, Lineality, false, consumer);
+}
+
+// numbers of facets and vertices without keeping them, in constant memory if the solver streams them
+template <typename Scalar, typename Matrix1, typename Matrix2>
+Int count_facets(const GenericMatrix<Matrix1, Scalar>& points, const GenericMatrix<Matrix2, Scalar>& linealities, bool isCone)
+{
+   counting_consumer<Scalar> counter;
+   for_each_facet(points, linealities, isCone, counter);
+   return counter.n;
+}
+
+template <typename Scalar, typename Matrix1, typename Matrix2>
+Int count_vertices(const GenericMatrix<Matrix1, Scalar>& inequalities, const GenericMatrix<Matrix2, Scalar>& equations, bool isCone)
+{
+   counting_consumer<Scalar> counter;
+   for_each_vertex(inequalities, equations, isCone, counter);
+   return counter.n;
+}
+
 // convenience wrappers for empty equations/lineality
 template <typename Scalar, typename Matrix1>
 convex_hull_result<Scalar> enumerate_vertices(const GenericMatrix<Matrix1, Scalar>& inequalities, bool isCone)
@@ -0,0 +1,167 @@
+/* Copyright (c) 1997-2020
+   Ewgenij Gawrilow, Michael Joswig, and the polymake team
+   Technische Universität Berlin, Germany
+   https://polymake.org
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version: http://www.gnu.org/licenses/gpl.txt.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+--------------------------------------------------------------------------------
+*/
+
+#ifndef POLYMAKE_POLYTOPE_INCREMENTAL_DELAUNAY_H
+#define POLYMAKE_POLYTOPE_INCREMENTAL_DELAUNAY_H
+
+#include "polymake/polytope/beneath_beyond_impl.h"
+#include "polymake/Map.h"
+#include <vector>
+
+namespace polymake { namespace polytope {
+
+/** Delaunay subdivision of a growing set of sites.
+    The sites are lifted to the paraboloid; their convex hull is kept by a beneath-beyond algorithm
+    which is continued with every inserted batch, thus only the facets in the conflict region are recomputed.
+    The cells of the subdivision are the lower facets of the lifted polytope; they are not triangulated
+    if the sites are not in general position.
+
+    The full list of cells and the Voronoi vertices are only assembled on request and kept until the next insertion.
+
+    @tmplparam E numerical type of the coordinates
+*/
+template <typename E>
+class incremental_delaunay {
+public:
+   /// cells of the subdivision which disappeared resp. appeared by an insertion, as sets of site indices
+   struct delta {
+      std::vector<Set<Int>> removed, added;
+   };
+
+   /// @param sites in homogeneous coordinates, must not lie on a common sphere or hyperplane
+   explicit incremental_delaunay(const Matrix<E>& sites)
+      : lifted(lift(sites))
+      , no_linealities(0, lifted.cols())
+      , cache_valid(false)
+   {
+      // duplicate sites end up as interior points;
+      // no parallel visibility evaluation, as it would visit all facets instead of the conflict region only
+      algo.expecting_redundant(true).making_triangulation(false);
+      algo.compute(lifted, no_linealities);
+      if (algo.getAffineHull().rows() != 0)
+         throw std::runtime_error("incremental_delaunay: sites lie on a common sphere or hyperplane");
+
+      const Graph<> facet_graph = algo.getDualGraph();
+      for (auto f = entire(nodes(facet_graph)); !f.at_end(); ++f)
+         if (is_lower(*f))
+            cells[*f] = algo.getFacetVertices(*f);
+   }
+
+   /// Add the sites in the rows of @a new_sites; they get the next free indices.
+   delta insert(const Matrix<E>& new_sites)
+   {
+      const Int n_old = lifted.rows();
+      lifted /= lift(new_sites);
+      algo.add_points(entire(sequence(n_old, new_sites.rows())));
+      cache_valid = false;
+
+      delta changes;
+      for (const Int f : algo.getChangedFacets()) {
+         auto c = cells.find(f);
+         if (!c.at_end()) {
+            changes.removed.push_back(c->second);
+            cells.erase(c);
+         }
+         if (algo.facetExists(f) && is_lower(f)) {
+            changes.added.push_back(algo.getFacetVertices(f));
+            cells[f] = changes.added.back();
+         }
+      }
+      return changes;
+   }
+
+   Int n_sites() const { return lifted.rows(); }
+
+   Int n_cells() const { return cells.size(); }
+
+   /// all cells of the subdivision
+   const Array<Set<Int>>& get_cells() const
+   {
+      update_cache();
+      return cell_list;
+   }
+
+   /// Voronoi vertices in homogeneous coordinates, the circumcenters of the cells in the same order
+   const Matrix<E>& get_voronoi_vertices() const
+   {
+      update_cache();
+      return voronoi_vertices;
+   }
+
+protected:
+   Matrix<E> lifted;
+   const Matrix<E> no_linealities;
+   beneath_beyond_algo<E> algo;
+   // lower facets of the lifted polytope, indexed by facet numbers of the algorithm
+   Map<Int, Set<Int>> cells;
+
+   mutable bool cache_valid;
+   mutable Array<Set<Int>> cell_list;
+   mutable Matrix<E> voronoi_vertices;
+
+   static Matrix<E> lift(const Matrix<E>& sites)
+   {
+      Vector<E> heights(sites.rows());
+      for (auto s = entire<indexed>(rows(sites)); !s.at_end(); ++s)
+         heights[s.index()] = sqr(s->slice(range_from(1)));
+      return sites | heights;
+   }
+
+   // The inner normals of lower facets point upwards.
+   // Floating-point normals are not normalized, therefore the height term of the scalar product with the vertices
+   // is compared to the largest term rather than to zero.
+   bool is_lower(Int f) const
+   {
+      const Vector<E>& normal = algo.getFacetNormal(f);
+      const Int d = normal.dim()-1;
+      E max_term = zero_value<E>(), height_term = zero_value<E>();
+      for (const Int v : algo.getFacetVertices(f)) {
+         for (Int i = 0; i <= d; ++i)
+            assign_max(max_term, abs(normal[i] * lifted(v, i)));
+         assign_max(height_term, normal[d] * lifted(v, d));
+      }
+      return height_term > 0 && !is_zero(height_term / max_term);
+   }
+
+   void update_cache() const
+   {
+      if (cache_valid) return;
+      const Int d = lifted.cols()-1;
+      cell_list.resize(cells.size());
+      voronoi_vertices.resize(cells.size(), d);
+      auto cell_it = cell_list.begin();
+      auto vertex_it = entire(rows(voronoi_vertices));
+      for (auto c = entire(cells); !c.at_end(); ++c, ++cell_it, ++vertex_it) {
+         *cell_it = c->second;
+         // the facet through the lifted cell is a0 + <a,x> + b |x|^2 = 0, the center of the circumsphere is -a / 2b
+         const Vector<E>& normal = algo.getFacetNormal(c->first);
+         *vertex_it = (2 * normal[d]) | -normal.slice(range(1, d-1));
+         *vertex_it /= 2 * normal[d];
+      }
+      cache_valid = true;
+   }
+};
+
+} }
+
+#endif // POLYMAKE_POLYTOPE_INCREMENTAL_DELAUNAY_H
+
+// Local Variables:
+// mode:C++
+// c-basic-offset:3
+// indent-tabs-mode:nil
+// End:
@@ -66,9 +66,13 @@ full_dim_projection(const GenericMatrix<TMatrix, Scalar>& verts)
    throw std::runtime_error("full_dim_projection: This shouldn't happen");
 }
       
+// The inequalities and equations of the secondary cone of a subdivision,
+// with additional equations and points to be lifted to height zero.
+// This variant does not access perl and may be called from parallel threads.
 template<typename Scalar, typename SetInt, typename Matrix>
 std::pair<const SparseMatrix<Scalar>, const SparseMatrix<Scalar>>
-secondary_cone_ineq(const GenericMatrix<Matrix, Scalar>& full_dim_verts, const Array<SetInt>& subdiv, OptionSet options)
+secondary_cone_ineq(const GenericMatrix<Matrix, Scalar>& full_dim_verts, const Array<SetInt>& subdiv,
+                    const SparseMatrix<Scalar>& eqs, const Set<Int>& tozero)
 {
 #if POLYMAKE_DEBUG
    if (rank(full_dim_verts) != full_dim_verts.cols())
@@ -89,15 +93,9 @@ secondary_cone_ineq(const GenericMatrix<Matrix, Scalar>& full_dim_verts, const A
    ListMatrix<SparseVector<Scalar>> equats(0,n_vertices);
    ListMatrix<SparseVector<Scalar>> inequs(0,n_vertices);
 
-   SparseMatrix<Scalar> eqs;
-   if (options["equations"] >> eqs)
+   if (eqs.rows())
       equats /= eqs;
 
-   Set<Int> tozero = options["lift_to_zero"];
-   Int face;
-   if (!equats.rows() && tozero.empty() && options["lift_face_to_zero"]>>face)
-      tozero += subdiv[face];
-
    for (const auto& j: tozero)
       equats /= unit_vector<Scalar>(n_vertices,j);
 
@@ -141,6 +139,21 @@ secondary_cone_ineq(const GenericMatrix<Matrix, Scalar>& full_dim_verts, const A
    return std::pair<const SparseMatrix<Scalar>,const SparseMatrix<Scalar>>(inequs, equats);
 }
 
+template<typename Scalar, typename SetInt, typename Matrix>
+std::pair<const SparseMatrix<Scalar>, const SparseMatrix<Scalar>>
+secondary_cone_ineq(const GenericMatrix<Matrix, Scalar>& full_dim_verts, const Array<SetInt>& subdiv, OptionSet options)
+{
+   SparseMatrix<Scalar> eqs;
+   options["equations"] >> eqs;
+
+   Set<Int> tozero = options["lift_to_zero"];
+   Int face;
+   if (!eqs.rows() && tozero.empty() && options["lift_face_to_zero"]>>face)
+      tozero += subdiv[face];
+
+   return secondary_cone_ineq(full_dim_verts, subdiv, eqs, tozero);
+}
+
 } }
 
 #endif // POLYMAKE_POLYTOPE_IS_REGULAR_H
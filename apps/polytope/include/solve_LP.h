@@ -22,6 +22,7 @@
 #include "polymake/Matrix.h"
 #include "polymake/Vector.h"
 #include "polymake/Set.h"
+#include <memory>
 
 namespace polymake { namespace polytope {
 
@@ -37,6 +38,24 @@ struct LP_Solution {
    Int lineality_dim = -1;
 };
 
+// A series of LPs sharing the constraint matrix.
+// Between the calls to solve(), the objective function, the constant terms of the constraints,
+// and the set of active inequalities may change.
+// Solvers supporting this start each LP from the optimal basis of the previous one.
+template <typename Scalar>
+class LP_Session {
+public:
+   virtual ~LP_Session() {}
+
+   virtual LP_Solution<Scalar> solve(const Vector<Scalar>& objective, bool maximize) = 0;
+
+   // constraints are numbered like the rows of (inequalities / equations)
+   virtual void set_constant_term(Int i, const Scalar& value) = 0;
+
+   // an inactive inequality is ignored until it is activated again
+   virtual void set_inequality_active(Int i, bool active) = 0;
+};
+
 template <typename Scalar>
 class LP_Solver {
 public:
@@ -46,11 +65,63 @@ public:
                                      const Vector<Scalar>& objective, bool maximize, bool feasibility_known=false) const = 0;
 
    virtual bool needs_feasibility_known() const { return false; }
+
+   // The default implementation solves every LP of the session from scratch.
+   virtual std::unique_ptr<LP_Session<Scalar>> start_session(const Matrix<Scalar>& inequalities, const Matrix<Scalar>& equations) const;
 };
 
+// Fallback session for solvers without warm start: keeps the constraints and passes them to the solver on every call.
+template <typename Scalar>
+class LP_resolving_session : public LP_Session<Scalar> {
+public:
+   LP_resolving_session(const LP_Solver<Scalar>& solver_arg, const Matrix<Scalar>& inequalities_arg, const Matrix<Scalar>& equations_arg)
+      : solver(solver_arg)
+      , inequalities(inequalities_arg)
+      , equations(equations_arg) {}
+
+   LP_Solution<Scalar> solve(const Vector<Scalar>& objective, bool maximize) override
+   {
+      if (inactive.empty())
+         return solver.solve(inequalities, equations, objective, maximize);
+      return solver.solve(Matrix<Scalar>(inequalities.minor(~inactive, All)), equations, objective, maximize);
+   }
+
+   void set_constant_term(Int i, const Scalar& value) override
+   {
+      if (i < inequalities.rows())
+         inequalities(i, 0) = value;
+      else
+         equations(i - inequalities.rows(), 0) = value;
+   }
+
+   void set_inequality_active(Int i, bool active) override
+   {
+      if (active)
+         inactive -= i;
+      else
+         inactive += i;
+   }
+
+private:
+   const LP_Solver<Scalar>& solver;
+   Matrix<Scalar> inequalities, equations;
+   Set<Int> inactive;
+};
+
+template <typename Scalar>
+std::unique_ptr<LP_Session<Scalar>>
+LP_Solver<Scalar>::start_session(const Matrix<Scalar>& inequalities, const Matrix<Scalar>& equations) const
+{
+   return std::unique_ptr<LP_Session<Scalar>>(new LP_resolving_session<Scalar>(*this, inequalities, equations));
+}
+
 template <typename Scalar>
 using cached_LP_solver = CachedObjectPointer<LP_Solver<Scalar>, Scalar>;
 
+// The solver is chosen according to the preference list for the label *.simplex.
+// For Rational coordinates TOSimplex is registered under the label to.simplex.rational, which main.rules
+// ranks first; it solves the LP in double precision and verifies the resulting basis with exact arithmetic,
+// see to_interface::Solver.
 template <typename Scalar>
 const LP_Solver<Scalar>& get_LP_solver()
 {
@@ -76,6 +147,14 @@ LP_Solution<Scalar> solve_LP(const GenericMatrix<Matrix1, Scalar>& inequalities,
    return solve_LP(inequalities, Matrix<Scalar>(), objective, maximize);
 }
 
+template <typename Scalar, typename Matrix1, typename Matrix2>
+std::unique_ptr<LP_Session<Scalar>> start_LP_session(const GenericMatrix<Matrix1, Scalar>& inequalities, const GenericMatrix<Matrix2, Scalar>& equations)
+{
+   const LP_Solver<Scalar>& solver = get_LP_solver<Scalar>();
+   return solver.start_session(convert_to_persistent_dense(inequalities.top()),
+                               convert_to_persistent_dense(equations.top()));
+}
+
 template <typename Scalar, typename Matrix1, typename Matrix2>
 bool H_input_feasible(const GenericMatrix<Matrix1, Scalar>& inequalities, const GenericMatrix<Matrix2, Scalar>& equations)
 {
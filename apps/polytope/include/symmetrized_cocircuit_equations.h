@@ -22,7 +22,7 @@
 #include "polymake/ListMatrix.h"
 #include "polymake/linalg.h"
 #include "polymake/Set.h"
-#include "polymake/hash_set"
+#include "polymake/flat_hash_set"
 #include "polymake/group/action.h"
 #include "polymake/polytope/cocircuit_equations.h"
 
@@ -114,7 +114,7 @@ combinatorial_symmetrized_cocircuit_equations_impl(const Matrix<Scalar>& points,
          where  tau = ridge_rep  and  i = *iit, so that  chi_i(j) = character_table(*iit, j)
       */
 
-      hash_set<SetType> ridge_orbit;
+      flat_hash_set<SetType> ridge_orbit;
       for (const auto& cc: conjugacy_classes) {
          for (const auto& h: cc) {
             const group::ActionType<SetType> h_action(h);
@@ -36,9 +36,12 @@ namespace polymake { namespace polytope { namespace to_interface {
 template <typename Coord>
 class Solver : public LP_Solver<Coord> {
 public:
-   Solver()
+   /// @param float_start_ for Rational coordinates: solve the LP in double precision first
+   ///        and let the exact solver start from the basis found there
+   explicit Solver(bool float_start_ = true)
+      : float_start(float_start_)
 #if POLYMAKE_DEBUG
-      : debug_print(get_debug_level() > 1)
+      , debug_print(get_debug_level() > 1)
 #endif
    {}
 
@@ -54,8 +57,13 @@ public:
       return Solver::solve(Inequalities, Equations, Objective, maximize, Set<Int>());
    }
 
-#if POLYMAKE_DEBUG
+   // the LPs of the session are solved by one instance of TOSolver, which starts from the last optimal basis
+   std::unique_ptr<LP_Session<Coord>>
+   start_session(const Matrix<Coord>& Inequalities, const Matrix<Coord>& Equations) const override;
+
 private:
+   const bool float_start;
+#if POLYMAKE_DEBUG
    const bool debug_print;
 #endif
 };
@@ -139,6 +147,247 @@ void to_dual_fill_data(const Matrix<Coord>& A1, const Matrix<Coord>& A2, const s
    }
 }
 
+template <typename Coord>
+std::vector<TOSimplex::TORationalInf<double>>
+to_float_bounds(const std::vector<TOSimplex::TORationalInf<Coord>>& bounds, bool& all_finite)
+{
+   std::vector<TOSimplex::TORationalInf<double>> float_bounds;
+   float_bounds.reserve(bounds.size());
+   for (const auto& b : bounds) {
+      if (b.isInf) {
+         float_bounds.push_back(true);
+      } else {
+         float_bounds.push_back(double(b.value));
+         all_finite = all_finite && std::isfinite(float_bounds.back().value);
+      }
+   }
+   return float_bounds;
+}
+
+template <typename Coord>
+std::vector<double> to_float_values(const std::vector<Coord>& values, bool& all_finite)
+{
+   std::vector<double> float_values;
+   float_values.reserve(values.size());
+   for (const Coord& x : values) {
+      float_values.push_back(double(x));
+      all_finite = all_finite && std::isfinite(float_values.back());
+   }
+   return float_values;
+}
+
+// double precision copy of the dual LP, or nullptr if some coefficients exceed the range of double
+inline
+std::unique_ptr<TOSimplex::TOSolver<double, Int>>
+to_float_solver(const std::vector<Rational>& to_coefficients, const std::vector<Int>& to_colinds, const std::vector<Int>& to_rowbegininds,
+                const std::vector<Rational>& to_objective,
+                const std::vector<TOSimplex::TORationalInf<Rational>>& to_rowlowerbounds, const std::vector<TOSimplex::TORationalInf<Rational>>& to_rowupperbounds,
+                const std::vector<TOSimplex::TORationalInf<Rational>>& to_varlowerbounds, const std::vector<TOSimplex::TORationalInf<Rational>>& to_varupperbounds)
+{
+   bool all_finite = true;
+   const std::vector<double> float_coefficients = to_float_values(to_coefficients, all_finite);
+   const std::vector<double> float_objective = to_float_values(to_objective, all_finite);
+   const auto float_rowlowerbounds = to_float_bounds(to_rowlowerbounds, all_finite);
+   const auto float_rowupperbounds = to_float_bounds(to_rowupperbounds, all_finite);
+   const auto float_varlowerbounds = to_float_bounds(to_varlowerbounds, all_finite);
+   const auto float_varupperbounds = to_float_bounds(to_varupperbounds, all_finite);
+   if (!all_finite) return nullptr;
+
+   std::unique_ptr<TOSimplex::TOSolver<double, Int>> float_solver(
+      new TOSimplex::TOSolver<double, Int>(float_coefficients, to_colinds, to_rowbegininds, float_objective,
+                                           float_rowlowerbounds, float_rowupperbounds, float_varlowerbounds, float_varupperbounds));
+   const Int m = to_rowlowerbounds.size(), n = to_varlowerbounds.size();
+   float_solver->setTolerance(1e-9);
+   float_solver->setIterationLimit(std::max(Int(1000), 10*(m+n)));
+   return float_solver;
+}
+
+// Run the floating-point solver and pass its final basis to the exact solver, which is also kept in var_stati and con_stati.
+// Returns false if no basis was found.
+inline
+bool to_pass_float_basis(TOSimplex::TOSolver<double, Int>& float_solver, TOSimplex::TOSolver<Rational, Int>& exact_solver,
+                         std::vector<Int>& var_stati, std::vector<Int>& con_stati)
+{
+   try {
+      // 0: optimal, 1: infeasible, 2: unbounded; in all these cases the final basis is a good guess for the exact solver,
+      // 4 means that the iteration limit was reached
+      const Int float_result = float_solver.opt();
+      if (float_result >= 0 && float_result <= 2) {
+         float_solver.getBase(var_stati, con_stati);
+         exact_solver.setBase(var_stati, con_stati);
+         return true;
+      }
+   }
+   catch (const std::exception&) { }
+   return false;
+}
+
+/* Solve the LP in double precision and pass the final basis to the exact solver.
+ * The exact solver refactors this basis and continues pivoting from there, so a basis which is
+ * not optimal or even singular in exact arithmetic only costs some additional rational pivots,
+ * but never affects the correctness of the result.
+ * The floating-point run is bounded by an iteration limit, as it may cycle due to rounding errors.
+ */
+inline
+void to_float_start_basis(TOSimplex::TOSolver<Rational, Int>& exact_solver,
+                          const std::vector<Rational>& to_coefficients, const std::vector<Int>& to_colinds, const std::vector<Int>& to_rowbegininds,
+                          const std::vector<Rational>& to_objective,
+                          const std::vector<TOSimplex::TORationalInf<Rational>>& to_rowlowerbounds, const std::vector<TOSimplex::TORationalInf<Rational>>& to_rowupperbounds,
+                          const std::vector<TOSimplex::TORationalInf<Rational>>& to_varlowerbounds, const std::vector<TOSimplex::TORationalInf<Rational>>& to_varupperbounds)
+{
+   try {
+      const auto float_solver = to_float_solver(to_coefficients, to_colinds, to_rowbegininds, to_objective,
+                                                to_rowlowerbounds, to_rowupperbounds, to_varlowerbounds, to_varupperbounds);
+      std::vector<Int> var_stati, con_stati;
+      if (float_solver)
+         to_pass_float_basis(*float_solver, exact_solver, var_stati, con_stati);
+   }
+   catch (const std::exception&) {
+      // the exact solver starts from scratch
+   }
+}
+
+// other coordinate types are solved exactly from the beginning
+template <typename Coord, typename... TData>
+void to_float_start_basis(TOSimplex::TOSolver<Coord, Int>&, const TData&...) {}
+
+// the dual LP in the input format of TOSolver, see Solver::solve
+template <typename Coord>
+struct to_dual_data {
+   std::vector<Coord> coefficients;
+   std::vector<Int> colinds, rowbegininds;
+   std::vector<TOSimplex::TORationalInf<Coord>> rowlowerbounds, rowupperbounds, varlowerbounds, varupperbounds;
+   std::vector<Coord> objective;
+
+   to_dual_data(const Matrix<Coord>& Inequalities, const Matrix<Coord>& Equations, const std::vector<Coord>& MinObjective)
+   {
+      to_dual_fill_data(Inequalities, Equations, MinObjective, coefficients, colinds, rowbegininds,
+                        rowlowerbounds, rowupperbounds, varlowerbounds, varupperbounds, objective);
+   }
+
+   std::unique_ptr<TOSimplex::TOSolver<Coord, Int>> make_solver(bool float_start) const
+   {
+      std::unique_ptr<TOSimplex::TOSolver<Coord, Int>> solver(
+         new TOSimplex::TOSolver<Coord, Int>(coefficients, colinds, rowbegininds, objective, rowlowerbounds, rowupperbounds, varlowerbounds, varupperbounds));
+      if (float_start)
+         to_float_start_basis(*solver, coefficients, colinds, rowbegininds, objective, rowlowerbounds, rowupperbounds, varlowerbounds, varupperbounds);
+      return solver;
+   }
+};
+
+/* The floating-point counterpart of a Session: for Rational coordinates, each LP is solved in double precision first,
+ * starting from the previous floating-point basis, and the result is passed to the exact solver as its start basis.
+ * Once the floating-point solver fails, the session proceeds with the exact solver alone.
+ * Other coordinate types are solved exactly.
+ */
+template <typename Coord>
+class to_float_session {
+public:
+   explicit to_float_session(const to_dual_data<Coord>&) {}
+
+   bool pass_basis(TOSimplex::TOSolver<Coord, Int>&) { return false; }
+   void set_objective(const std::vector<Coord>&) {}
+   void set_constant_term(Int, const Coord&) {}
+   void set_inequality_active(Int, bool) {}
+};
+
+template <>
+class to_float_session<Rational> {
+public:
+   explicit to_float_session(const to_dual_data<Rational>& data)
+   {
+      try {
+         solver = to_float_solver(data.coefficients, data.colinds, data.rowbegininds, data.objective,
+                                  data.rowlowerbounds, data.rowupperbounds, data.varlowerbounds, data.varupperbounds);
+      }
+      catch (const std::exception&) { }
+   }
+
+   bool pass_basis(TOSimplex::TOSolver<Rational, Int>& exact_solver)
+   {
+      if (solver) {
+         if (!var_stati.empty())
+            solver->setBase(var_stati, con_stati);
+         if (to_pass_float_basis(*solver, exact_solver, var_stati, con_stati))
+            return true;
+         solver.reset();
+      }
+      return false;
+   }
+
+   void set_objective(const std::vector<Rational>& to_obj)
+   {
+      for (Int j = 0; solver && j < Int(to_obj.size()); ++j) {
+         const double x = double(to_obj[j]);
+         if (std::isfinite(x))
+            solver->setConstraintBothHandSides(j, x, x);
+         else
+            solver.reset();
+      }
+   }
+
+   void set_constant_term(Int i, const Rational& value)
+   {
+      const double x = double(value);
+      if (!std::isfinite(x))
+         solver.reset();
+      else if (solver)
+         solver->setObj(i, x);
+   }
+
+   void set_inequality_active(Int i, bool active)
+   {
+      if (solver)
+         solver->setVarUB(i, active ? TOSimplex::TORationalInf<double>(true) : TOSimplex::TORationalInf<double>(0.0));
+   }
+
+private:
+   std::unique_ptr<TOSimplex::TOSolver<double, Int>> solver;
+   std::vector<Int> var_stati, con_stati;
+};
+
+// translate objective function into dense description, take direction into account
+template <typename Coord>
+std::vector<Coord> to_min_objective(const Vector<Coord>& Objective, Int n, bool maximize)
+{
+   std::vector<Coord> to_obj(n);
+   if (maximize) {
+      for (Int j = 1; j <= n; ++j)
+         to_obj[j-1] = -Objective[j];
+   } else {
+      for (Int j = 1; j <= n; ++j)
+         to_obj[j-1] = Objective[j];
+   }
+   return to_obj;
+}
+
+template <typename Coord>
+LP_Solution<Coord> to_run_solver(TOSimplex::TOSolver<Coord, Int>& solver, Int n, bool maximize)
+{
+   LP_Solution<Coord> result;
+   switch (solver.opt()) {
+   case 0: {
+      // solved to optimality
+      result.status = LP_status::valid;
+      result.objective_value = solver.getObj();
+      if (!maximize) negate(result.objective_value);
+      const std::vector<Coord>& tox(solver.getY());
+      result.solution.resize(1+n);
+      result.solution[0] = one_value<Coord>();
+      for (Int j = 1; j <= n; ++j)
+         result.solution[j] = -tox[j-1]; // It seems that the duals have an unexpected sign, so let's negate them
+      break;
+   }
+   case 1:
+      result.status = LP_status::unbounded;
+      break;
+   default:
+      result.status = LP_status::infeasible;
+      break;
+   }
+   return result;
+}
+
 } // end anonymous namespace
 
 
@@ -172,36 +421,18 @@ Solver<Coord>::solve(const Matrix<Coord>& Inequalities, const Matrix<Coord>& Equ
    }
 #endif
 
-   // translate inequality constraints into sparse description
-   std::vector<Coord> to_coefficients;
-   std::vector<Int> to_colinds, to_rowbegininds;
-   std::vector<TOSimplex::TORationalInf<Coord>> to_rowlowerbounds, to_rowupperbounds, to_varlowerbounds, to_varupperbounds;
-   std::vector<Coord> to_objective;
+   // translate the constraints into a sparse description of the dual problem
+   const to_dual_data<Coord> data(Inequalities, Equations, to_min_objective(Objective, n, maximize));
 
-   // translate objective function into dense description, take direction into account
-   std::vector<Coord> to_obj(n);
-   if (maximize) {
-      for (Int j = 1; j <= n; ++j)
-         to_obj[j-1] = -Objective[j];
-   } else {
-      for (Int j = 1; j <= n; ++j)
-         to_obj[j-1] = Objective[j];
-   }
-
-   // Fill the vectors with the dual problem
-   to_dual_fill_data(Inequalities, Equations, to_obj, to_coefficients, to_colinds, to_rowbegininds, to_rowlowerbounds, to_rowupperbounds, to_varlowerbounds, to_varupperbounds, to_objective );
-   
 #if POLYMAKE_DEBUG
    if (debug_print)
-      cout << "to_coefficients:" << to_coefficients <<"\n"
-              "to_colinds:" << to_colinds << "\n"
-              "to_rowbegininds:" << to_rowbegininds << "\n"
-              "to_obj:" << to_obj << "\n"
-              "to_objective:" << to_objective << endl;
+      cout << "to_coefficients:" << data.coefficients <<"\n"
+              "to_colinds:" << data.colinds << "\n"
+              "to_rowbegininds:" << data.rowbegininds << "\n"
+              "to_objective:" << data.objective << endl;
 #endif
 
-   to_solver solver(to_coefficients, to_colinds, to_rowbegininds, to_objective, to_rowlowerbounds, to_rowupperbounds, to_varlowerbounds, to_varupperbounds);
-
+   std::unique_ptr<to_solver> solver = data.make_solver(float_start && initial_basis.empty());
 
    // add start basis:
    if (!initial_basis.empty()) {
@@ -220,32 +451,94 @@ Solver<Coord>::solve(const Matrix<Coord>& Inequalities, const Matrix<Coord>& Equ
          b1[i] = 1;
          if (--count <= 0) break;
       }
-      solver.setBase(b1, b2);
+      solver->setBase(b1, b2);
    }
 
-   LP_Solution<Coord> result;
-   switch (solver.opt()) {
-   case 0: {
-      // solved to optimality
-      result.status = LP_status::valid;
-      result.objective_value = solver.getObj();
-      if (!maximize) negate(result.objective_value);
-      const std::vector<Coord>& tox(solver.getY());
-      result.solution.resize(1+n);
-      result.solution[0] = one_value<Coord>();
-      for (Int j = 1; j <= n; ++j)
-         result.solution[j] = -tox[j-1]; // It seems that the duals have an unexpected sign, so let's negate them
-      break;
+   return to_run_solver(*solver, n, maximize);
+}
+
+/* The session keeps the TOSolver instance of the dual LP, see Solver::solve:
+ * the primal objective function makes up the bounds of the dual constraints,
+ * the constant terms of the primal constraints the dual objective function,
+ * and an inactive inequality corresponds to a dual variable fixed at zero.
+ * Each LP starts from the final basis of the previous one, or, for Rational coordinates,
+ * from the basis found by the floating-point solver kept alongside.
+ * The solvers are set up on the first call of solve().
+ */
+template <typename Coord>
+class Session : public LP_Session<Coord> {
+public:
+   Session(const Matrix<Coord>& Inequalities, const Matrix<Coord>& Equations, bool float_start_)
+      : n(Inequalities.cols()-1)
+      , n_ineqs(Inequalities.rows())
+      , data(new to_dual_data<Coord>(Inequalities, Equations, std::vector<Coord>(Inequalities.cols()-1)))
+      , float_start(float_start_) {}
+
+   LP_Solution<Coord> solve(const Vector<Coord>& Objective, bool maximize) override
+   {
+      const std::vector<Coord> to_obj = to_min_objective(Objective, n, maximize);
+      if (data) {
+         for (Int j = 0; j < n; ++j)
+            data->rowlowerbounds[j] = data->rowupperbounds[j] = to_obj[j];
+         solver = data->make_solver(false);
+         if (float_start)
+            float_session.reset(new to_float_session<Coord>(*data));
+         data.reset();
+      } else {
+         for (Int j = 0; j < n; ++j)
+            solver->setConstraintBothHandSides(j, to_obj[j], to_obj[j]);
+         if (float_session)
+            float_session->set_objective(to_obj);
+         // moves the non-basic variables to their new bounds
+         solver->setBase(var_stati, con_stati);
+      }
+      if (float_session && !float_session->pass_basis(*solver))
+         float_session.reset();
+      LP_Solution<Coord> result = to_run_solver(*solver, n, maximize);
+      solver->getBase(var_stati, con_stati);
+      return result;
    }
-   case 1:
-      result.status = LP_status::unbounded;
-      break;
-   default:
-      result.status = LP_status::infeasible;
-      break;
+
+   void set_constant_term(Int i, const Coord& value) override
+   {
+      if (data) {
+         data->objective[i] = value;
+      } else {
+         solver->setObj(i, value);
+         if (float_session)
+            float_session->set_constant_term(i, value);
+      }
    }
 
-   return result;
+   void set_inequality_active(Int i, bool active) override
+   {
+      if (i >= n_ineqs)
+         throw std::runtime_error("LP_Session - equations can't be deactivated");
+      const TOSimplex::TORationalInf<Coord> upper = active ? TOSimplex::TORationalInf<Coord>(true) : TOSimplex::TORationalInf<Coord>(Coord(0));
+      if (data) {
+         data->varupperbounds[i] = upper;
+      } else {
+         solver->setVarUB(i, upper);
+         if (float_session)
+            float_session->set_inequality_active(i, active);
+      }
+   }
+
+private:
+   const Int n, n_ineqs;
+   std::unique_ptr<to_dual_data<Coord>> data;
+   std::unique_ptr<TOSimplex::TOSolver<Coord, Int>> solver;
+   std::unique_ptr<to_float_session<Coord>> float_session;
+   // the final basis of the last LP, recorded before the bounds change
+   std::vector<Int> var_stati, con_stati;
+   const bool float_start;
+};
+
+template <typename Coord>
+std::unique_ptr<LP_Session<Coord>>
+Solver<Coord>::start_session(const Matrix<Coord>& Inequalities, const Matrix<Coord>& Equations) const
+{
+   return std::unique_ptr<LP_Session<Coord>>(new Session<Coord>(Inequalities, Equations, float_start));
 }
 
 } } }
@@ -17,6 +17,7 @@
 
 #include "polymake/client.h"
 #include "polymake/Rational.h"
+#include "polymake/parallel.h"
 #include "polymake/polytope/beneath_beyond.h"
 #include "polymake/polytope/beneath_beyond_impl.h"
 
@@ -48,6 +49,34 @@ BeneathBeyondConvexHullSolver<Scalar>::enumerate_vertices(const Matrix<Scalar>&
    return result;
 }
 
+template <typename Scalar>
+Matrix<Scalar>
+BeneathBeyondConvexHullSolver<Scalar>::for_each_facet(const Matrix<Scalar>& Points, const Matrix<Scalar>& Linealities, const bool isCone,
+                                                      ConvexHullConsumer<Scalar>& consumer) const
+{
+   beneath_beyond_algo<Scalar> algo;
+   algo.expecting_redundant(true).for_cone(isCone).making_triangulation(false);
+   algo.compute(Points, Linealities);
+   algo.visitFacets([&consumer](const Vector<Scalar>& f) { return consumer.consume(f); });
+   return algo.getAffineHull();
+}
+
+template <typename Scalar>
+Matrix<Scalar>
+BeneathBeyondConvexHullSolver<Scalar>::for_each_vertex(const Matrix<Scalar>& Inequalities, const Matrix<Scalar>& Equations, const bool isCone,
+                                                       ConvexHullConsumer<Scalar>& consumer) const
+{
+   beneath_beyond_algo<Scalar> algo;
+   algo.expecting_redundant(true).for_cone(isCone).making_triangulation(false).computing_vertices(true);
+   algo.compute(Inequalities, Equations);
+   Matrix<Scalar> lineality = algo.getAffineHull();
+   bool empty = true;
+   algo.visitFacets([&consumer, &empty](const Vector<Scalar>& v) { empty = false; return consumer.consume(v); });
+   if (!isCone && empty && lineality.rows() == 0 && (Inequalities.rows() != 0 || Equations.rows() != 0))
+      throw infeasible();
+   return lineality;
+}
+
 template <typename Scalar>
 std::pair<Bitset, Set<Int>>
 BeneathBeyondConvexHullSolver<Scalar>::get_non_redundant_points(const Matrix<Scalar>& Points, const Matrix<Scalar>& Linealities, bool isCone) const
@@ -96,11 +125,12 @@ template <typename Scalar>
 void beneath_beyond_find_facets(BigObject p, const bool isCone, OptionSet options)
 {
    const bool non_redundant = options["non_redundant"];
+   const parallel::ThreadLimit threads(options["threads"]);
    const Matrix<Scalar> Points = p.give(non_redundant ? Str("RAYS") : Str("INPUT_RAYS"));
    const Matrix<Scalar> Lins = p.lookup(non_redundant ? Str("LINEALITY_SPACE") : Str("INPUT_LINEALITY"));
 
    beneath_beyond_algo<Scalar> algo;
-   algo.expecting_redundant(!non_redundant).for_cone(isCone);
+   algo.expecting_redundant(!non_redundant).for_cone(isCone).parallel_visibility(options["batch_size"]);
    algo.compute(Points, Lins);
 
    p.take("FACETS") << algo.getFacets();
@@ -124,11 +154,13 @@ template <typename Scalar>
 void beneath_beyond_find_vertices(BigObject p, const bool isCone, OptionSet options)
 {
    const bool non_redundant = options["non_redundant"];
+   const parallel::ThreadLimit threads(options["threads"]);
    const Matrix<Scalar> Points = p.give(non_redundant ? Str("FACETS") : Str("INEQUALITIES"));
    const Matrix<Scalar> Lins = p.lookup(non_redundant ? Str("LINEAR_SPAN") : Str("EQUATIONS"));
 
    beneath_beyond_algo<Scalar> algo;
-   algo.expecting_redundant(!non_redundant).making_triangulation(false).for_cone(isCone).computing_vertices(true);
+   algo.expecting_redundant(!non_redundant).making_triangulation(false).for_cone(isCone).computing_vertices(true)
+       .parallel_visibility(options["batch_size"]);
    algo.compute(Points, Lins);
 
    p.take("RAYS") << algo.getFacets();
@@ -147,8 +179,9 @@ Array<Set<Int>>
 placing_triangulation(const Matrix<Scalar>& Points, OptionSet options)
 {
    const bool non_redundant = options["non_redundant"];
+   const parallel::ThreadLimit threads(options["threads"]);
    beneath_beyond_algo<Scalar> algo;
-   algo.expecting_redundant(!non_redundant).for_cone(true).making_triangulation(true);
+   algo.expecting_redundant(!non_redundant).for_cone(true).making_triangulation(true).parallel_visibility(options["batch_size"]);
    Array<Int> permutation;
    if (options["permutation"] >> permutation) {
       if (permutation.size() != Points.rows())
@@ -168,19 +201,24 @@ placing_triangulation(const SparseMatrix<Scalar>& Points, OptionSet options)
    return placing_triangulation(full_points, options);
 }
 
-FunctionTemplate4perl("beneath_beyond_find_facets<Scalar> (Cone<Scalar>; $=true, { non_redundant => false })");
+FunctionTemplate4perl("beneath_beyond_find_facets<Scalar> (Cone<Scalar>; $=true, { non_redundant => false, batch_size => 0, threads => undef })");
 
-FunctionTemplate4perl("beneath_beyond_find_facets<Scalar> (Polytope<Scalar>; $=false, { non_redundant => false })");
+FunctionTemplate4perl("beneath_beyond_find_facets<Scalar> (Polytope<Scalar>; $=false, { non_redundant => false, batch_size => 0, threads => undef })");
 
-FunctionTemplate4perl("beneath_beyond_find_vertices<Scalar> (Cone<Scalar>; $=true, { non_redundant => false })");
+FunctionTemplate4perl("beneath_beyond_find_vertices<Scalar> (Cone<Scalar>; $=true, { non_redundant => false, batch_size => 0, threads => undef })");
 
-FunctionTemplate4perl("beneath_beyond_find_vertices<Scalar> (Polytope<Scalar>; $=false, { non_redundant => false })");
+FunctionTemplate4perl("beneath_beyond_find_vertices<Scalar> (Polytope<Scalar>; $=false, { non_redundant => false, batch_size => 0, threads => undef })");
 
 UserFunctionTemplate4perl("# @category Triangulations, subdivisions and volume"
                           "# Compute the placing triangulation of the given point set using the beneath-beyond algorithm."
                           "# @param Matrix Points the given point set"
                           "# @option Bool non_redundant whether it's already known that //Points// are non-redundant"
                           "# @option Array<Int> permutation placing order of //Points//, must be a valid permutation of (0..Points.rows()-1)"
+                          "# @option Int batch_size number of points to be checked against all facets in parallel;"
+                          "#  default 0 means sequential processing.  The result does not depend on this option."
+                          "#  A batch costs more scalar products than the sequential processing, it is only formed with more than one thread."
+                          "# @option Int threads number of threads checking the points in parallel;"
+                          "#  default is the custom variable $common::max_threads"
                           "# @return Array<Set<Int>>"
                           "# @example To compute the placing triangulation of the square (of whose vertices we know that"
                           "# they're non-redundant), do this:"
@@ -188,7 +226,7 @@ UserFunctionTemplate4perl("# @category Triangulations, subdivisions and volume"
                           "# > print $t;"
                           "# | {0 1 2}"
                           "# | {1 2 3}",
-                          "placing_triangulation(Matrix; { non_redundant => false, permutation => undef })");
+                          "placing_triangulation(Matrix; { non_redundant => false, permutation => undef, batch_size => 0, threads => undef })");
 
 InsertEmbeddedRule("function beneath_beyond.convex_hull: create_convex_hull_solver<Scalar> [is_ordered_field_with_unlimited_precision(Scalar)] (;$=0)"
                    " : c++ (name => 'create_beneath_beyond_solver') : returns(cached);\n");
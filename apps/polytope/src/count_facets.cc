@@ -0,0 +1,76 @@
+/* Copyright (c) 1997-2020
+   Ewgenij Gawrilow, Michael Joswig, and the polymake team
+   Technische Universität Berlin, Germany
+   https://polymake.org
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version: http://www.gnu.org/licenses/gpl.txt.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+--------------------------------------------------------------------------------
+*/
+
+#include "polymake/client.h"
+#include "polymake/Rational.h"
+#include "polymake/polytope/convex_hull.h"
+
+namespace polymake { namespace polytope {
+
+template <typename Scalar>
+Int count_facets(BigObject p)
+{
+   const Matrix<Scalar> Points = p.give("RAYS | INPUT_RAYS"),
+                     Lineality = p.lookup("LINEALITY_SPACE | INPUT_LINEALITY");
+   return count_facets(Points, Lineality, !p.isa("Polytope"));
+}
+
+template <typename Scalar>
+Int count_vertices(BigObject p)
+{
+   const Matrix<Scalar> H = p.give("FACETS | INEQUALITIES"),
+                       EQ = p.lookup("LINEAR_SPAN | EQUATIONS");
+   const bool isCone = !p.isa("Polytope");
+   // an empty exterior description of a polytope can only describe the empty set, cf. generic_convex_hull_dual
+   if (!isCone && H.rows() == 0 && EQ.rows() == 0)
+      return 0;
+   try {
+      return count_vertices(H, EQ, isCone);
+   }
+   catch (const infeasible&) {
+      return 0;
+   }
+}
+
+UserFunctionTemplate4perl("# @category Geometry"
+                          "# Count the facets of a polyhedron or cone without storing them."
+                          "# The facets are passed one by one from the preferred convex hull solver;"
+                          "# those computing by reverse search, like lrs, need no memory for the whole result."
+                          "# @param Cone P"
+                          "# @return Int the number of rows FACETS would have"
+                          "# @example"
+                          "# > print count_facets(cube(4));"
+                          "# | 8",
+                          "count_facets<Scalar>(Cone<Scalar>)");
+
+UserFunctionTemplate4perl("# @category Geometry"
+                          "# Count the vertices and rays of a polyhedron, or the rays of a cone, without storing them."
+                          "# The solutions are passed one by one from the preferred convex hull solver;"
+                          "# those computing by reverse search, like lrs, need no memory for the whole result."
+                          "# @param Cone P"
+                          "# @return Int the number of rows VERTICES or RAYS would have"
+                          "# @example"
+                          "# > print count_vertices(cross(4));"
+                          "# | 8",
+                          "count_vertices<Scalar>(Cone<Scalar>)");
+} }
+
+// Local Variables:
+// mode:C++
+// c-basic-offset:3
+// indent-tabs-mode:nil
+// End:
@@ -19,25 +19,21 @@
 #include "polymake/Graph.h"
 #include "polymake/Set.h"
 #include "polymake/IncidenceMatrix.h"
+#include "polymake/DenseIncidenceMatrix.h"
 
 namespace polymake { namespace polytope {
 
-template <typename IMatrix>
-Graph<> graph_from_incidence(const GenericIncidenceMatrix<IMatrix>& IM)
+// Two vertices are adjacent iff the set of facets containing both is maximal among all such sets.
+// The columns can be Sets or Bitsets, the latter for dense incidence matrices.
+template <typename TSet, typename Columns>
+void add_edges_from_columns(Graph<>& G, const Columns& C)
 {
-   const Int n_vertices = IM.cols();
-   Graph<> G(n_vertices);
-   if (n_vertices < 3) {
-      if (n_vertices == 2) G.edge(0, 1);
-      return G;
-   }
-
-   EdgeMap<Undirected, Set<Int>> intersects(G);
+   EdgeMap<Undirected, TSet> intersects(G);
 
    for (auto n1 = entire(nodes(G)); !n1.at_end(); ++n1) {
       auto n2 = n1;
       while (!(++n2).at_end()) {
-         Set<Int> common = IM.col(*n1) * IM.col(*n2);
+         TSet common = C[*n1] * C[*n2];
          if (common.empty()) continue;
 
          Graph<>::out_edge_list::iterator edge=n1.out_edges().begin();
@@ -54,6 +50,22 @@ Graph<> graph_from_incidence(const GenericIncidenceMatrix<IMatrix>& IM)
          if (add) intersects[n1.edge(*n2)]=common;
       }
    }
+}
+
+template <typename IMatrix>
+Graph<> graph_from_incidence(const GenericIncidenceMatrix<IMatrix>& IM)
+{
+   const Int n_vertices = IM.cols();
+   Graph<> G(n_vertices);
+   if (n_vertices < 3) {
+      if (n_vertices == 2) G.edge(0, 1);
+      return G;
+   }
+
+   if (DenseIncidenceMatrix::is_dense(IM))
+      add_edges_from_columns<Bitset>(G, DenseIncidenceMatrix(IM).get_cols());
+   else
+      add_edges_from_columns<Set<Int>>(G, cols(IM));
 
    return G;
 }
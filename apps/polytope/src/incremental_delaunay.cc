@@ -0,0 +1,59 @@
+/* Copyright (c) 1997-2020
+   Ewgenij Gawrilow, Michael Joswig, and the polymake team
+   Technische Universität Berlin, Germany
+   https://polymake.org
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version: http://www.gnu.org/licenses/gpl.txt.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+--------------------------------------------------------------------------------
+*/
+
+#include "polymake/client.h"
+#include "polymake/Rational.h"
+#include "polymake/polytope/incremental_delaunay.h"
+
+namespace polymake { namespace polytope {
+
+template <typename Scalar>
+ListReturn delaunay_insertion(const Matrix<Scalar>& sites, const Matrix<Scalar>& new_sites)
+{
+   incremental_delaunay<Scalar> D(sites);
+   const typename incremental_delaunay<Scalar>::delta changes = D.insert(new_sites);
+   ListReturn result;
+   result << Array<Set<Int>>(changes.removed)
+          << Array<Set<Int>>(changes.added)
+          << D.get_cells()
+          << D.get_voronoi_vertices();
+   return result;
+}
+
+UserFunctionTemplate4perl("# @category Triangulations, subdivisions and volume"
+                          "# Compute the Delaunay subdivision of the //sites// and update it by inserting the //new_sites//."
+                          "# Only the cells in the conflict region of the new sites are recomputed."
+                          "# The cells are not triangulated if the sites are not in general position."
+                          "# @param Matrix sites in homogeneous coordinates, they must not lie on a common sphere or hyperplane"
+                          "# @param Matrix new_sites in homogeneous coordinates, they get the indices following those of //sites//"
+                          "# @return List (Array<Set<Int>> cells removed by the insertion, Array<Set<Int>> cells added by the insertion,"
+                          "#  Array<Set<Int>> all cells of the subdivision, Matrix Voronoi vertices, i.e. the circumcenters of the cells in the same order)"
+                          "# @example Insert a point into a quadrangle, which is then split into four triangles:"
+                          "# > ($removed, $added, $cells, $voronoi) = delaunay_insertion(new Matrix([[1,0,0],[1,6,0],[1,0,6],[1,5,5]]), new Matrix([[1,2,2]]));"
+                          "# > print $cells;"
+                          "# | {1 3 4}"
+                          "# | {2 3 4}"
+                          "# | {0 2 4}"
+                          "# | {0 1 4}",
+                          "delaunay_insertion<Scalar>(Matrix<type_upgrade<Scalar>> Matrix<type_upgrade<Scalar>>)");
+} }
+
+// Local Variables:
+// mode:C++
+// c-basic-offset:3
+// indent-tabs-mode:nil
+// End:
@@ -36,8 +36,8 @@ Matrix<Integer> integer_points_bbox(BigObject p_in)
    const Int d = H.cols()-1;
 
    // First find lower and upper bounds on each component by solving LPs in each +/- unit
-   // direction. The order does not matter, since the LP solver (currently) does not allow for a
-   // warm start.
+   // direction. The LPs are solved in one session, so that the solver may start each one
+   // from the optimal basis of the previous one.
 
    Vector<Scalar> obj(d+1);    // objective
    Vector<Integer> L(d+1);     // lower bounds
@@ -48,6 +48,9 @@ Matrix<Integer> integer_points_bbox(BigObject p_in)
    U[0] = 1;
    obj[0] = 0;
 
+   // the LPs differ only in the objective function
+   const auto lp = start_LP_session(H, E);
+
    // pass through dimensions
    for (Int i = 1; i <= d; ++i) {
       // set up unit vector
@@ -59,7 +62,7 @@ Matrix<Integer> integer_points_bbox(BigObject p_in)
       }
 
       // maximize along unit vector
-      auto S = solve_LP(H, E, obj, true);
+      auto S = lp->solve(obj, true);
       if (S.status != LP_status::valid)
          throw std::runtime_error("Cannot determine upper bounds for generating integer points");
 
@@ -67,7 +70,7 @@ Matrix<Integer> integer_points_bbox(BigObject p_in)
       U[i] = floor(S.objective_value);
 
       // minimize along unit vector (do not catch exceptions)
-      S = solve_LP(H, E, obj, false);
+      S = lp->solve(obj, false);
       if (S.status != LP_status::valid)
          throw std::runtime_error("Cannot determine lower bounds for generating integer points");
 
@@ -100,11 +100,15 @@ lineality_indices_among_inequalities(const GenericMatrix<TMatrix1, Scalar>& ineq
       ? Matrix<Scalar>(zero_vector<Scalar>(equations.rows()) | equations)
       : Matrix<Scalar>(); // to_simplex likes its zero matrices to have zero columns
 
+   // all LPs share the constraints, only the i-th inequality is switched off in turn
+   const auto lp = start_LP_session(Matrix<Scalar>(zero_vector<Scalar>(inequalities.rows()) | inequalities), eqs);
+
    for (Int i = 0; i < inequalities.rows(); ++i) {
-      const Matrix<Scalar> ineqs(zero_vector<Scalar>(inequalities.rows()-1) | inequalities.minor(~scalar2set(i), All));
       const Vector<Scalar> obj(Scalar(0) | inequalities[i]);
 
-      const auto S = solve_LP(ineqs, eqs, obj, true);
+      lp->set_inequality_active(i, false);
+      const auto S = lp->solve(obj, true);
+      lp->set_inequality_active(i, true);
       if (S.status == LP_status::valid) {
          if (S.objective_value <= 0) 
             lineality_indices += i;
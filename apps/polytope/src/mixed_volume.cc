@@ -20,7 +20,11 @@
 #include "polymake/Array.h"
 #include "polymake/Matrix.h"
 #include "polymake/Graph.h"
+#include "polymake/parallel.h"
 #include "polymake/polytope/solve_LP.h"
+#include "polymake/polytope/to_interface.h"
+#include <numeric>
+#include <vector>
 
 /*
   http://www.uni-frankfurt.de/fb/fb12/mathematik/dm/personen/steffens/Dokumente/MV_Computation1.pdf   [1]
@@ -29,173 +33,256 @@
 
 namespace polymake { namespace polytope {
 
+namespace {
+
+/* The mixed cells of the subdivision induced by the lifting are enumerated in a tree.
+   A node chooses edges from some of the polytopes such that the sum of their lifted midpoints
+   lies on the lower envelope of the lifted Minkowski sum of these polytopes, see [1];
+   the leaves choosing an edge from every polytope are the mixed cells, contributing the absolute determinant
+   of the edge directions.
+
+   The tree is built dynamically: a node branches on the polytope with the fewest edges which can be added,
+   and it is a dead end as soon as one polytope has none.  An edge which can't be added to a node
+   can't be added to any node below it either, thus the candidates tested are inherited from the parent.
+*/
+
+// an edge of one polytope
 template <typename E>
-using matrix_list = Array<Matrix<E>>;
+struct cell_edge {
+   std::vector<E> midpoint;   // lifted midpoint, affine coordinates followed by the lifting value
+   std::vector<E> direction;  // difference of the endpoints, affine coordinates
+};
+
 template <typename E>
-using vector_list = Array<Vector<E>>;
-using graph_list = Array<Graph<Undirected>>;
+struct cell_node {
+   std::vector<Int> chosen;                 // the edge chosen from each polytope, or -1
+   std::vector<E> point;                    // sum of the lifted midpoints of the chosen edges
+   std::vector<std::vector<Int>> candidates;  // the edges of the other polytopes which might be added
+   Int n_chosen;
+};
 
-template<typename E>
-Matrix<E> list2matrix(const std::vector<Matrix<E>>& v, const Int r, const Int c)
-{
-    Matrix<E> A(r, c);
-    auto Arows = rows(A).begin();
-    for (const auto& M : v) {
-       Arows = copy_range(entire(rows(M)), Arows);
-    }
-    return A;
-}
+/* The LPs deciding whether a point lies on the lower envelope of the lifted sum of some of the polytopes:
+   maximize the height mu over the convex combinations lambda of their points with
+     sum lambda_p (x_p, lift_p) + mu e_lift = point,  sum lambda_p = 1 for each selected polytope,  lambda, mu >= 0;
+   the point is on the lower envelope iff the maximum is 0.
+   The points of the other polytopes are excluded by the constant term 0 in their equation sum lambda_p = 0.
+   Thus all LPs share the constraint matrix and are solved in one session, each starting from the optimal basis
+   of the previous one, mostly the test of a sibling edge.
+   TOSimplex sessions don't call back into perl, hence every thread can keep its own instance.
+   For Rational coordinates they solve the LP in double precision first and verify the resulting basis exactly.
+*/
+template <typename E>
+class lower_envelope_check {
+public:
+   lower_envelope_check(const Array<Matrix<E>>& polytopes, const Array<Vector<E>>& lifts)
+      : n(polytopes.size())
+      , selected(n, false)
+   {
+      Int R = 0;
+      for (const auto& P : polytopes)
+         R += P.rows();
+      // variables: lambda for the points of all polytopes, then mu
+      Matrix<E> equations(2*n+1, R+2);
+      Int col = 1;
+      for (Int i = 0; i < n; ++i) {
+         for (Int p = 0; p < polytopes[i].rows(); ++p, ++col) {
+            for (Int c = 0; c < n; ++c)
+               equations(c, col) = polytopes[i](p, c+1);
+            equations(n, col) = lifts[i][p];
+            equations(n+1+i, col) = 1;
+         }
+      }
+      equations(n, col) = 1;
+      const Matrix<E> inequalities = zero_vector<E>(R+1) | unit_matrix<E>(R+1);
+      lp = to_interface::Solver<E>().start_session(inequalities, equations);
+      first_equation = R+1;
+      objective = unit_vector<E>(R+2, R+1);
+   }
 
-template<typename E>
-E solve_lp_mixed_volume(const Matrix<E>& M, const Vector<E>& objective)
-{
-    Matrix<E> eqs(M.cols()-1, M.cols());
-    for (Int j = 0; j < M.cols()-1; ++j)
-       eqs.row(j) = unit_vector<E>(M.cols(),j+1);
-    const auto S = solve_LP(eqs, M, objective, true);
-    if (S.status != LP_status::valid)
-       throw std::runtime_error("mixed_volume: wrong LP");
-    return S.objective_value;
-}
+   // whether the point lies on the lower envelope of the lifted sum of the polytopes with chosen[i] >= 0 and the polytope k
+   bool operator() (const std::vector<E>& point, const std::vector<Int>& chosen, Int k)
+   {
+      for (Int i = 0; i < n; ++i) {
+         const bool s = i == k || chosen[i] >= 0;
+         if (s != selected[i]) {
+            lp->set_constant_term(first_equation+n+1+i, s ? -one_value<E>() : zero_value<E>());
+            selected[i] = s;
+         }
+      }
+      for (Int c = 0; c <= n; ++c)
+         lp->set_constant_term(first_equation+c, -point[c]);
+      const LP_Solution<E> S = lp->solve(objective, true);
+      if (S.status != LP_status::valid)
+         throw std::runtime_error("mixed_volume: wrong LP");
+      return is_zero(S.objective_value);
+   }
 
-template<typename E>
-Matrix<E> construct_A(const Int n, const Array<Int>& r, const matrix_list<E>& polytopes, const vector_list<E>& lifted_edges)
-{
-    std::vector<Matrix<E> > c;
-    Int R = 0;
-    for (Int i = 0; i < n; ++i) {
-       Matrix<E> B = zero_matrix<E>(lifted_edges[i].size(),n+1);
-       B.col(0) = lifted_edges[i];
-       B.col(i+1) = ones_vector<E>(r[i]);
-       c.push_back((polytopes[i]| B));
-       R+=r[i];
-    }
-    Matrix<E> A = list2matrix(c, R, 2*n+2);
-    Vector<E> vec = unit_vector<E>(A.cols(),polytopes[0].cols());
-    A /= vec;
-    return T(A.minor(All,sequence(1,A.cols()-1))); // slice ones and transpose
-}
+private:
+   const Int n;
+   std::unique_ptr<LP_Session<E>> lp;
+   Int first_equation;
+   Vector<E> objective;
+   std::vector<bool> selected;
+};
 
-template<typename E>
-bool lower_envelope_check(Matrix<E>& A, const Int n, const Int k, const Array<Int>& r, const Vector<E>& m)
+// calls consume for each child of the node
+template <typename E, typename Consumer>
+void expand_node(cell_node<E>& node, const std::vector<std::vector<cell_edge<E>>>& edges,
+                 lower_envelope_check<E>& on_lower_envelope, const Consumer& consume)
 {
-    Int R = 0;
-    assert(r.size() >= k);
-    for (Int i = 0; i < k; ++i)
-       R += r[i];
-    const Vector<E> b = m | ones_vector<E>(n);
-    const Vector<E> obj = unit_vector<E>(R+2,R+1);
-    T(A).row(0) = -b;
-
-    const Matrix<E> M(A.minor(sequence(0,n+k+1),~sequence(R+1,A.cols()-R-2)));
-    return solve_lp_mixed_volume(M, obj)==0;
+   const Int n = edges.size(), d = node.point.size();
+   std::vector<E> point(d);
+   const auto add_midpoint = [&](Int k, Int e) {
+      const std::vector<E>& midpoint = edges[k][e].midpoint;
+      for (Int c = 0; c < d; ++c)
+         point[c] = node.point[c] + midpoint[c];
+   };
+
+   // drop the candidates which can't be added to this node
+   Int branch = -1;
+   for (Int k = 0; k < n; ++k) {
+      if (node.chosen[k] >= 0) continue;
+      std::vector<Int>& candidates = node.candidates[k];
+      auto keep = candidates.begin();
+      for (const Int e : candidates) {
+         add_midpoint(k, e);
+         if (on_lower_envelope(point, node.chosen, k))
+            *keep++ = e;
+      }
+      candidates.erase(keep, candidates.end());
+      if (candidates.empty()) return;
+      if (branch < 0 || candidates.size() < node.candidates[branch].size())
+         branch = k;
+   }
+
+   std::vector<Int> branch_edges;
+   branch_edges.swap(node.candidates[branch]);
+   ++node.n_chosen;
+   for (const Int e : branch_edges) {
+      add_midpoint(branch, e);
+      node.chosen[branch] = e;
+      std::swap(node.point, point);
+      consume(node);
+      std::swap(node.point, point);
+   }
+   node.chosen[branch] = -1;
+   --node.n_chosen;
 }
 
-template<typename E>
-E volume(const Int n, const Array<Int>& node, const Array<Int>& next, const matrix_list<E>& polytopes, const graph_list& graphs)
+// sum of the contributions of the mixed cells below the node, depth first
+template <typename E>
+E subtree_volume(cell_node<E>& node, const std::vector<std::vector<cell_edge<E>>>& edges, lower_envelope_check<E>& on_lower_envelope)
 {
-    Matrix<E> A(n, polytopes[0].cols()-1);
-    for (Int j = 0; j < n; ++j) {
-       auto it = entire(graphs[j].adjacent_nodes(node[j]));
-       for (Int i = 0; i < next[j]; ++i)  //reset iterator
-          ++it;
-       A.row(j) = (polytopes[j].row(node[j]) - polytopes[j].row(*it)).slice(range_from(1));
-    }
-    E d = det(A);
-    if (d == 0)
-       throw std::runtime_error("mixed_volume: calculation failed, edge matrix is singular.");
-    // check (2.9) in [2]. change the  Lift-functions
-    return abs(d);
+   const Int n = edges.size();
+   if (node.n_chosen == n) {
+      Matrix<E> A(n, n);
+      for (Int j = 0; j < n; ++j)
+         std::copy(edges[j][node.chosen[j]].direction.begin(), edges[j][node.chosen[j]].direction.end(), A.row(j).begin());
+      const E d = det(A);
+      if (is_zero(d))
+         throw std::runtime_error("mixed_volume: calculation failed, edge matrix is singular.");
+      // check (2.9) in [2]. change the  Lift-functions
+      return abs(d);
+   }
+   E vol(0);
+   // the children get their own copies of the candidate lists, which they shrink further
+   expand_node(node, edges, on_lower_envelope, [&](const cell_node<E>& child) {
+      cell_node<E> c(child);
+      vol += subtree_volume(c, edges, on_lower_envelope);
+   });
+   return vol;
 }
 
+// the mixed volume of the polytopes with the given vertices and graphs
 template <typename E>
-E mixed_volume(const Array<BigObject>& summands)
+E mixed_cells_volume(const Array<Matrix<E>>& polytopes, const Array<Graph<Undirected>>& graphs)
 {
-   E vol(0);             // mixedVolume
-   const Int n = summands.size();      // number of (input)polytopes
-   matrix_list<E> polytopes(n);      // stores matrices s.t. the i-th entry is a discribtion of P_j by vertices
-   vector_list<E> lifted_edges(n);
-   graph_list graphs(n);         // stores all graphs from the input polytopes P_j
-   Array<Int> node(n);
-   Array<Int> next(n);
-   Array<Int> r(n);              //stores the number of input Points
-
-   //initialization:
-   Int j = 0;
+   const Int n = polytopes.size();      // number of (input)polytopes
+   Array<Vector<E>> lifts(n);
+   std::vector<std::vector<cell_edge<E>>> polytope_edges(n);
+
    Vector<E> Lift(n+1);
    Lift[0] = 0;
-   for (const BigObject& s : summands) {
-      const Matrix<E> m = s.give("VERTICES");
-      polytopes[j] = m;
-      r[j] = m.rows();
+   for (Int j = 0; j < n; ++j) {
+      const Matrix<E>& m = polytopes[j];
+      if (m.cols() != n+1)
+         throw std::runtime_error("mixed_volume: dimension and number of input polytopes mismatch");
       for (Int k = 1; k <= n; ++k)        //LIFT
          Lift[k] = 1 + j*(1 - j*(1 - k*j)); //1 + j - j*j + k*j*j*j;
-      lifted_edges[j] = m*Lift;
-      const Graph<Undirected> graph=s.give("GRAPH.ADJACENCY");
-      graphs[j]=graph;
-      ++j;
-   }
-   if (n != polytopes[0].cols()-1)
-      throw std::runtime_error("mixed_volume: dimension and number of input polytopes mismatch");
-   Matrix<E> A = construct_A(n, r, polytopes, lifted_edges);
-   A = ones_vector<E>(A.rows()) | A;
-
-   // Algo:
-   Vector<E> m = zero_vector<E>(n+1);
-   Vector<E> temp;
-   Int count;
-
-   j = 0;
-   for (Int i = 0; i < polytopes[j].rows(); ++i) {
-      auto it = entire(graphs[j].adjacent_nodes(i));
-      for (count = 0; count < polytopes[j].rows()-1; ++count) {
-         if (*it > i) {
-            temp = ((polytopes[j].row(i) + polytopes[j].row(*it))/2).slice(range_from(1))
-                 | (lifted_edges[j][i] + lifted_edges[j][*it])/2;
-            if (lower_envelope_check(A, n, j+1, r, Vector<E>(m+temp))) {
-               node[j] = i;
-               next[j] = count;
-               if (j == n-1) {
-                  vol += volume(n, node, next, polytopes, graphs);
-               } else {
-                  ++j;
-                  m += temp;
-                  count = polytopes[j].rows();  //jump out of loop
-                  i = -1;
-               }
-            }
-         }
-         ++it;
-         if (j > 0 && it.at_end()&& i == polytopes[j].rows()-1) {
-            --j;
-            i = node[j];
-            it = entire(graphs[j].adjacent_nodes(i));
-            count = next[j];
-            for (Int k = 0; k < count; ++k) //reset iterator
-               ++it;
-            temp = ((polytopes[j].row(i) + polytopes[j].row(*it))/2).slice(range_from(1))
-                 | (lifted_edges[j][i] + lifted_edges[j][*it])/2;
-            m -= temp;
-            ++it;
-         }
-         if (it.at_end())
-            break;
+      lifts[j] = m*Lift;
+      for (auto e = entire(edges(graphs[j])); !e.at_end(); ++e) {
+         const Int u = std::min(e.from_node(), e.to_node()), v = std::max(e.from_node(), e.to_node());
+         const Vector<E> midpoint = ((m.row(u) + m.row(v))/2).slice(range_from(1)) | (lifts[j][u] + lifts[j][v])/2;
+         const Vector<E> direction = (m.row(u) - m.row(v)).slice(range_from(1));
+         cell_edge<E> edge;
+         edge.midpoint.assign(midpoint.begin(), midpoint.end());
+         edge.direction.assign(direction.begin(), direction.end());
+         polytope_edges[j].push_back(std::move(edge));
       }
    }
+
+   const Int n_threads = parallel::max_threads();
+   std::vector<lower_envelope_check<E>> checks;
+   for (Int t = 0; t < n_threads; ++t)
+      checks.emplace_back(polytopes, lifts);
+
+   std::vector<cell_node<E>> subtrees(1);
+   cell_node<E>& root = subtrees.front();
+   root.chosen.assign(n, -1);
+   root.point.resize(n+1);
+   root.n_chosen = 0;
+   for (Int j = 0; j < n; ++j) {
+      root.candidates.emplace_back(polytope_edges[j].size());
+      std::iota(root.candidates.back().begin(), root.candidates.back().end(), 0);
+   }
+
+   // split the tree breadth-first until there are enough subtrees to keep all threads busy
+   for (Int depth = 0; n_threads > 1 && depth < n && Int(subtrees.size()) < 8*n_threads; ++depth) {
+      std::vector<cell_node<E>> children;
+      for (auto& node : subtrees)
+         expand_node(node, polytope_edges, checks.front(), [&](const cell_node<E>& child) { children.push_back(child); });
+      subtrees = std::move(children);
+   }
+
+   const Array<E> volumes = parallel::transform(subtrees, [&](cell_node<E>& subtree) {
+      return subtree_volume(subtree, polytope_edges, checks[parallel::thread_num()]);
+   });
+
+   E vol(0);             // mixedVolume
+   for (const E& v : volumes)
+      vol += v;
    return vol;
 }
 
+}
+
+template <typename E>
+E mixed_volume(const Array<BigObject>& summands, OptionSet options)
+{
+   const parallel::ThreadLimit threads(options["threads"]);
+   const Int n = summands.size();
+   Array<Matrix<E>> polytopes(n);      // stores matrices s.t. the i-th entry is a discribtion of P_j by vertices
+   Array<Graph<Undirected>> graphs(n); // stores all graphs from the input polytopes P_j
+   for (Int j = 0; j < n; ++j) {
+      summands[j].give("VERTICES") >> polytopes[j];
+      summands[j].give("GRAPH.ADJACENCY") >> graphs[j];
+   }
+   return mixed_cells_volume(polytopes, graphs);
+}
+
 
 UserFunctionTemplate4perl("# @category Triangulations, subdivisions and volume"
                           "# Produces the mixed volume of polytopes P<sub>1</sub>,P<sub>2</sub>,...,P<sub>n</sub>."
                           "# @param Polytope<Scalar> P1 first polytope"
                           "# @param Polytope<Scalar> P2 second polytope"
                           "# @param Polytope<Scalar> Pn last polytope"
+                          "# @option Int threads number of threads exploring the enumeration tree of the mixed cells in parallel;"
+                          "#  default is the custom variable $common::max_threads"
                           "# @return Scalar mixed volume"
                           "# @example"
                           "# > print mixed_volume(cube(2),simplex(2));"
                           "# | 4",
-                          "mixed_volume<Scalar>(Polytope<Scalar> +)");
+                          "mixed_volume<Scalar>(Polytope<Scalar> +; { threads => undef })");
 
 } }
 
@@ -27,7 +27,9 @@
 #include "polymake/vector"
 #include "polymake/pair.h"
 #include "polymake/numerical_functions.h"
+#include "polymake/parallel.h"
 #include <algorithm>
+#include <vector>
 
 namespace polymake { namespace polytope {
 
@@ -62,22 +64,29 @@ struct EdgeData {
    EdgeData(const Bitset& a1, const Bitset& a2, const Bitset& v, const bool& m) : adv1(a1), adv2(a2), vis(v), monotony(m), trivial(false) {}
 };
 
+//sign of the determinant of three points in homogeneous coordinates: positive iff c lies to the left of the line from a to b
+template <typename Scalar>
+Int orientation(const Vector<Scalar>& a, const Vector<Scalar>& b, const Vector<Scalar>& c)
+{
+   return sign(a[0]*(b[1]*c[2]-b[2]*c[1]) - a[1]*(b[0]*c[2]-b[2]*c[0]) + a[2]*(b[0]*c[1]-b[1]*c[0]));
+}
+
 //calculates the following informations for all edges: possible advances, upper visible points to the right of the left endpoint, monotony
+//the edges starting at different points are treated in parallel
 template <typename Scalar>
-Array<Array<EdgeData > > edge_precalc(const Array< Vector<Scalar> > points)
+Array<Array<EdgeData>> edge_precalc(const Array<Vector<Scalar>>& points)
 {
-   typedef typename pm::algebraic_traits<Scalar>::field_type field;
    const Int n = points.size();
-   Array<Array<EdgeData > > edges(n-2);
+   Array<Array<EdgeData>> edges(n-2);
+   // the parallel section must not touch any reference counters
+   std::vector<EdgeData*> edges_from(n-2);
    for (Int i = 0; i < n-2; ++i) {
-      Array<EdgeData > tmp(n-i-1);
-      edges[i] = tmp;
+      edges[i].resize(n-i-1);
+      edges_from[i] = &edges[i][0];
    }
-   Matrix<field> V(3,3);
-   bool candidate = true;
-   BigObject::Schedule s;
-   const IncidenceMatrix<>& illegal_edges = calc_illegal_edges<Scalar>(points);
-   for (Int i = 0; i < n-2; ++i) {
+   const IncidenceMatrix<> illegal_edges = calc_illegal_edges<Scalar>(points);
+
+   parallel::for_each(sequence(0, n-2), [&](Int i) {
       for (Int j = i+1; j < n; ++j) {
          if (0==illegal_edges(i,j)) {
             Bitset adv_type1(j-i-1);
@@ -85,58 +94,40 @@ Array<Array<EdgeData > > edge_precalc(const Array< Vector<Scalar> > points)
             Bitset vis_from_above(n-i-2);
             for (Int k = i+1; k < n; ++k) {
                if (k!=j && (0==illegal_edges(i,k)) && (0==illegal_edges(j,k))) {
-                  BigObject p = BigObject("Polytope", mlist<field>());
-                  V.row(0) = points[i];
-                  V.row(1) = points[k];
-                  V.row(2) = points[j];
-                  p.take("VERTICES") << V;
-                  if (!s.valid())
-                     s = p.call_method("get_schedule", "FACETS", "VERTICES_IN_FACETS");
-                  s.apply(p);
-
-                  const Matrix<field> facets = p.give("FACETS");
-                  const IncidenceMatrix<> VIF = p.give("VERTICES_IN_FACETS");
-
+                  // the points are sorted lexicographically, hence k lies above the edge iff it lies to the left of it
+                  const bool above = orientation(points[i], points[j], points[k]) > 0;
                   //for each point in the segment wrt. the x-coordinate check if the corresponding triangle constitutes an advance triangle
                   if (k < j) {
-                     candidate = true;
                      //the triangle is an advance triangle iff there is no other point of the input in its interior
-                     for (Int l = i+1; l < j; ++l) {
-                        if (l != k) {
-                           Vector<field> eval = facets*points[l];
-                           if (eval[0]>0 && eval[1]>0 && eval[2]>0)
-                              candidate = false;
-                        }
+                     const Int o = orientation(points[i], points[k], points[j]);
+                     bool candidate = true;
+                     for (Int l = i+1; l < j && candidate; ++l) {
+                        if (l != k &&
+                            orientation(points[i], points[k], points[l]) == o &&
+                            orientation(points[k], points[j], points[l]) == o &&
+                            orientation(points[j], points[i], points[l]) == o)
+                           candidate = false;
                      }
-                  }
-                  //calculate the index of the facet which contains the points i and j
-                  Int index = 0;
-                  for (Int l = 0; l < 3; ++l) {
-                     if (VIF.exists(l,0) && VIF.exists(l,2))
-                        index = l;
-                  }
-                  // check if the additional point satifies the visibility condition
-                  // and determine the advance type in the case of constituting an advance triangle
-                  if (facets(index,2)>0) {
-                     if (k<j) {
+                     // determine the advance type
+                     if (above) {
                         if (candidate)
                            adv_type1 += k-i-1;
                         vis_from_above += k-i-1;
                      }
-                     else {
-                        vis_from_above += k-i-2;
+                     else if (candidate) {
+                        adv_type2 += k-i-1;
                      }
                   }
-                  else if (candidate && (k<j)) {
-                     adv_type2 += k-i-1;
+                  // check if the additional point satifies the visibility condition
+                  else if (above) {
+                     vis_from_above += k-i-2;
                   }
                }
             }
-            EdgeData ed(adv_type1,adv_type2,vis_from_above, Rational(points[j][2]-points[i][2]) < 0 ? true : false);
-            edges[i][j-i-1] = ed;
+            edges_from[i][j-i-1] = EdgeData(adv_type1, adv_type2, vis_from_above, points[j][2] < points[i][2]);
          }
       }
-   }
+   });
    return edges;
 }
 
@@ -165,112 +156,137 @@ Int lower_upper_boundary(Bitset& lower, Bitset& upper, BigObject p)
    return boundary_points.size();
 }
 
-}// end anonymous namespace
-
-//calculate the number of triangulations in the input points
-template <typename Scalar>
-Integer n_fine_triangulations(const Matrix<Scalar>& points, OptionSet options)
-{
-   const bool opt(options["optimization"]);
-   const Int n = points.rows();
-
-   if (points.cols() != 3)
-      throw std::runtime_error("this algorithm works for planar point configurations only");
-   if (n < 3)
-      throw std::runtime_error("insufficient number of points");
-
-   Array<Vector<Scalar>> ordered_points(rows(points));
-   std::sort(ordered_points.begin(), ordered_points.end(), operations::lex_less());
-
-   //precalculations for the edges
-   Array<Array<EdgeData>> advance_triangles = edge_precalc<Scalar>(ordered_points);
-   BigObject p("Polytope", mlist<Scalar>());
-   Matrix<Scalar> ordered_points_matrix(n,points.cols(),entire(ordered_points));
-
-   p.take("FEASIBLE") << true;
-   p.take("BOUNDED") << true;
-   p.take("POINTS") << ordered_points_matrix;
-
-   //calculate the upper boundary and the source for an DAG
-   const Int size = n+log2_ceil(n);
-   Bitset upper_boundary(n);
-   Bitset source(size);
-   source+= size-1;
-   const Int n_boundary_points = lower_upper_boundary<Scalar>(source,upper_boundary,p);
+//enumerates the successors of a marked chain in the DAG of monotone sweeps
+class MarkedChainAdvances {
+public:
+   MarkedChainAdvances(const Array<Array<EdgeData>>& advance_triangles_arg, const Bitset& upper_boundary_arg, Int n_arg, bool opt_arg)
+      : advance_triangles(advance_triangles_arg)
+      , upper_boundary(upper_boundary_arg)
+      , n(n_arg)
+      , size(n_arg+log2_ceil(n_arg))
+      , opt(opt_arg) {}
 
-   hash_map<Bitset, Integer> unmap1;
-   hash_map<Bitset, Integer> unmap2;
-   hash_map<Bitset, Integer> *current_lvl = &unmap1, *next_lvl = &unmap2;
-   Integer counter(1);
-   unmap1[source] = counter;
-
-   //while keeping at most two hashtables for consecutive levels in memory, calculate the number of triangulations for each level one after another
-   for (Int i = 0; i < 2*n-n_boundary_points-2; ++i) {	
-      for (auto chain = current_lvl->begin(); chain != current_lvl->end(); chain = current_lvl->erase(chain)) {
-         Bitset current_mchain = (*chain).first;
-         Bitset on_or_above(n);
-         if (opt) {
-            // calculate all points on or above the current chain and relate them to their visible edges
-            on_or_above += 0;
-            auto right_end = current_mchain.begin();
-            ++right_end;
-            for (Int j = 0; j != n-1; j = *right_end, ++right_end) {
-               on_or_above += *right_end;
-               for (Int l = j+1; l < *right_end; l++)
-                  if (advance_triangles[j][*right_end-j-1].vis.contains(l-j-1))
-                     on_or_above += l;
-            }
+   //calls add for each marked chain reachable from current_mchain by one advance;
+   //only reads the precalculated data, can be used by several threads at once
+   template <typename Consumer>
+   void operator() (Bitset current_mchain, const Consumer& add) const
+   {
+      Bitset on_or_above(n);
+      if (opt) {
+         // calculate all points on or above the current chain and relate them to their visible edges
+         on_or_above += 0;
+         auto right_end = current_mchain.begin();
+         ++right_end;
+         for (Int j = 0; j != n-1; j = *right_end, ++right_end) {
+            on_or_above += *right_end;
+            for (Int l = j+1; l < *right_end; l++)
+               if (advance_triangles[j][*right_end-j-1].vis.contains(l-j-1))
+                  on_or_above += l;
          }
-         // calculate the marking from the corresponding bitset
-         Int mark = 0;
-         auto leading_one = current_mchain.begin();
-         while (*leading_one < n)
-            ++leading_one;
-         for (Int j = size-1; j >= *leading_one; --j) {
-            if (current_mchain.contains(j)) {
-               mark+= pow(2,size-j-1);
-            }
+      }
+      // calculate the marking from the corresponding bitset
+      Int mark = 0;
+      auto leading_one = current_mchain.begin();
+      while (*leading_one < n)
+         ++leading_one;
+      for (Int j = size-1; j >= *leading_one; --j) {
+         if (current_mchain.contains(j)) {
+            mark+= pow(2,size-j-1);
          }
-         Int left = 0, mid = 0, right = 0;
-         // calculate the start nodes according to the mark of the chain
-         auto unmarked = current_mchain.begin();
-         for (Int j = 0; j+2 < mark; ++j) {
-            ++unmarked;
+      }
+      Int left = 0, mid = 0, right = 0;
+      // calculate the start nodes according to the mark of the chain
+      auto unmarked = current_mchain.begin();
+      for (Int j = 0; j+2 < mark; ++j) {
+         ++unmarked;
+      }
+      mid = *unmarked;
+
+      if (mark > 1) {
+         unmarked++;
+         right = *(unmarked);
+         //decrement the mark in binary of the chain
+         Int j = size-1;
+         while (!current_mchain.contains(j)) {
+           current_mchain += j;
+           j--;
          }
-         mid = *unmarked;
+         current_mchain -= j;
+      }
 
-         if (mark > 1) {
-            unmarked++;
-            right = *(unmarked);
-            //decrement the mark in binary of the chain
+      // check each edge in the current chain for legal successors
+      do {
+         left = mid;
+         mid = right;
+         auto legal_edge = current_mchain.begin();
+         while (*legal_edge < mid+1)
+            ++legal_edge;
+         right = *legal_edge;
+         // check for advances of type 2 which exclude a point from the chain
+         if (mid > 0) {
+            if (!advance_triangles[left][right-left-1].trivial && advance_triangles[left][right-left-1].adv2.contains(mid-left-1)) {
+               //check if the visibility condition is met for the advanced marked chain in question
+               current_mchain -= mid;
+               if (opt) {
+                  on_or_above -= mid;
+                  bool visible = true;
+                  auto untreated = current_mchain.begin();
+                  ++untreated;
+                  Int tmp = 0;
+                  for (Int m = 0; m < left && visible; m = tmp) {
+                     tmp = *untreated;
+                     untreated++;
+                     if ((upper_boundary.contains(m) && upper_boundary.contains(tmp)) || advance_triangles[m][tmp-m-1].monotony)
+                        continue;
+                     else
+                        if (upper_boundary.contains(tmp))
+                           visible = false;
+                        else
+                           if (tmp < left && !(advance_triangles[tmp][*untreated-tmp-1].monotony))
+                              continue;
+                           else {
+                              bool retrace = false;
+                              //check for a possible retrace
+                              for (Int s = tmp+1; s < n && !retrace; ++s)
+                                 if (advance_triangles[m][tmp-m-1].vis.contains(s-m-2) && on_or_above.contains(s) &&
+                                    advance_triangles[m][s-m-1].adv2.contains(tmp-m-1))
+                                    retrace = true;
+                              if (retrace)
+                                 continue;
+                              else
+                                 visible = false;
+                           }
+                  }
+                  if (visible) {
+                     add(current_mchain);
+                     on_or_above += mid;
+                  }
+               }
+               if (!opt)
+                  add(current_mchain);
+               current_mchain += mid;
+            }
+            //increment the mark in binary of the chain
             Int j = size-1;
-            while (!current_mchain.contains(j)) {
-              current_mchain += j;
-              j--;
+            while (current_mchain.contains(j)) {
+               current_mchain -= j;
+               j--;
             }
-            current_mchain -= j;
+            current_mchain += j;
          }
 
-         // check each edge in the current chain for legal successors
-         do {
-            left = mid;
-            mid = right;
-            auto legal_edge = current_mchain.begin();
-            while (*legal_edge < mid+1)
-               ++legal_edge;
-            right = *legal_edge;
-            // check for advances of type 2 which exclude a point from the chain
-            if (mid > 0) {
-               if (!advance_triangles[left][right-left-1].trivial && advance_triangles[left][right-left-1].adv2.contains(mid-left-1)) {
-                  //check if the visibility condition is met for the advanced marked chain in question
-                  current_mchain -= mid;
+         //check for advances of type 1 which include a new point into the chain
+         if (right-mid > 1) {
+            for (Int j = mid+1; j < right; ++j) {
+               if (!advance_triangles[mid][right-mid-1].trivial && advance_triangles[mid][right-mid-1].adv1.contains(j-mid-1)) {
+                  //check if the visibility condition is met
+                  current_mchain += j;
                   if (opt) {
-                     on_or_above -= mid;
                      bool visible = true;
                      auto untreated = current_mchain.begin();
                      ++untreated;
                      Int tmp = 0;
-                     for (Int m = 0; m < left && visible; m = tmp) {
+                     for (Int m = 0; m < mid && visible; m = *untreated++) {
                         tmp = *untreated;
                         untreated++;
                         if ((upper_boundary.contains(m) && upper_boundary.contains(tmp)) || advance_triangles[m][tmp-m-1].monotony)
@@ -279,7 +295,7 @@ Integer n_fine_triangulations(const Matrix<Scalar>& points, OptionSet options)
                            if (upper_boundary.contains(tmp))
                               visible = false;
                            else
-                              if (tmp < left && !(advance_triangles[tmp][*untreated-tmp-1].monotony))
+                              if (tmp < mid && !(advance_triangles[tmp][*untreated-tmp-1].monotony))
                                  continue;
                               else {
                                  bool retrace = false;
@@ -294,75 +310,152 @@ Integer n_fine_triangulations(const Matrix<Scalar>& points, OptionSet options)
                                     visible = false;
                               }
                      }
-                     if (visible) {
-                        (*next_lvl)[current_mchain] += (*chain).second;
-                        on_or_above += mid;
-                     }
+                     if (visible)
+                        add(current_mchain);
                   }
                   if (!opt)
-                     (*next_lvl)[current_mchain] += (*chain).second;
-                  current_mchain += mid;
-               }
-               //increment the mark in binary of the chain
-               Int j = size-1;
-               while (current_mchain.contains(j)) {
-                  current_mchain -= j;
-                  j--;
+                     add(current_mchain);
+                  current_mchain -=j;
                }
-               current_mchain += j;
             }
+         }
+      } while (right < n-1);
+   }
 
-            //check for advances of type 1 which include a new point into the chain
-            if (right-mid > 1) {
-               for (Int j = mid+1; j < right; ++j) {
-                  if (!advance_triangles[mid][right-mid-1].trivial && advance_triangles[mid][right-mid-1].adv1.contains(j-mid-1)) {
-                     //check if the visibility condition is met
-                     current_mchain += j;
-                     if (opt) {
-                        bool visible = true;
-                        auto untreated = current_mchain.begin();
-                        ++untreated;
-                        Int tmp = 0;
-                        for (Int m = 0; m < mid && visible; m = *untreated++) {
-                           tmp = *untreated;
-                           untreated++;
-                           if ((upper_boundary.contains(m) && upper_boundary.contains(tmp)) || advance_triangles[m][tmp-m-1].monotony)
-                              continue;
-                           else
-                              if (upper_boundary.contains(tmp))
-                                 visible = false;
-                              else
-                                 if (tmp < mid && !(advance_triangles[tmp][*untreated-tmp-1].monotony))
-                                    continue;
-                                 else {
-                                    bool retrace = false;
-                                    //check for a possible retrace
-                                    for (Int s = tmp+1; s < n && !retrace; ++s)
-                                       if (advance_triangles[m][tmp-m-1].vis.contains(s-m-2) && on_or_above.contains(s) &&
-                                          advance_triangles[m][s-m-1].adv2.contains(tmp-m-1))
-                                          retrace = true;
-                                    if (retrace)
-                                       continue;
-                                    else
-                                       visible = false;
-                                 }
-                        }
-                        if (visible)
-                           (*next_lvl)[current_mchain] += (*chain).second;
-                     }
-                     if (!opt)
-                        (*next_lvl)[current_mchain] += (*chain).second;
-                     current_mchain -=j;
-                  }
-               }
-            }
-         } while (right < n-1);
-      }
-      std::swap(current_lvl,next_lvl);
+private:
+   const Array<Array<EdgeData>>& advance_triangles;
+   const Bitset& upper_boundary;
+   const Int n, size;
+   const bool opt;
+};
+
+#ifdef __SIZEOF_INT128__
+using WideCount = unsigned __int128;
+#else
+using WideCount = unsigned long long;
+#endif
+
+//adds a counter to a sum, returns false on overflow
+inline bool add_count(WideCount& sum, WideCount x)
+{
+   return !__builtin_add_overflow(sum, x, &sum);
+}
+
+inline bool add_count(Integer& sum, const Integer& x)
+{
+   sum += x;
+   return true;
+}
+
+Integer to_Integer(WideCount x)
+{
+   Integer result(static_cast<unsigned long>(x >> 32 >> 32));
+   result <<= 64;
+   result += Integer(static_cast<unsigned long>(x));
+   return result;
+}
+
+//replaces the marked chains of a level by their successors, summing up the counters of the paths leading to them;
+//the chains are advanced in parallel, each thread collecting the successors in its own table.
+//If a counter overflows, the level is left unchanged and false is returned.
+template <typename Counter>
+bool advance_level(const MarkedChainAdvances& advances, hash_map<Bitset, Counter>& level)
+{
+   std::vector<const std::pair<const Bitset, Counter>*> chains;
+   chains.reserve(level.size());
+   for (const auto& chain : level)
+      chains.push_back(&chain);
+   const Int n_chains = chains.size(), n_threads = parallel::max_threads();
+
+   std::vector<hash_map<Bitset, Counter>> next_parts(n_threads);
+   std::vector<char> overflow(n_threads, false);
+   parallel::for_each(sequence(0, n_chains), [&](Int c) {
+      const Int thread = parallel::thread_num();
+      hash_map<Bitset, Counter>& next = next_parts[thread];
+      const Counter& count = chains[c]->second;
+      advances(chains[c]->first, [&](const Bitset& chain) {
+         if (!add_count(next[chain], count))
+            overflow[thread] = true;
+      });
+   }, 64);
+   if (std::find(overflow.begin(), overflow.end(), true) != overflow.end())
+      return false;
+
+   //merge the tables into the largest one, releasing the others as soon as possible
+   auto next = std::max_element(next_parts.begin(), next_parts.end(),
+                                [](const hash_map<Bitset, Counter>& a, const hash_map<Bitset, Counter>& b) { return a.size() < b.size(); });
+   for (auto part = next_parts.begin(); part != next_parts.end(); ++part) {
+      if (part == next) continue;
+      for (const auto& chain : *part)
+         if (!add_count((*next)[chain.first], chain.second))
+            return false;
+      hash_map<Bitset, Counter>().swap(*part);
    }
+   level.swap(*next);
+   return true;
+}
+
+}// end anonymous namespace
+
+//calculate the number of triangulations in the input points
+template <typename Scalar>
+Integer n_fine_triangulations(const Matrix<Scalar>& points, OptionSet options)
+{
+   const bool opt(options["optimization"]);
+   const parallel::ThreadLimit threads(options["threads"]);
+   const Int n = points.rows();
+
+   if (points.cols() != 3)
+      throw std::runtime_error("this algorithm works for planar point configurations only");
+   if (n < 3)
+      throw std::runtime_error("insufficient number of points");
+
+   Array<Vector<Scalar>> ordered_points(rows(points));
+   std::sort(ordered_points.begin(), ordered_points.end(), operations::lex_less());
+
+   //precalculations for the edges
+   const Array<Array<EdgeData>> advance_triangles = edge_precalc<Scalar>(ordered_points);
+   BigObject p("Polytope", mlist<Scalar>());
+   Matrix<Scalar> ordered_points_matrix(n,points.cols(),entire(ordered_points));
+
+   p.take("FEASIBLE") << true;
+   p.take("BOUNDED") << true;
+   p.take("POINTS") << ordered_points_matrix;
+
+   //calculate the upper boundary and the source for an DAG
+   const Int size = n+log2_ceil(n);
+   Bitset upper_boundary(n);
+   Bitset source(size);
+   source+= size-1;
+   const Int n_boundary_points = lower_upper_boundary<Scalar>(source,upper_boundary,p);
+   const MarkedChainAdvances advances(advance_triangles, upper_boundary, n, opt);
+   const Int n_levels = 2*n-n_boundary_points-2;
+
+   //while keeping at most two levels in memory, calculate the number of triangulations for each level one after another;
+   //the counters are 128-bit integers until one of them overflows, then the level is repeated with Integer counters
+   hash_map<Bitset, WideCount> wide_level;
+   wide_level[source] = 1;
+   Int i = 0;
+   while (i < n_levels && advance_level(advances, wide_level))
+      ++i;
+
+   WideCount wide_tr = 0;
+   if (i == n_levels) {
+      bool fits = true;
+      for (auto chain = wide_level.begin(); chain != wide_level.end() && fits; ++chain)
+         fits = add_count(wide_tr, chain->second);
+      if (fits) return to_Integer(wide_tr);
+   }
+
+   hash_map<Bitset, Integer> current_lvl;
+   for (auto chain = wide_level.begin(); chain != wide_level.end(); chain = wide_level.erase(chain))
+      current_lvl[chain->first] = to_Integer(chain->second);
+   for (; i < n_levels; ++i)
+      advance_level(advances, current_lvl);
+
    //calculate the number of triangulations from the counters of the last iteration
    Integer tr(0);
-   for (auto chain = current_lvl->begin(); chain != current_lvl->end(); ++chain) {
+   for (auto chain = current_lvl.begin(); chain != current_lvl.end(); ++chain) {
       tr += chain->second;
    }
    return tr;
@@ -378,10 +471,12 @@ UserFunctionTemplate4perl("# @category Triangulations, subdivisions and volume"
                           "# "
                           "# @param Matrix M in the plane (homogeneous coordinates)"
                           "# @param Bool optimization defaults to 1, where 1 includes optimization and 0 excludes it"
+                          "# @option Int threads number of threads advancing the marked chains of a sweep level in parallel;"
+                          "#  default is the custom variable $common::max_threads"
                           "# @return Integer number of fine triangulations"
                           "# @example To print the number of possible fine triangulations of a square, do this:"
                           "# > print n_fine_triangulations(cube(2)->VERTICES);"
-                          "# | 2","n_fine_triangulations(Matrix { optimization => 1})");
+                          "# | 2","n_fine_triangulations(Matrix { optimization => 1, threads => undef })");
 
 } }
 
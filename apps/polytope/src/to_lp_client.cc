@@ -40,6 +40,10 @@ FunctionTemplate4perl("to_lp_client<Scalar> (Polytope<Scalar>, LinearProgram<Sca
 
 InsertEmbeddedRule("function to.simplex: create_LP_solver<Scalar> [is_ordered_field_with_unlimited_precision(Scalar)] ()"
                    " : c++ (name => 'to_interface::create_LP_solver') : returns(cached);\n");
+
+// for Rational the solver starts from a double precision basis; this label is ranked first in main.rules
+InsertEmbeddedRule("function to.simplex.rational: create_LP_solver<Scalar> [Scalar==Rational] ()"
+                   " : c++ (name => 'to_interface::create_LP_solver') : returns(cached);\n");
 } }
 
 // Local Variables:
@@ -23,6 +23,7 @@
 #include "polymake/Rational.h"
 #include "polymake/ListMatrix.h"
 #include "polymake/Set.h"
+#include "polymake/parallel.h"
 #include "polymake/polytope/solve_LP.h"
 #include "polymake/polytope/generic_milp_client.h"
 
@@ -108,7 +109,11 @@ Matrix<Integer> to_compute_lattice_points(Matrix<Scalar>& F, Matrix<Scalar>& A)
    std::vector<TOExMipSol::rowElement<Scalar,Int>> objfunc;	// objective function (sparse)
    TOExMipSol::MIP<Scalar,Int> mip = construct_mip(F, A, true, objfunc, numbersystems);
    // Solver
+   // The set of all feasible points does not depend on the course of the branch-and-bound,
+   // hence it may run in parallel.
+   const parallel::ThreadLimit threads;
    TOExMipSol::TOMipSolver<Scalar,Int> solver;
+   solver.setNumThreads(parallel::max_threads());
 
    // Results go here
    Scalar objval;
@@ -131,6 +136,9 @@ Matrix<Integer> to_compute_lattice_points(Matrix<Scalar>& F, Matrix<Scalar>& A)
       return Matrix<Integer>(0, dim);
    }
 
+   // The order in which the points are found depends on the threads.
+   // They are delivered in lexicographic order instead, whatever the number of threads.
+   std::sort(allAssignments.begin(), allAssignments.end());
    ListMatrix<Vector<Integer>> L;
    for (Int i = 0; i < Int(allAssignments.size()); ++i) {
       Vector<Integer> V(numCols, allAssignments[i].begin());
@@ -170,6 +178,8 @@ public:
       }
       auto TOMIP = construct_mip<Scalar>(H, E, maximize, objfunc, numbersystems);
       /////////////////////////////////////////////////////////////////////////
+      // The branch-and-bound stays sequential: in parallel, the choice among several optimal solutions
+      // would depend on the course of the search.
       TOExMipSol::TOMipSolver<Scalar,Int> solver;
 
       // Results go here
@@ -208,8 +218,9 @@ auto create_MILP_solver()
 } // namespace to_interface
 
 template<typename Scalar>
-Matrix<Integer> to_lattice_points(BigObject p)
+Matrix<Integer> to_lattice_points(BigObject p, OptionSet options)
 {
+   const parallel::ThreadLimit threads(options["threads"]);
    Matrix<Scalar> F = p.give("FACETS|INEQUALITIES");
    Matrix<Scalar> A = p.lookup("AFFINE_HULL|EQUATIONS");
    return to_interface::to_compute_lattice_points(F,A);
@@ -222,7 +233,28 @@ void to_milp_client(BigObject p, BigObject milp, bool maximize)
    generic_milp_client<Scalar, to_interface::MILP_SolverImpl<Scalar>>(p, milp, maximize, S);
 }
    
-FunctionTemplate4perl("to_lattice_points<Scalar>(Polytope<Scalar>)");
+UserFunctionTemplate4perl("# @category Geometry"
+                          "# Enumerate the lattice points of a bounded polytope with the branch-and-bound of TOExMipSol."
+                          "# The search tree is explored in parallel threads, as the set of lattice points does not depend on its course."
+                          "# The points are returned in lexicographic order, whatever the number of threads."
+                          "# TOExMipSol itself uses one thread by default; the optimization rules of [[MILP]] keep it this way,"
+                          "# since the choice among several optimal solutions would depend on the course of a parallel search."
+                          "# @param Polytope<Rational> P"
+                          "# @option Int threads number of threads exploring the search tree;"
+                          "#  default is the custom variable $common::max_threads"
+                          "# @return Matrix<Integer> the lattice points in homogeneous coordinates"
+                          "# @example"
+                          "# > print to_lattice_points(cube(2), threads=>2);"
+                          "# | 1 -1 -1"
+                          "# | 1 -1 0"
+                          "# | 1 -1 1"
+                          "# | 1 0 -1"
+                          "# | 1 0 0"
+                          "# | 1 0 1"
+                          "# | 1 1 -1"
+                          "# | 1 1 0"
+                          "# | 1 1 1",
+                          "to_lattice_points<Scalar>(Polytope<Scalar> { threads => undef })");
    
 FunctionTemplate4perl("to_milp_client<Scalar>(Polytope<Scalar>, MixedIntegerLinearProgram<Scalar>, $)");
    
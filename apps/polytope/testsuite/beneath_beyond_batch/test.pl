@@ -0,0 +1,51 @@
+#  Copyright (c) 1997-2020
+#  Ewgenij Gawrilow, Michael Joswig, and the polymake team
+#  Technische Universität Berlin, Germany
+#  https://polymake.org
+#
+#  This program is free software; you can redistribute it and/or modify it
+#  under the terms of the GNU General Public License as published by the
+#  Free Software Foundation; either version 2, or (at your option) any
+#  later version: http://www.gnu.org/licenses/gpl.txt.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#-------------------------------------------------------------------------------
+
+# With a positive batch_size and more than one thread, the visibility of the facets is evaluated
+# for batches of points in parallel.  The results must be the same as with the sequential algorithm.
+
+my $points = rand_box(4, 200, 10, seed=>1)->POINTS;
+compare_values('redundant', placing_triangulation($points), placing_triangulation($points, batch_size=>8, threads=>2));
+
+my $vertices = cyclic(4, 40)->VERTICES;
+compare_values('non_redundant', placing_triangulation($vertices, non_redundant=>1),
+               placing_triangulation($vertices, non_redundant=>1, batch_size=>8, threads=>2));
+
+my $perm = new Array<Int>(reverse(0..39));
+compare_values('permutation', placing_triangulation($vertices, permutation=>$perm),
+               placing_triangulation($vertices, permutation=>$perm, batch_size=>3, threads=>2));
+
+# the convex hull rules take the batch size from the custom variable
+sub hull {
+   my $p = new Polytope(POINTS=>$points);
+   [ $p->VERTICES, $p->FACETS, $p->VERTICES_IN_FACETS ]
+}
+prefer_now "beneath_beyond";
+my $sequential = hull();
+{
+   local $polytope::beneath_beyond_batch_size = 8;
+   local $common::max_threads = 2;
+   my $batched = hull();
+   compare_values('vertices', $sequential->[0], $batched->[0]);
+   compare_values('facets', $sequential->[1], $batched->[1]);
+   compare_values('vertices_in_facets', $sequential->[2], $batched->[2]);
+}
+
+# Local Variables:
+# mode: perl
+# cperl-indent-level:3
+# indent-tabs-mode:nil
+# End:
@@ -0,0 +1,55 @@
+#  Copyright (c) 1997-2020
+#  Ewgenij Gawrilow, Michael Joswig, and the polymake team
+#  Technische Universität Berlin, Germany
+#  https://polymake.org
+#
+#  This program is free software; you can redistribute it and/or modify it
+#  under the terms of the GNU General Public License as published by the
+#  Free Software Foundation; either version 2, or (at your option) any
+#  later version: http://www.gnu.org/licenses/gpl.txt.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#-------------------------------------------------------------------------------
+
+# The beneath-beyond convex hull on floating-point coordinates must agree with cdd.
+# All coordinates are small integers, hence the vertices are represented exactly.
+
+my $cube_points = convert_to<Float>(cube(3)->VERTICES / new Matrix<Rational>([[1,0,0,0],[1,1,0,0],[1,1,1,0],[1,"1/2","1/2","1/2"]]));
+my $cyclic = convert_to<Float>(cyclic(4,10)->VERTICES);
+my $cube_facets = convert_to<Float>(cube(3)->FACETS);
+
+sub dehomogenized_rows {
+   my ($M) = @_;
+   return new Set<Vector<Float>>([ map { $_ / $_->[0] } @$M ]);
+}
+
+sub hulls {
+   my $p = new Polytope<Float>(POINTS=>$cube_points);
+   my $q = new Polytope<Float>(VERTICES=>$cyclic);
+   my $r = new Polytope<Float>(INEQUALITIES=>$cube_facets);
+   return { cube_vertices => dehomogenized_rows($p->VERTICES),
+            cube_f_vector => $p->F_VECTOR,
+            cyclic_facets => new Set<Set<Int>>(rows($q->VERTICES_IN_FACETS)),
+            dual_vertices => dehomogenized_rows($r->VERTICES),
+            dual_n_facets => $r->N_FACETS };
+}
+
+prefer_now "cdd";
+my $cdd = hulls();
+prefer_now "beneath_beyond";
+my $bb = hulls();
+
+compare_values('cube_vertices', $cdd->{cube_vertices}, $bb->{cube_vertices});
+compare_values('cube_f_vector', $cdd->{cube_f_vector}, $bb->{cube_f_vector});
+compare_values('cyclic_facets', $cdd->{cyclic_facets}, $bb->{cyclic_facets});
+compare_values('dual_vertices', $cdd->{dual_vertices}, $bb->{dual_vertices});
+compare_values('dual_n_facets', $cdd->{dual_n_facets}, $bb->{dual_n_facets});
+
+# Local Variables:
+# mode: perl
+# cperl-indent-level:3
+# indent-tabs-mode:nil
+# End:
@@ -0,0 +1,104 @@
+#  Copyright (c) 1997-2020
+#  Ewgenij Gawrilow, Michael Joswig, and the polymake team
+#  Technische Universität Berlin, Germany
+#  https://polymake.org
+#
+#  This program is free software; you can redistribute it and/or modify it
+#  under the terms of the GNU General Public License as published by the
+#  Free Software Foundation; either version 2, or (at your option) any
+#  later version: http://www.gnu.org/licenses/gpl.txt.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#-------------------------------------------------------------------------------
+
+# Large matrices are stored in a binary file next to the data file when saving with the option binary;
+# loading must restore them exactly and reject files written with a different memory layout.
+
+my $tmp = new Tempfile;
+my $file = "$tmp.poly";
+
+my $c = cube(3, 3, -2);
+$c->VERTICES;
+$c->VERTICES_IN_FACETS;
+save($c, $file, binary => 20);
+
+check_boolean('sidecar_written', -f "$file.bin");
+open my $json, "<", $file or die "can't read $file: $!\n";
+check_boolean('json_refers_to_sidecar', join("", <$json>) =~ /"_sidecar"/);
+close $json;
+
+my $p = load($file);
+compare_values('facets', $c->FACETS, $p->FACETS);
+compare_values('vertices', $c->VERTICES, $p->VERTICES);
+compare_values('vertices_in_facets', $c->VERTICES_IN_FACETS, $p->VERTICES_IN_FACETS);
+
+# overwrite a header field of the first record: the byte order mark follows the 8-byte magic, the limb size comes next
+sub patch_header {
+   my ($pos, $value) = @_;
+   open my $bin, "+<", "$file.bin" or die "can't modify $file.bin: $!\n";
+   binmode $bin;
+   seek $bin, $pos, 0;
+   print $bin pack("q", $value);
+   close $bin;
+}
+
+patch_header(8, 0x0807060504030201);
+eval { load($file) };
+check_boolean('reject_byte_order', $@ =~ /different byte order/);
+
+patch_header(8, 0x0102030405060708);
+patch_header(16, 16);
+eval { load($file) };
+check_boolean('reject_limb_size', $@ =~ /16-bit GMP limbs/);
+
+# Row-compressed records are checked before their entries are accessed.  The payload starts after the header
+# of 9 words with the row starts, followed by the column indices.
+my $inc_file = "$tmp.inc.bin";
+my $inc = new IncidenceMatrix([[0,2],[1]]);
+my $inc_offset = common::write_binary_data($inc, $inc_file);
+
+sub patch_incidence {
+   my ($word, $value) = @_;
+   open my $bin, "+<", $inc_file or die "can't modify $inc_file: $!
+";
+   binmode $bin;
+   seek $bin, $inc_offset + 8*(9+$word), 0;
+   print $bin pack("q", $value);
+   close $bin;
+   my $M = new IncidenceMatrix;
+   eval { common::read_binary_data($M, $inc_file, $inc_offset) };
+   $@
+}
+
+compare_values('incidence', $inc, do { my $M = new IncidenceMatrix; common::read_binary_data($M, $inc_file, $inc_offset); $M });
+# row starts 0 2 3, column indices 0 2 1
+check_boolean('reject_column_out_of_range', patch_incidence(4, 3) =~ /corrupted column indices/);
+check_boolean('reject_column_negative', patch_incidence(4, -1) =~ /corrupted column indices/);
+check_boolean('reject_columns_descending', patch_incidence(4, 0) =~ /corrupted column indices/);
+patch_incidence(4, 2);
+check_boolean('reject_row_starts_descending', patch_incidence(1, 4) =~ /corrupted row starts/);
+patch_incidence(1, 2);
+check_boolean('reject_row_starts_beyond_entries', patch_incidence(2, 5) =~ /corrupted row starts/);
+check_boolean('restored', patch_incidence(2, 3) eq "");
+
+my $sparse_file = "$tmp.sparse.bin";
+my $sparse = new SparseMatrix<Rational>([[0,1/2,0],[3,0,0]]);
+common::write_binary_data($sparse, $sparse_file);
+open my $bin, "+<", $sparse_file or die "can't modify $sparse_file: $!
+";
+binmode $bin;
+# row starts 0 1 2, column indices 1 0
+seek $bin, 8*(9+4), 0;
+print $bin pack("q", 7);
+close $bin;
+eval { my $M = new SparseMatrix<Rational>; common::read_binary_data($M, $sparse_file, 0) };
+check_boolean('reject_sparse_column_out_of_range', $@ =~ /corrupted column indices/);
+
+# Local Variables:
+# mode: perl
+# cperl-indent-level:3
+# indent-tabs-mode:nil
+# End:
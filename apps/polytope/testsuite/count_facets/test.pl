@@ -0,0 +1,47 @@
+#  Copyright (c) 1997-2020
+#  Ewgenij Gawrilow, Michael Joswig, and the polymake team
+#  Technische Universität Berlin, Germany
+#  https://polymake.org
+#
+#  This program is free software; you can redistribute it and/or modify it
+#  under the terms of the GNU General Public License as published by the
+#  Free Software Foundation; either version 2, or (at your option) any
+#  later version: http://www.gnu.org/licenses/gpl.txt.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#-------------------------------------------------------------------------------
+
+# The facets and vertices are counted as the convex hull solver passes them on, without being stored.
+
+compare_values('cube_facets', 6, count_facets(cube(3)));
+compare_values('cube_vertices', 8, count_vertices(cube(3)));
+compare_values('cross_facets', 16, count_facets(cross(4)));
+compare_values('cross_vertices', 8, count_vertices(cross(4)));
+
+# the vertices of the 3-cube together with its center and the midpoint of an edge
+my $points = [ (map { [1, map { $_ ? 1 : -1 } @$_] } [0,0,0],[0,0,1],[0,1,0],[0,1,1],[1,0,0],[1,0,1],[1,1,0],[1,1,1]),
+               [1,0,0,0], [1,1,1,0] ];
+compare_values('redundant_points', 6, count_facets(new Polytope<Rational>(POINTS=>$points)));
+
+# the positive quadrant: one vertex and two rays
+my $quadrant = new Polytope<Rational>(INEQUALITIES=>[[1,0,0],[0,1,0],[0,0,1]]);
+compare_values('unbounded_vertices', 3, count_vertices($quadrant));
+
+compare_values('infeasible', 0, count_vertices(new Polytope<Rational>(INEQUALITIES=>[[-1,1],[-1,-1]])));
+
+my $cone = new Cone<Rational>(INPUT_RAYS=>[[1,0,0],[0,1,0],[0,0,1],[1,1,1]]);
+compare_values('cone_facets', 3, count_facets($cone));
+compare_values('cone_rays', 3, count_vertices(new Cone<Rational>(INEQUALITIES=>[[1,0,0],[0,1,0],[0,0,1]])));
+
+# a half-space: one ray besides the lineality space
+my $halfspace = new Cone<Rational>(INEQUALITIES=>[[1,0,0]]);
+compare_values('halfspace_rays', $halfspace->N_RAYS, count_vertices(new Cone<Rational>(INEQUALITIES=>[[1,0,0]])));
+
+# Local Variables:
+# mode: perl
+# cperl-indent-level:3
+# indent-tabs-mode:nil
+# End:
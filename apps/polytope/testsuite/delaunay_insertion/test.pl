@@ -0,0 +1,52 @@
+#  Copyright (c) 1997-2020
+#  Ewgenij Gawrilow, Michael Joswig, and the polymake team
+#  Technische Universität Berlin, Germany
+#  https://polymake.org
+#
+#  This program is free software; you can redistribute it and/or modify it
+#  under the terms of the GNU General Public License as published by the
+#  Free Software Foundation; either version 2, or (at your option) any
+#  later version: http://www.gnu.org/licenses/gpl.txt.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#-------------------------------------------------------------------------------
+
+# The Delaunay subdivision is updated by inserting new sites, only the cells in the conflict region change.
+# The result must agree with the subdivision computed from scratch.
+
+my $S = new Matrix<Rational>([[1,0,0],[1,6,0],[1,0,6],[1,5,5]]);
+
+my ($removed, $added, $cells, $voronoi) = delaunay_insertion($S, new Matrix<Rational>([[1,2,2]]));
+compare_values('removed', new Set<Set<Int>>([[0,2,3],[0,1,3]]), new Set<Set<Int>>($removed));
+compare_values('added', new Set<Set<Int>>([[1,3,4],[2,3,4],[0,2,4],[0,1,4]]), new Set<Set<Int>>($added));
+compare_values('cells', new Set<Set<Int>>($added), new Set<Set<Int>>($cells));
+compare_values('voronoi', new Matrix<Rational>([[1,"14/3","7/3"],[1,"7/3","14/3"],[1,-1,3],[1,3,-1]]), $voronoi);
+
+# one site outside the convex hull, one inside
+my $N = new Matrix<Rational>([[1,9,9],[1,3,1]]);
+($removed, $added, $cells, $voronoi) = delaunay_insertion($S, $N);
+compare_values('removed2', new Set<Set<Int>>([[0,2,3],[0,1,3]]), new Set<Set<Int>>($removed));
+compare_values('cells2', new Set<Set<Int>>([[0,1,5],[0,2,5],[1,3,4],[1,3,5],[2,3,4],[2,3,5]]), new Set<Set<Int>>($cells));
+
+my $VD = new VoronoiPolyhedron(SITES=>($S/$N));
+compare_values('cells2_from_scratch', new Set<Set<Int>>($VD->DELAUNAY_TRIANGULATION), new Set<Set<Int>>($cells));
+
+# the circumcenters are equidistant from the sites of their cells
+my $equidistant = 1;
+for my $i (0..$cells->size-1) {
+   my @d = map { my $v = ($S/$N)->row($_) - $voronoi->row($i); $v*$v } @{$cells->[$i]};
+   $equidistant &&= !grep { $_ != $d[0] } @d;
+}
+check_boolean('circumcenters', $equidistant);
+
+eval { delaunay_insertion(new Matrix<Rational>([[1,0,0],[1,4,0],[1,0,4],[1,4,4]]), new Matrix<Rational>([[1,2,2]])) };
+check_boolean('cocircular', $@ =~ /sites lie on a common sphere or hyperplane/);
+
+# Local Variables:
+# mode: perl
+# cperl-indent-level:3
+# indent-tabs-mode:nil
+# End:
@@ -0,0 +1,43 @@
+#  Copyright (c) 1997-2020
+#  Ewgenij Gawrilow, Michael Joswig, and the polymake team
+#  Technische Universität Berlin, Germany
+#  https://polymake.org
+#
+#  This program is free software; you can redistribute it and/or modify it
+#  under the terms of the GNU General Public License as published by the
+#  Free Software Foundation; either version 2, or (at your option) any
+#  later version: http://www.gnu.org/licenses/gpl.txt.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#-------------------------------------------------------------------------------
+
+# Vertex and facet graphs from incidence matrices; dense matrices are processed as bit sets,
+# sparse ones as sets of indices.
+
+# the 3-cube, its vertices numbered by the binary representation of their coordinates
+my $cube_vif = new IncidenceMatrix([[0,2,4,6],[1,3,5,7],[0,1,4,5],[2,3,6,7],[0,1,2,3],[4,5,6,7]]);
+compare_values('cube_graph', new props::Graph<Undirected>([[1,2,4],[0,3,5],[0,3,6],[1,2,7],[0,5,6],[1,4,7],[2,4,7],[3,5,6]]),
+               graph_from_incidence($cube_vif));
+compare_values('cube_dual_graph', new props::Graph<Undirected>([[2,3,4,5],[2,3,4,5],[0,1,4,5],[0,1,4,5],[0,1,2,3],[0,1,2,3]]),
+               dual_graph_from_incidence($cube_vif));
+
+# polygons: with 8 vertices the incidence matrix counts as dense, with 130 vertices as sparse
+foreach my $n (8, 130) {
+   my $vif = new IncidenceMatrix([ map { [$_, ($_+1) % $n] } 0..$n-1 ]);
+   my $cycle = new props::Graph<Undirected>([ map { [($_+$n-1) % $n, ($_+1) % $n] } 0..$n-1 ]);
+   compare_values("polygon_${n}_graph", $cycle, graph_from_incidence($vif));
+   compare_values("polygon_${n}_dual_graph", $cycle, dual_graph_from_incidence($vif));
+}
+
+# face lattices, whose closures are computed on the dense incidence matrices
+compare_values('hasse_cube', 28, cube(3)->HASSE_DIAGRAM->N_NODES);
+compare_values('hasse_cross', 82, cross(4)->HASSE_DIAGRAM->N_NODES);
+
+# Local Variables:
+# mode: perl
+# cperl-indent-level:3
+# indent-tabs-mode:nil
+# End:
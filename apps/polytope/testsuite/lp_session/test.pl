@@ -0,0 +1,48 @@
+#  Copyright (c) 1997-2020
+#  Ewgenij Gawrilow, Michael Joswig, and the polymake team
+#  Technische Universität Berlin, Germany
+#  https://polymake.org
+#
+#  This program is free software; you can redistribute it and/or modify it
+#  under the terms of the GNU General Public License as published by the
+#  Free Software Foundation; either version 2, or (at your option) any
+#  later version: http://www.gnu.org/licenses/gpl.txt.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#-------------------------------------------------------------------------------
+
+# Sequences of LPs sharing the constraints are solved in one session, changing only the objective
+# or switching single inequalities off, and warm-started from the previous basis.
+
+# bounding box LPs along all coordinate directions
+my $quadrangle = new Polytope<Rational>(VERTICES=>[[1, new Rational(13,10), new Rational(1,2)], [1, new Rational(1,5), new Rational(6,5)],
+                                                   [1, new Rational(1,10), new Rational(-3,2)], [1, new Rational(-7,5), new Rational(1,5)]]);
+compare_values('bbox_quadrangle', new Matrix<Integer>([[1,0,-1],[1,-1,0],[1,0,0],[1,1,0],[1,0,1]]), integer_points_bbox($quadrangle));
+
+my $triangle = new Polytope<Rational>(INEQUALITIES=>[[new Rational(5,2),-1,0], [new Rational(5,2),0,-1], [new Rational(1,3),1,1]]);
+compare_values('bbox_triangle', new Matrix<Integer>([[1,2,-2],[1,1,-1],[1,2,-1],[1,0,0],[1,1,0],[1,2,0],[1,-1,1],[1,0,1],[1,1,1],[1,2,1],
+                                                     [1,-2,2],[1,-1,2],[1,0,2],[1,1,2],[1,2,2]]),
+               integer_points_bbox($triangle));
+
+my $simplex = new Polytope<Rational>(INEQUALITIES=>[[0,1,0,0],[0,0,1,0],[0,0,0,1]], EQUATIONS=>[[-2,1,1,1]]);
+compare_values('bbox_with_equation', new Matrix<Integer>([[1,2,0,0],[1,1,1,0],[1,0,2,0],[1,1,0,1],[1,0,1,1],[1,0,0,2]]),
+               integer_points_bbox($simplex));
+
+# implicit equations among inequalities, each detected by an LP with this inequality switched off
+compare_values('lineality_strip', new Matrix<Rational>([[0,1,0]]),
+               lineality_via_lp<Rational>(new Matrix<Rational>([[0,1,0],[0,-1,0],[1,0,1]]), new Matrix<Rational>(0,3)));
+compare_values('lineality_with_equation', new Matrix<Rational>([[0,0,0,1],[0,1,0,0],[0,0,1,0]]),
+               lineality_via_lp<Rational>(new Matrix<Rational>([[0,1,0,0],[0,0,1,0],[0,-1,-1,0]]), new Matrix<Rational>([[0,0,0,1]])));
+compare_values('lineality_rays', new Matrix<Rational>([[1,0,0],[0,1,1]]),
+               lineality_via_lp<Rational>(new Matrix<Rational>([[1,0,0],[-1,0,0],[0,1,0],[0,1,1],[0,-1,-1]]), new Matrix<Rational>(0,3)));
+compare_values('no_lineality', new Matrix<Rational>(0,3),
+               lineality_via_lp<Rational>(new Matrix<Rational>([[1,0,0],[0,1,0],[0,0,1]]), new Matrix<Rational>(0,3)));
+
+# Local Variables:
+# mode: perl
+# cperl-indent-level:3
+# indent-tabs-mode:nil
+# End:
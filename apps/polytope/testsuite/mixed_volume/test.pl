@@ -0,0 +1,45 @@
+#  Copyright (c) 1997-2020
+#  Ewgenij Gawrilow, Michael Joswig, and the polymake team
+#  Technische Universität Berlin, Germany
+#  https://polymake.org
+#
+#  This program is free software; you can redistribute it and/or modify it
+#  under the terms of the GNU General Public License as published by the
+#  Free Software Foundation; either version 2, or (at your option) any
+#  later version: http://www.gnu.org/licenses/gpl.txt.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#-------------------------------------------------------------------------------
+
+# Mixed volumes, normalized such that the mixed volume of n copies of an n-dimensional polytope
+# is n! times its volume.  The result must not depend on the number of threads.
+
+compare_values('cube_simplex', 4, mixed_volume(cube(2), simplex(2)));
+compare_values('cube3', 48, mixed_volume(cube(3), cube(3), cube(3)));
+compare_values('simplex3', 1, mixed_volume(simplex(3), simplex(3), simplex(3)));
+
+# Bezout: the number of solutions of two generic equations of degrees 2 and 3
+compare_values('bezout', 6, mixed_volume(simplex(2,2), simplex(2,3)));
+
+# inclusion-exclusion over the Minkowski sums of all subsets of the summands
+my @P = (cube(3), simplex(3), cross(3));
+my $incl_excl = 0;
+for my $subset (1..7) {
+   my @S = map { $P[$_] } grep { $subset & (1 << $_) } 0..2;
+   my $sign = (-1)**(3-@S);
+   my $sum = shift @S;
+   $sum = minkowski_sum($sum, $_) for @S;
+   $incl_excl += $sign * $sum->VOLUME;
+}
+compare_values('cube_simplex_cross', 18, $incl_excl);
+compare_values('cube_simplex_cross_1thread', 18, mixed_volume(@P, threads=>1));
+compare_values('cube_simplex_cross_4threads', 18, mixed_volume(@P, threads=>4));
+
+# Local Variables:
+# mode: perl
+# cperl-indent-level:3
+# indent-tabs-mode:nil
+# End:
@@ -0,0 +1,48 @@
+#  Copyright (c) 1997-2020
+#  Ewgenij Gawrilow, Michael Joswig, and the polymake team
+#  Technische Universität Berlin, Germany
+#  https://polymake.org
+#
+#  This program is free software; you can redistribute it and/or modify it
+#  under the terms of the GNU General Public License as published by the
+#  Free Software Foundation; either version 2, or (at your option) any
+#  later version: http://www.gnu.org/licenses/gpl.txt.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#-------------------------------------------------------------------------------
+
+# Numbers of fine triangulations of planar point configurations:
+# convex polygons have Catalan many, the 3x3 and 4x4 grids 64 and 46456.
+# The result must not depend on the optimization or the number of threads.
+
+sub grid {
+   my ($k) = @_;
+   return new Matrix<Rational>([ map { my $i = $_; map { [1, $i, $_] } 0..$k-1 } 0..$k-1 ]);
+}
+my $hexagon = new Matrix<Rational>([ map { [1, $_, $_*$_] } 0..5 ]);
+my $nonagon = new Matrix<Rational>([ map { [1, $_, $_*$_] } 0..8 ]);
+
+compare_values('square', 2, n_fine_triangulations(cube(2)->VERTICES));
+compare_values('hexagon', 14, n_fine_triangulations($hexagon));
+compare_values('nonagon', 429, n_fine_triangulations($nonagon));
+compare_values('nonagon_noopt', 429, n_fine_triangulations($nonagon, optimization=>0));
+
+# an interior point must be used by every fine triangulation
+compare_values('square_center', 1, n_fine_triangulations(new Matrix<Rational>([[1,0,0],[1,2,0],[1,0,2],[1,2,2],[1,1,1]])));
+
+compare_values('grid3', 64, n_fine_triangulations(grid(3)));
+compare_values('grid3_noopt', 64, n_fine_triangulations(grid(3), optimization=>0));
+compare_values('grid4_1thread', 46456, n_fine_triangulations(grid(4), threads=>1));
+compare_values('grid4_4threads', 46456, n_fine_triangulations(grid(4), threads=>4));
+
+eval { n_fine_triangulations(cube(3)->VERTICES) };
+check_boolean('not_planar', $@ =~ /planar point configurations only/);
+
+# Local Variables:
+# mode: perl
+# cperl-indent-level:3
+# indent-tabs-mode:nil
+# End:
@@ -0,0 +1,37 @@
+#  Copyright (c) 1997-2020
+#  Ewgenij Gawrilow, Michael Joswig, and the polymake team
+#  Technische Universität Berlin, Germany
+#  https://polymake.org
+#
+#  This program is free software; you can redistribute it and/or modify it
+#  under the terms of the GNU General Public License as published by the
+#  Free Software Foundation; either version 2, or (at your option) any
+#  later version: http://www.gnu.org/licenses/gpl.txt.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#-------------------------------------------------------------------------------
+
+# The beneath-beyond algorithm keeps the visited facets in small bit sets,
+# which move to the heap when there are more than 256 facets.
+
+my $cube = new Matrix<Rational>([ map { my $i = $_; [1, map { ($i >> $_) & 1 ? 1 : -1 } 0..2] } 0..7 ]);
+compare_values('cube', new Array<Set<Int>>([[0,1,2,4],[1,2,3,4],[1,3,4,5],[2,3,4,6],[3,4,5,6],[3,5,6,7]]),
+               placing_triangulation($cube));
+
+# the 4-dimensional cross polytope with its center as the last point
+my $cross = new Matrix<Rational>([ (map { my $i = $_; [1, map { $_ == int($i/2) ? ($i % 2 ? -1 : 1) : 0 } 0..3] } 0..7), [1,0,0,0,0] ]);
+compare_values('cross_with_center', new Array<Set<Int>>([[0,1,2,4,6],[0,1,3,4,6],[0,1,3,5,6],[0,1,2,5,6],[0,1,2,5,7],[0,1,3,5,7],[0,1,3,4,7],[0,1,2,4,7]]),
+               placing_triangulation($cross));
+
+# 300 points on a parabola are triangulated as a fan around the first one
+my $parabola = new Matrix<Rational>([ map { [1, $_, $_*$_] } 0..299 ]);
+compare_values('parabola', new Array<Set<Int>>([ map { [0, $_, $_+1] } 1..298 ]), placing_triangulation($parabola));
+
+# Local Variables:
+# mode: perl
+# cperl-indent-level:3
+# indent-tabs-mode:nil
+# End:
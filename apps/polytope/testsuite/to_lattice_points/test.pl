@@ -0,0 +1,37 @@
+#  Copyright (c) 1997-2020
+#  Ewgenij Gawrilow, Michael Joswig, and the polymake team
+#  Technische Universität Berlin, Germany
+#  https://polymake.org
+#
+#  This program is free software; you can redistribute it and/or modify it
+#  under the terms of the GNU General Public License as published by the
+#  Free Software Foundation; either version 2, or (at your option) any
+#  later version: http://www.gnu.org/licenses/gpl.txt.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#-------------------------------------------------------------------------------
+
+# The branch-and-bound of TOExMipSol explores the search tree in parallel threads.
+# The lattice points are sorted lexicographically, so the result does not depend on the number of threads.
+
+my $square = new Matrix<Integer>([ map { my $x = $_; map { [1, $x, $_] } -1..1 } -1..1 ]);
+compare_values('square', $square, to_lattice_points(cube(2), threads=>1));
+compare_values('square_2', $square, to_lattice_points(cube(2), threads=>2));
+
+my $simplex = new Matrix<Integer>([ map { my $x = $_; map { my $y = $_; map { [1, $x, $y, $_] } 0..4-$x-$y } 0..4-$x } 0..4 ]);
+compare_values('simplex', $simplex, to_lattice_points(simplex(3, 4), threads=>1));
+compare_values('simplex_2', $simplex, to_lattice_points(simplex(3, 4), threads=>2));
+
+# lattice points in the interior of a cross polytope with non-integral vertices
+my $cross = cross(3, new Rational(5,2));
+compare_values('cross_2', to_lattice_points($cross, threads=>1), to_lattice_points($cross, threads=>2));
+check_boolean('cross_n_points', to_lattice_points($cross, threads=>2)->rows == 25);
+
+# Local Variables:
+# mode: perl
+# cperl-indent-level:3
+# indent-tabs-mode:nil
+# End:
@@ -0,0 +1,66 @@
+#  Copyright (c) 1997-2020
+#  Ewgenij Gawrilow, Michael Joswig, and the polymake team
+#  Technische Universität Berlin, Germany
+#  https://polymake.org
+#
+#  This program is free software; you can redistribute it and/or modify it
+#  under the terms of the GNU General Public License as published by the
+#  Free Software Foundation; either version 2, or (at your option) any
+#  later version: http://www.gnu.org/licenses/gpl.txt.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#-------------------------------------------------------------------------------
+
+# Rational LPs are solved by TOSimplex starting from a double precision basis by default;
+# the optima must be exact, even where double precision cannot tell the vertices apart.
+
+sub solve {
+   my ($p, $lp) = @_;
+   $p->LP = $lp;
+   [ $p->LP->MAXIMAL_VALUE, $p->LP->MAXIMAL_VERTEX, $p->LP->MINIMAL_VALUE, $p->LP->MINIMAL_VERTEX ]
+}
+
+sub compare_lp {
+   my ($id, $expected, $computed) = @_;
+   compare_values("${id}_max_value", $expected->[0], $computed->[0]);
+   compare_values("${id}_max_vertex", $expected->[1], $computed->[1]);
+   compare_values("${id}_min_value", $expected->[2], $computed->[2]);
+   compare_values("${id}_min_vertex", $expected->[3], $computed->[3]);
+}
+
+my $cube = [[1,1,0,0],[1,-1,0,0],[1,0,1,0],[1,0,-1,0],[1,0,0,1],[1,0,0,-1]];
+
+compare_lp('cube', [ 6, new Vector<Rational>([1,1,-1,1]), -6, new Vector<Rational>([1,-1,1,-1]) ],
+           solve(new Polytope<Rational>(INEQUALITIES=>$cube), new LinearProgram<Rational>(LINEAR_OBJECTIVE=>[0,1,-2,3])));
+
+# the objective values at the vertices (1,0) and (0,1) differ by 10^-20
+my $eps = new Rational(1, new Integer("100000000000000000000"));
+compare_lp('triangle', [ 1+$eps, new Vector<Rational>([1,0,1]), 0, new Vector<Rational>([1,0,0]) ],
+           solve(new Polytope<Rational>(INEQUALITIES=>[[0,1,0],[0,0,1],[1,-1,-1]]),
+                 new LinearProgram<Rational>(LINEAR_OBJECTIVE=>new Vector<Rational>([0, 1, 1+$eps]))));
+
+# the objective values at the vertices (3,1) and (2,2) differ by 10^-9
+compare_lp('hexagon', [ new Rational(4000000003,1000000000), new Vector<Rational>([1,3,1]),
+                        new Rational(-4000000003,1000000000), new Vector<Rational>([1,-3,-1]) ],
+           solve(new Polytope<Rational>(INEQUALITIES=>[[3,-1,0],[3,1,0],[2,0,-1],[2,0,1],[4,-1,-1],[4,1,1]]),
+                 new LinearProgram<Rational>(LINEAR_OBJECTIVE=>new Vector<Rational>([0, new Rational(1000000001,1000000000), 1]))));
+
+# other coordinate types keep their preferred solvers
+compare_lp('cube_float', [ 6, new Vector<Float>([1,1,-1,1]), -6, new Vector<Float>([1,-1,1,-1]) ],
+           solve(new Polytope<Float>(INEQUALITIES=>$cube), new LinearProgram<Float>(LINEAR_OBJECTIVE=>[0,1,-2,3])));
+
+# C++ clients call solve_LP directly; they must get the exact answers as well
+my $square = cube(2);
+check_boolean('separable_outside', separable($square, new Vector<Rational>([1, 1+$eps, 0])));
+check_boolean('separable_boundary', !separable($square, new Vector<Rational>([1, 1, 0])));
+check_boolean('separable_inside', !separable($square, new Vector<Rational>([1, 1-$eps, 0])));
+check_boolean('weakly_separable_boundary', separable($square, new Vector<Rational>([1, 1, 0]), strong=>0));
+
+# Local Variables:
+# mode: perl
+# cperl-indent-level:3
+# indent-tabs-mode:nil
+# End:
@@ -145,6 +145,18 @@ public:
     return c;
   }
 
+  Chain cobd(Int i) const
+  {
+    Cell cell = C[i];
+    Int d = cell.dim;
+    Chain c(C.size());
+    if (d==dim()) return c; //top-dimensional cells have empty coboundary
+    for (auto e = entire(bd_matrix[d+1].col(cell.idx)); !e.at_end(); ++e) {
+      c[ind[d+1][e.index()]] = *e;
+    }
+    return c;
+  }
+
   // sort cells by degree first and dimension second, as required by persistent homology algo.
 private:
   struct cellComparator {
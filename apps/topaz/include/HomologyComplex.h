@@ -23,6 +23,7 @@
 #include "polymake/Set.h"
 #include "polymake/Smith_normal_form.h"
 #include "polymake/GenericStruct.h"
+#include "polymake/parallel.h"
 #include "polymake/topaz/SimplicialComplex_as_FaceMap.h"
 #if POLYMAKE_DEBUG
 #  include "polymake/client.h"
@@ -385,6 +386,11 @@ public:
    typedef HomologyGroup<R> homology_type;
    typedef CycleGroup<R> cycle_type;
 
+   // all (co-)homology groups without cycles, indexed by dimension-dim_low;
+   // the boundary matrices are prepared in sequence as in Complex_iterator,
+   // then their Smith normal forms are computed in parallel
+   Array<homology_type> compute_homologies(bool dual) const;
+
    template <bool with_cycles, bool dual> class as_container;
 
    friend const as_container<false,false>& homologies(const HomologyComplex& cc)
@@ -408,6 +414,66 @@ public:
    }
 };
 
+template <typename R, typename MatrixType, typename BaseComplex>
+Array<HomologyGroup<R>> HomologyComplex<R,MatrixType,BaseComplex>::compute_homologies(bool dual) const
+{
+   // one boundary matrix more than homology groups, in the order Complex_iterator visits them
+   const Int n = size()+1;
+   std::vector<Int> rank(n, 0), n_rows(n);
+   std::vector<typename homology_type::torsion_list> torsion(n);
+
+   // The elimination of unit entries in one matrix cancels rows and columns in the neighboring ones,
+   // hence it must run sequentially; boundary_matrix() may complete the face lattice, which is not thread-safe either.
+   // A matrix is final as soon as its successor is eliminated.  The Smith normal forms of the final matrices are
+   // computed in parallel in batches of one matrix per thread, then the matrices are released.
+   const parallel::ThreadLimit threads;
+   const Int batch_size = parallel::max_threads();
+   std::vector<typename MatrixType::persistent_type> batch;
+   std::vector<Int> batch_index;
+   typename MatrixType::persistent_type delta, prev_delta;
+   Bitset elim_rows, elim_cols;
+   for (Int i = 0; i <= n; ++i) {
+      if (i < n) {
+         const Int d = dual ? dim_low+i : dim_high+1-i;
+         if (dual)
+            delta = T(complex.template boundary_matrix<R>(d));
+         else
+            delta = complex.template boundary_matrix<R>(d);
+         if (i > 0) delta.minor(elim_cols, All).clear();
+
+         //elim_ones optimization only works for matrices with entries from {0,+1,-1}
+         if (pm::is_derived_from_instance_of<BaseComplex,SimplicialComplex_as_FaceMap>::value)
+            rank[i] = eliminate_ones(delta, elim_rows, elim_cols, nothing_logger());
+
+         if (i > 0) prev_delta.minor(All, elim_rows).clear();
+      }
+      if (i > 0) {
+         n_rows[i-1] = prev_delta.rows();
+         batch.push_back(std::move(prev_delta));
+         batch_index.push_back(i-1);
+      }
+      prev_delta = std::move(delta);
+
+      if (Int(batch.size()) == batch_size || (i == n && !batch.empty())) {
+         parallel::for_each(sequence(0, batch.size()), [&](Int b) {
+            const Int k = batch_index[b];
+            rank[k] += smith_normal_form(batch[b], torsion[k], nothing_logger(), std::false_type());
+         });
+         batch.clear();
+         batch_index.clear();
+      }
+   }
+
+   Array<homology_type> H(n-1);
+   for (Int i = 1; i < n; ++i) {
+      homology_type& h = H[dual ? i-1 : n-1-i];
+      h.torsion = std::move(torsion[i-1]);
+      pm::compress_torsion(h.torsion);
+      h.betti_number = n_rows[i] - rank[i] - rank[i-1];
+   }
+   return H;
+}
+
 template <typename R, typename MatrixType, typename BaseComplex>
 template <bool with_cycles, bool dual>
 class HomologyComplex<R,MatrixType,BaseComplex>::as_container : public HomologyComplex<R,MatrixType,BaseComplex> {
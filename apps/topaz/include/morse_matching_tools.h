@@ -27,6 +27,7 @@
 #include "polymake/Array.h"
 #include "polymake/Map.h"
 #include "polymake/PowerSet.h"
+#include "polymake/SmallBitset.h"
 #include "polymake/graph/ShrinkingLattice.h"
 #include "polymake/graph/Decoration.h"
 #include "polymake/vector"
@@ -71,7 +72,7 @@ bool checkAcyclicDFS(const graph::ShrinkingLattice<graph::lattice::BasicDecorati
  *
  * On output an element (node) is set to true in the bitset if and only if the face is critical.
  */
-Bitset collectCriticalFaces(const graph::ShrinkingLattice<graph::lattice::BasicDecoration>& M, const MorseEdgeMap& EM);
+SmallBitset<> collectCriticalFaces(const graph::ShrinkingLattice<graph::lattice::BasicDecoration>& M, const MorseEdgeMap& EM);
 
 
 /**@brief Compute the size of an EdgeMap
@@ -0,0 +1,237 @@
+/* Copyright (c) 1997-2020
+   Ewgenij Gawrilow, Michael Joswig, and the polymake team
+   Technische Universität Berlin, Germany
+   https://polymake.org
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version: http://www.gnu.org/licenses/gpl.txt.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+--------------------------------------------------------------------------------
+*/
+
+#ifndef POLYMAKE_TOPAZ_PERSISTENT_HOMOLOGY_H
+#define POLYMAKE_TOPAZ_PERSISTENT_HOMOLOGY_H
+
+#include "polymake/Array.h"
+#include "polymake/Matrix.h"
+#include "polymake/SparseVector.h"
+#include "polymake/hash_map"
+#include "polymake/list"
+#include "polymake/topaz/Filtration.h"
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+namespace polymake { namespace topaz {
+
+/// Persistence barcodes of a filtered complex over a field, computed by column reduction with clearing.
+/// The complex is accessed through n_cells(), dim(), operator[] returning the Cell, and the chains bd(i) and cobd(i),
+/// where cells are numbered in filtration order; Filtration and VietorisRipsFiltration provide these.
+/// If dual is set, the coboundary matrix is reduced instead (persistent cohomology), yielding the same intervals.
+template <typename Coeff, typename FilteredComplex>
+Array<std::list<std::pair<Int, Int>>> persistence_intervals(const FilteredComplex& F, bool dual = false)
+{
+  using Chain = SparseVector<Coeff>;
+  const Int n = F.n_cells();
+  const Int dim = F.dim();
+
+  std::vector<std::vector<Int>> cells_of_dim(dim+1);
+  for (Int i = 0; i < n; ++i)
+    cells_of_dim[F[i].dim].push_back(i);
+
+  // the cell paired with each cell, -1 for unpaired cells
+  std::vector<Int> partner(n, -1);
+  // reduced columns by pivot, with pivot entry 1
+  hash_map<Int, Chain> reduced;
+
+  // reduce column j; a pivot of the result is a cell whose own column vanishes and need not be reduced (clearing)
+  auto reduce = [&](Int j, Chain c) {
+    while (!c.empty()) {
+      const Int i = dual ? c.begin().index() : indices(c).back();
+      const auto r = reduced.find(i);
+      if (r == reduced.end()) {
+        c *= inv(Coeff(c[i]));
+        reduced.emplace(i, std::move(c));
+        partner[i] = j;
+        partner[j] = i;
+        return;
+      }
+      const Coeff q = c[i];
+      c -= q * r->second;
+    }
+  };
+
+  if (!dual) {
+    // boundaries from the top dimension down, cells of dimension d are cleared by the pivots in dimension d+1
+    for (Int d = dim; d > 0; --d) {
+      for (const Int j : cells_of_dim[d])
+        if (partner[j] < 0) reduce(j, F.bd(j));
+      reduced.clear();
+    }
+  } else {
+    // coboundaries in reverse filtration order from the bottom dimension up
+    for (Int d = 0; d < dim; ++d) {
+      for (auto j = cells_of_dim[d].rbegin(); j != cells_of_dim[d].rend(); ++j)
+        if (partner[*j] < 0) reduce(*j, F.cobd(*j));
+      reduced.clear();
+    }
+  }
+
+  // intervals ordered by their death, as in the algorithm of Zomorodian and Carlsson, then the infinite ones
+  Array<std::list<std::pair<Int, Int>>> L(dim+1);
+  for (Int j = 0; j < n; ++j) {
+    const Int i = partner[j];
+    if (i >= 0 && i < j && F[i].deg < F[j].deg) //skip empty intervals
+      L[F[i].dim].emplace_back(F[i].deg, F[j].deg);
+  }
+  for (Int j = 0; j < n; ++j)
+    if (partner[j] < 0)
+      L[F[j].dim].emplace_back(F[j].deg, -1);
+
+  return L;
+}
+
+/// The k-skeleton of the Vietoris Rips filtration of a point set with the cells of vietoris_rips_filtration,
+/// but without boundary matrices: the boundaries and coboundaries are generated from the lexicographic index of a simplex.
+template <typename Coeff>
+class VietorisRipsFiltration {
+public:
+  using Chain = SparseVector<Coeff>;
+
+  VietorisRipsFiltration(const Matrix<double>& dist, const Array<Int>& point_degs, double step, Int k_in)
+    : n(dist.rows())
+    , k(std::min(k_in, n-1))
+    , binom(k+3, std::vector<Int>(n+1, 0))
+    , ind(k+1)
+  {
+    for (Int v = 0; v <= n; ++v) {
+      binom[0][v] = 1;
+      for (Int j = 1; j <= k+2 && j <= v; ++j)
+        binom[j][v] = binom[j-1][v-1] + binom[j][v-1];
+    }
+    Int size = 0;
+    for (Int d = 0; d <= k; ++d) {
+      ind[d].resize(binom[d+1][n]);
+      size += binom[d+1][n];
+    }
+    C.resize(size);
+
+    // depth-first enumeration of increasing vertex sequences visits the simplices of each dimension in lexicographic order;
+    // the degree of a simplex is the maximum over its vertices and edges
+    std::vector<Int> simplex, degs;
+    std::vector<Int> count(k+1, 0);
+    Int cell_index = 0;
+    simplex.push_back(-1);
+    while (!simplex.empty()) {
+      if (++simplex.back() == n) {
+        simplex.pop_back();
+        continue;
+      }
+      const Int d = simplex.size()-1, v = simplex.back();
+      Int deg = d == 0 ? point_degs[v] : std::max(degs[d-1], point_degs[v]);
+      for (Int i = 0; i < d; ++i)
+        assign_max(deg, Int(std::ceil(double(dist(simplex[i], v)) / step)));
+      degs.resize(d);
+      degs.push_back(deg);
+      C[cell_index++] = Cell(deg, d, count[d]++);
+      if (d < k) simplex.push_back(v);
+    }
+
+    std::sort(C.begin(), C.end(), [](const Cell& c1, const Cell& c2) {
+        return c1.deg != c2.deg ? c1.deg < c2.deg : c1.dim != c2.dim ? c1.dim < c2.dim : c1.idx < c2.idx;
+      });
+    for (auto c = entire<indexed>(C); !c.at_end(); ++c)
+      ind[c->dim][c->idx] = c.index();
+  }
+
+  Int n_cells() const { return C.size(); }
+  Int dim() const { return k; }
+  const Cell& operator[](Int i) const { return C[i]; }
+
+  // signs as in the boundary matrices of vietoris_rips_filtration: the face without the j-th vertex of a d-simplex gets (-1)^(d-j)
+  Chain bd(Int i) const
+  {
+    const Cell& cell = C[i];
+    const Int d = cell.dim;
+    Chain c(C.size());
+    if (d == 0) return c; //points have empty boundary
+    std::vector<Int> simplex = vertices(d, cell.idx), face(d);
+    for (Int j = 0; j <= d; ++j) {
+      std::copy(simplex.begin(), simplex.begin()+j, face.begin());
+      std::copy(simplex.begin()+j+1, simplex.end(), face.begin()+j);
+      c[ind[d-1][index_of(face)]] = (d-j)%2 ? -1 : 1;
+    }
+    return c;
+  }
+
+  Chain cobd(Int i) const
+  {
+    const Cell& cell = C[i];
+    const Int d = cell.dim;
+    Chain c(C.size());
+    if (d == k) return c; //top-dimensional cells have empty coboundary
+    const std::vector<Int> simplex = vertices(d, cell.idx);
+    std::vector<Int> coface(d+2);
+    Int j = 0;
+    for (Int v = 0; v < n; ++v) {
+      if (j <= d && simplex[j] == v) {
+        ++j;
+        continue;
+      }
+      std::copy(simplex.begin(), simplex.begin()+j, coface.begin());
+      coface[j] = v;
+      std::copy(simplex.begin()+j, simplex.end(), coface.begin()+j+1);
+      c[ind[d+1][index_of(coface)]] = (d+1-j)%2 ? -1 : 1;
+    }
+    return c;
+  }
+
+protected:
+  Int n, k;
+  // binom[j][v] = v choose j
+  std::vector<std::vector<Int>> binom;
+  Array<Cell> C;
+  // filtration index of each simplex by dimension and lexicographic index
+  Array<Array<Int>> ind;
+
+  // Reversing the vertex order turns the lexicographic order into the reverse colexicographic order,
+  // for which the index of {b_0 < ... < b_d} is the sum of (b_t choose t+1).
+  Int index_of(const std::vector<Int>& simplex) const
+  {
+    const Int m = simplex.size();
+    Int colex = 0;
+    for (Int i = 0; i < m; ++i)
+      colex += binom[m-i][n-1-simplex[i]];
+    return binom[m][n] - 1 - colex;
+  }
+
+  std::vector<Int> vertices(Int d, Int idx) const
+  {
+    const Int m = d+1;
+    std::vector<Int> simplex(m);
+    Int colex = binom[m][n] - 1 - idx;
+    for (Int t = m; t > 0; --t) {
+      // largest b with (b choose t) <= colex
+      const Int b = std::upper_bound(binom[t].begin(), binom[t].end(), colex) - binom[t].begin() - 1;
+      colex -= binom[t][b];
+      simplex[m-t] = n-1-b;
+    }
+    return simplex;
+  }
+};
+
+} }
+
+#endif // POLYMAKE_TOPAZ_PERSISTENT_HOMOLOGY_H
+
+// Local Variables:
+// mode:C++
+// c-basic-offset:2
+// indent-tabs-mode:nil
+// End:
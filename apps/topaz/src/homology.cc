@@ -31,12 +31,7 @@ namespace{
 template<typename Coeff, typename MatrixType, typename ComplexType>
 Array<HomologyGroup<Coeff>> compute_homology(const HomologyComplex<Coeff,MatrixType,ComplexType> & HC, bool co, Int dim_low, Int dim_high)
 {
-   Array<HomologyGroup<Coeff>> H(HC.size());
-   if (!co)
-      copy_range(entire(homologies(HC)), H.rbegin());
-   else
-      copy_range(entire(cohomologies(HC)), H.begin());
-   return H;
+   return HC.compute_homologies(co);
 }}
 
 //FIXME #975 other coefficient and matrix types would be nice
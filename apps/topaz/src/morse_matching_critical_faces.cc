@@ -86,7 +86,7 @@ void morse_matching_critical_faces (BigObject p)
    const graph::Lattice<graph::lattice::BasicDecoration> M(HD_obj);
    const Int d = M.rank()-2;
    const MorseEdgeMap EM = p.give("MORSE_MATCHING.MATCHING");
-   Bitset critical = collectCriticalFaces(M, EM);
+   SmallBitset<> critical = collectCriticalFaces(M, EM);
    Array<Int> numCritical(d+1);
    for (Int k = 0; k <= d; ++k) {
       for (const auto f : M.nodes_of_rank(k+1)) {
@@ -281,13 +281,13 @@ void remove_matching_from_1_skeleton(const graph::ShrinkingLattice<graph::lattic
          EM[*e] = false;
 }
 
-Bitset collectCriticalFaces(const graph::ShrinkingLattice<graph::lattice::BasicDecoration>& M, const MorseEdgeMap& EM)
+SmallBitset<> collectCriticalFaces(const graph::ShrinkingLattice<graph::lattice::BasicDecoration>& M, const MorseEdgeMap& EM)
 {
    const Int d = M.rank()-2;      // do not count empty face
    const Int n = M.nodes()-2;    // and top face
 
    // ensure space
-   Bitset critical(n+1);
+   SmallBitset<> critical(n+1);
 
    // loop over all levels
    for (Int k = 0; k <= d; ++k) {
@@ -323,7 +323,7 @@ void processAlternatingPaths(graph::ShrinkingLattice<graph::lattice::BasicDecora
    Int cnt = 0; // number of alternating paths
 
    // compute critical faces
-   Bitset critical = collectCriticalFaces(M, EM);
+   SmallBitset<> critical = collectCriticalFaces(M, EM);
 
    // find alternating paths
    Array<Int> marked(n+1);
@@ -428,7 +428,7 @@ void make_edges_in_Gamma(const graph::ShrinkingLattice<graph::lattice::BasicDeco
 void completeToBottomLevel(graph::ShrinkingLattice<graph::lattice::BasicDecoration>& M, MorseEdgeMap& EM)
 {
    // find critical faces of best_solution_
-   Bitset critical = collectCriticalFaces(M, EM);
+   SmallBitset<> critical = collectCriticalFaces(M, EM);
 #if POLYMAKE_DEBUG
    const bool debug_print = get_debug_level() > 1;
 
@@ -508,7 +508,7 @@ void completeToTopLevel(const graph::ShrinkingLattice<graph::lattice::BasicDecor
    const Int d = M.rank()-2;
 
    // find critical faces of best_solution_
-   Bitset critical = collectCriticalFaces(M, EM);
+   SmallBitset<> critical = collectCriticalFaces(M, EM);
    
    // build helper graph
    Graph<Directed> G;
@@ -82,7 +82,7 @@ multi_associahedron_sphere(Int n, Int k, OptionSet options)
    induced_action.take("GENERATORS") << igens;
    ind_Aut.take("PERMUTATION_ACTION") << induced_action;
       
-   hash_set<Set<Int>> lower_rep_level, k_plus_1_crossings;
+   flat_hash_set<Set<Int>> lower_rep_level, k_plus_1_crossings;
 
    if (!no_crossings || !no_facets) {
       // accumulate all k-cliques, to prepare for calculating the (k+1)-crossings and the f-vector
@@ -109,14 +109,14 @@ multi_associahedron_sphere(Int n, Int k, OptionSet options)
 
       // build up the face lattice in layers, starting from representatives of the k-cliques
       for (Int n_vertices = k+1; n_vertices <= dim+1; ++n_vertices) {
-         hash_set<Set<Int>> upper_rep_level;
+         flat_hash_set<Set<Int>> upper_rep_level;
          for (const auto& c : lower_rep_level)
             for (Int d_index = 0; d_index < m; ++d_index)
                if (!c.contains(d_index) && !contains_new_k_plus_1_crossing(d_index, k, c, diagonals))
                   upper_rep_level += group::unordered_orbit<group::on_container>(igens, Set<Int>(c+d_index));
 
          *fvec_it++ = upper_rep_level.size();
-         lower_rep_level = upper_rep_level;
+         lower_rep_level = std::move(upper_rep_level);
       }
    }
    
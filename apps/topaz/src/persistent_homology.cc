@@ -5,6 +5,7 @@
 #include "polymake/Smith_normal_form.h"
 #include "polymake/SparseVector.h"
 #include "polymake/topaz/Filtration.h"
+#include "polymake/topaz/persistent_homology.h"
 #include "polymake/integer_linalg.h"
 #include "polymake/list"
 #include "polymake/vector"
@@ -13,87 +14,11 @@
 
 namespace polymake{ namespace topaz{
 
-template <typename Matrix_type>
-class PersistentHomology {
-
-  using Coeff = typename Matrix_type::value_type;
-  using Chain = SparseVector<Coeff>;
-
-private:
-  const Filtration<Matrix_type>& F;
-  Int dim;
-  std::vector<bool> marked;
-  Array<std::pair<Int, Chain>> T;
-
-public:
-  PersistentHomology(const Filtration<Matrix_type>& F_in)
-    : F(F_in)
-    , dim(F.dim())
-    , marked(F.n_cells())
-    , T(F.n_cells())
-  {
-    // zero as first pair value means empty. that's ok, as the zeroth filtration entry is always a point and thus has empty bd and does not get an entry in T.
-  }
-
-  Chain remove_pivot_rows(Int j)
-  {
-    Chain d = F.bd(j);
-
-    for (auto m = entire<indexed>(d); !m.at_end(); ) {
-      if (!marked[m.index()]) d.erase(m++); //remove unmarked cells
-      else ++m;
-    }
-
-    while (!d.empty()) {
-      Int i = indices(d).back(); //maximal index
-      if (!T[i].first) break;
-      Chain t = T[i].second;
-      Coeff q = t[i];
-      Coeff qq = d[i];
-      d -= qq*(inv(q)*t); //TODO this differs from what's in the paper. they don't multiply with qq. why?
-    }
-    return d;
-  }
-
-public:
-  Array<std::list<std::pair<Int, Int>>> compute_intervals()
-  {
-    Array<std::list<std::pair<Int, Int>>> L(dim+1);
-
-    for (auto c = F.get_iter(); !c.at_end(); ++c) {
-      Int j = c.index();
-      Chain d = remove_pivot_rows(j);
-      if (d.empty()) {
-        marked[j] = true;
-      } else {
-        Int i = indices(d).back(); // maximal index
-        Int k = F[i].dim;
-        T[i].first = j;
-        T[i].second = d;
-        Int a = F[i].deg;
-        Int b = (*c).deg;
-        if (a < b) //skip empty intervals
-          L[k].emplace_back(a, b);
-      }
-    }
-
-    for (auto c = F.get_iter(); !c.at_end(); ++c) {
-      Int j = c.index();
-      if (marked[j] && !T[j].first) {
-        L[(*c).dim].emplace_back(c->deg, -1);
-      }
-    }
-
-    return L;
-  }
-};
-
 template<typename MatrixType>
 std::enable_if_t<pm::is_field<typename MatrixType::value_type>::value, Array<std::list<std::pair<Int, Int>>> > //for field coefficients
-persistent_homology(const Filtration<MatrixType>& F)
+persistent_homology(const Filtration<MatrixType>& F, bool dual)
 {
-  PersistentHomology<MatrixType> P(F);
-  return P.compute_intervals();
+  return persistence_intervals<typename MatrixType::value_type>(F, dual);
 }
 
 // using snf for nullspace and span computation for performance reasons
@@ -194,8 +119,10 @@ UserFunctionTemplate4perl("# @category Other"
                           "persistent_homology(Filtration,$$$)");
 
 UserFunctionTemplate4perl("# @category Other"
-                          "# Given a Filtration, this computes its persistence barcodes in all dimension, using the algorithm described in the 2005 paper 'Computing Persistent Homology' by Afra Zomorodian and Gunnar Carlsson. It only works for field coefficients."
+                          "# Given a Filtration, this computes its persistence barcodes in all dimension, using the algorithm described in the 2005 paper 'Computing Persistent Homology' by Afra Zomorodian and Gunnar Carlsson"
+                          "# with the clearing optimization of Chen and Kerber. It only works for field coefficients."
                           "# @param Filtration F"
+                          "# @param Bool dual reduce the coboundary matrices instead, i.e. compute persistent cohomology, which has the same barcodes and is often faster. Default is false."
                           "# @return Array<List<Pair<Int, Int>>>",
-                          "persistent_homology(Filtration)");
+                          "persistent_homology(Filtration; $=0)");
 } }
@@ -18,6 +18,7 @@
 #include "polymake/Graph.h"
 #include "polymake/PowerSet.h"
 #include "polymake/topaz/Filtration.h"
+#include "polymake/topaz/persistent_homology.h"
 #include "polymake/SparseMatrix.h"
 #include "polymake/Rational.h"
 
@@ -96,6 +97,14 @@ Filtration<SparseMatrix<Coeff>> vietoris_rips_filtration(const Matrix<double>& d
   return Filtration<SparseMatrix<Coeff> >(F,bd);
 }
 
+template <typename Coeff>
+std::enable_if_t<pm::is_field<Coeff>::value, Array<std::list<std::pair<Int, Int>>>>
+vietoris_rips_persistent_homology(const Matrix<double>& dist, const Array<Int>& point_degs, double step, Int k, bool dual)
+{
+  const VietorisRipsFiltration<Coeff> F(dist, point_degs, step, k);
+  return persistence_intervals<Coeff>(F, dual);
+}
+
 
 UserFunction4perl("# @category Producing a simplicial complex from other objects"
                   "# Computes the __Vietoris Rips complex__ of a point set. The set is passed as its so-called \"distance matrix\", whose (i,j)-entry is the distance between point i and j. This matrix can e.g. be computed using the distance_matrix function. The points corresponding to vertices of a common simplex will all have a distance less than //delta// from each other."
@@ -114,6 +123,18 @@ UserFunctionTemplate4perl("# @category Other"
                           "# @tparam Coeff desired coefficient type of the filtration"
                           "# @return Filtration<SparseMatrix<Coeff, NonSymmetric> >",
                           "vietoris_rips_filtration<Coeff>($$$$)");
+
+UserFunctionTemplate4perl("# @category Other"
+                          "# Computes the persistence barcodes of the k-skeleton of the Vietoris Rips filtration of a point set, as persistent_homology(vietoris_rips_filtration(D, deg, step_size, k)) does,"
+                          "# but without storing the boundary matrices of the filtration. These are generated from the cells while reducing."
+                          "# @param Matrix D the \"distance matrix\" of the point set (can be upper triangular)"
+                          "# @param Array<Int> deg the degrees of input points"
+                          "# @param Float step_size"
+                          "# @param Int k dimension of the filtration"
+                          "# @param Bool dual reduce the coboundary matrices, i.e. compute persistent cohomology. Default is true."
+                          "# @tparam Coeff coefficient field"
+                          "# @return Array<List<Pair<Int, Int>>>",
+                          "vietoris_rips_persistent_homology<Coeff>($$$$; $=1)");
 } }
 
 // Local Variables:
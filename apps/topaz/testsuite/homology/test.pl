@@ -0,0 +1,38 @@
+#  Copyright (c) 1997-2020
+#  Ewgenij Gawrilow, Michael Joswig, and the polymake team
+#  Technische Universität Berlin, Germany
+#  https://polymake.org
+#
+#  This program is free software; you can redistribute it and/or modify it
+#  under the terms of the GNU General Public License as published by the
+#  Free Software Foundation; either version 2, or (at your option) any
+#  later version: http://www.gnu.org/licenses/gpl.txt.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#-------------------------------------------------------------------------------
+
+# Homology groups are computed dimension-wise in parallel threads.  The tree nodes and GMP limbs of the
+# boundary matrices are allocated in the worker threads and partly released in other threads,
+# which exercises the per-thread block caches of pm::allocator.
+# Two threads are requested explicitly, independent of the number of processors of the test machine.
+
+local $common::max_threads = 2;
+
+sub groups {
+   new Array<HomologyGroup<Integer>>(@_)
+}
+
+compare_values('torus', groups([[],0], [[],2], [[],1]), homology(torus()->FACETS, 0));
+compare_values('rp2', groups([[],0], [[[2,1]],0], [[],0]), homology(real_projective_plane()->FACETS, 0));
+compare_values('rp2_co', groups([[],0], [[],0], [[[2,1]],0]), homology(real_projective_plane()->FACETS, 1));
+compare_values('klein_bottle', groups([[],0], [[[2,1]],1], [[],0]), homology(klein_bottle()->FACETS, 0));
+compare_values('cp2', groups([[],0], [[],0], [[],1], [[],0], [[],1]), homology(complex_projective_plane()->FACETS, 0));
+
+# Local Variables:
+# mode: perl
+# cperl-indent-level:3
+# indent-tabs-mode:nil
+# End:
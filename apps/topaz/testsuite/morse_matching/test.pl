@@ -0,0 +1,42 @@
+#  Copyright (c) 1997-2020
+#  Ewgenij Gawrilow, Michael Joswig, and the polymake team
+#  Technische Universität Berlin, Germany
+#  https://polymake.org
+#
+#  This program is free software; you can redistribute it and/or modify it
+#  under the terms of the GNU General Public License as published by the
+#  Free Software Foundation; either version 2, or (at your option) any
+#  later version: http://www.gnu.org/licenses/gpl.txt.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#-------------------------------------------------------------------------------
+
+# The critical faces of a Morse matching are collected in a small bit set, moving to the heap for more than 256 faces.
+# Their numbers per dimension must agree with the list of critical faces and satisfy the weak Morse equality.
+
+sub check_critical_faces {
+   my ($id, $complex, $euler_characteristic) = @_;
+   my $mm = $complex->MORSE_MATCHING;
+   my $vector = $mm->CRITICAL_FACE_VECTOR;
+   my @by_dim = (0) x $vector->size;
+   ++$by_dim[$_->size-1] for @{$mm->CRITICAL_FACES};
+   compare_values("${id}_vector", new Array<Int>(\@by_dim), $vector);
+   my $alternating = 0;
+   $alternating += ($_ % 2 ? -1 : 1) * $vector->[$_] for 0..$vector->size-1;
+   compare_values("${id}_euler", $euler_characteristic, $alternating);
+}
+
+check_critical_faces('sphere2', sphere(2), 2);
+check_critical_faces('sphere7', sphere(7), 0);
+check_critical_faces('torus', torus(), 0);
+check_critical_faces('rp2', real_projective_plane(), 1);
+check_critical_faces('cp2', complex_projective_plane(), 3);
+
+# Local Variables:
+# mode: perl
+# cperl-indent-level:3
+# indent-tabs-mode:nil
+# End:
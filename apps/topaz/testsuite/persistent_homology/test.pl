@@ -0,0 +1,65 @@
+#  Copyright (c) 1997-2020
+#  Ewgenij Gawrilow, Michael Joswig, and the polymake team
+#  Technische Universität Berlin, Germany
+#  https://polymake.org
+#
+#  This program is free software; you can redistribute it and/or modify it
+#  under the terms of the GNU General Public License as published by the
+#  Free Software Foundation; either version 2, or (at your option) any
+#  later version: http://www.gnu.org/licenses/gpl.txt.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#-------------------------------------------------------------------------------
+
+# Persistence barcodes by boundary and coboundary reduction, as well as from the implicit Vietoris Rips filtration,
+# compared with the results of the former Zomorodian-Carlsson implementation.
+
+sub barcodes {
+   new Array<List<Pair<Int,Int>>>(@_)
+}
+
+sub check_intervals {
+   my ($id, $expected, $F) = @_;
+   compare_values("${id}_primal", $expected, persistent_homology($F));
+   compare_values("${id}_dual", $expected, persistent_homology($F, 1));
+}
+
+# hollow triangle filled at degree 5, with a fourth vertex appearing at degree 1 and joined at degree 4
+my $triangle = new Filtration<SparseMatrix<Rational>>(
+   new Array<Cell>(new Cell(0,0,0), new Cell(0,0,1), new Cell(0,0,2), new Cell(1,1,0), new Cell(2,1,1),
+                   new Cell(3,1,2), new Cell(1,0,3), new Cell(4,1,3), new Cell(5,2,0)),
+   new Array<SparseMatrix<Rational>>(new SparseMatrix<Rational>(4,0),
+                                     new SparseMatrix<Rational>([[-1,1,0,0],[0,-1,1,0],[-1,0,1,0],[0,0,-1,1]]),
+                                     new SparseMatrix<Rational>([[1,1,-1,0]])));
+
+check_intervals('triangle', barcodes([[0,1],[0,2],[1,4],[0,-1]], [[3,5]], []), $triangle);
+
+# eight points on the boundary of a square, with their pairwise l1 distances
+my $D = new Matrix<Float>([[0,2,4,6,8,6,4,2],
+                           [2,0,2,4,6,4,6,4],
+                           [4,2,0,2,4,6,8,6],
+                           [6,4,2,0,2,4,6,4],
+                           [8,6,4,2,0,2,4,6],
+                           [6,4,6,4,2,0,2,4],
+                           [4,6,8,6,4,2,0,2],
+                           [2,4,6,4,6,4,2,0]]);
+
+my $zero_degs = new Array<Int>(8);
+my $square = barcodes([ ([0,2]) x 7, [0,-1] ], [[2,4]], [ [4,-1], ([6,-1]) x 24, ([8,-1]) x 10 ]);
+check_intervals('square', $square, vietoris_rips_filtration<Rational>($D, $zero_degs, 1, 2));
+compare_values('square_implicit', $square, vietoris_rips_persistent_homology<Rational>($D, $zero_degs, 1, 2));
+compare_values('square_implicit_primal', $square, vietoris_rips_persistent_homology<Rational>($D, $zero_degs, 1, 2, 0));
+
+my $degs = new Array<Int>([0,1,0,2,0,1,0,0]);
+my $square_degs = barcodes([ [1,4], [0,4], [0,4], [2,4], [0,4], [1,4], [0,4], [0,-1] ], [[4,8]], [], [ ([12,-1]) x 16, ([16,-1]) x 19 ]);
+check_intervals('square_degs', $square_degs, vietoris_rips_filtration<Rational>($D, $degs, 0.5, 3));
+compare_values('square_degs_implicit', $square_degs, vietoris_rips_persistent_homology<Rational>($D, $degs, 0.5, 3));
+
+# Local Variables:
+# mode: perl
+# cperl-indent-level:3
+# indent-tabs-mode:nil
+# End:
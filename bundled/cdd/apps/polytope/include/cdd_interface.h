@@ -62,6 +62,14 @@ public:
    convex_hull_result<Scalar>
    enumerate_vertices(const Matrix<Scalar>& Inequalities, const Matrix<Scalar>& Equations, const bool isCone) const override;
 
+   Matrix<Scalar>
+   for_each_facet(const Matrix<Scalar>& Points, const Matrix<Scalar>& Lineality, const bool isCone,
+                  ConvexHullConsumer<Scalar>& consumer) const override;
+
+   Matrix<Scalar>
+   for_each_vertex(const Matrix<Scalar>& Inequalities, const Matrix<Scalar>& Equations, const bool isCone,
+                   ConvexHullConsumer<Scalar>& consumer) const override;
+
    std::pair<Bitset, Set<Int>> get_non_redundant_points(const Matrix<Scalar>& points, const Matrix<Scalar>& linealities, bool isCone) const override;
 
    std::pair<Bitset, Set<Int>> get_non_redundant_inequalities(const Matrix<Scalar>& inequalities, const Matrix<Scalar>& equations, bool isCone) const override;
@@ -221,6 +221,10 @@ public:
 
    convex_hull_result<Scalar> representation_conversion(const bool isCone, const representation target_rep) const;
 
+   // the same for the streaming solver interface: the points or inequalities are passed to the consumer,
+   // only the lineality space or equations are returned
+   Matrix<Scalar> representation_conversion(const bool isCone, const representation target_rep, ConvexHullConsumer<Scalar>& consumer) const;
+
    ListMatrix< Vector<Scalar> > vertex_normals(Bitset& Vertices);
 
    std::pair<Bitset, Set<Int>> canonicalize();
@@ -520,6 +524,36 @@ cdd_matrix<Scalar>::representation_conversion(const bool isCone, const represent
 }
 
 
+template <typename Scalar>
+Matrix<Scalar>
+cdd_matrix<Scalar>::representation_conversion(const bool isCone, const representation target_rep, ConvexHullConsumer<Scalar>& consumer) const
+{
+   const CDDRESOLVE(rowrange) m = ptr->rowsize;
+   const CDDRESOLVE(colrange) n = ptr->colsize;
+   const long linsize = set_card(ptr->linset);
+
+   if (target_rep == representation::V && m<=0) throw infeasible();
+
+   // the same adjustments as above
+   const bool cone_origin_only = target_rep == representation::V && isCone && !linsize && m==1;
+   bool homogeneous = target_rep == representation::V && !isCone && !linsize;
+   bool go_on = true;
+
+   ListMatrix<Vector<Scalar>> Lin(0, n);
+   // the iterator collects the lineality rows, hence it must run to the end
+   for (matrix_output_rows_iterator<Scalar> r(ptr->matrix, m, n, ptr->linset, Lin); !r.at_end(); ++r) {
+      if (!go_on) continue;
+      const Vector<Scalar> row(*r);
+      if (cone_origin_only && row[0]==1) continue;
+      if (homogeneous && !is_zero(row[0])) homogeneous = false;
+      go_on = consumer.consume(row);
+   }
+   if (homogeneous && go_on)
+      consumer.consume(unit_vector<Scalar>(n, 0));
+
+   return Matrix<Scalar>(linsize, n, operations::move(), entire(rows(Lin)));
+}
+
 template <typename Scalar>
 ListMatrix< Vector<Scalar> >
 cdd_matrix<Scalar>::vertex_normals(Bitset& Vertices)
@@ -671,6 +705,36 @@ ConvexHullSolver<Scalar>::enumerate_vertices(const Matrix<Scalar>& Inequalities,
    return cdd_matrix<Scalar>(P, representation::V).representation_conversion(isCone, representation::V);
 }
 
+template <typename Scalar>
+Matrix<Scalar>
+ConvexHullSolver<Scalar>::for_each_facet(const Matrix<Scalar>& Points, const Matrix<Scalar>& Lineality, const bool isCone,
+                                         ConvexHullConsumer<Scalar>& consumer) const
+{
+   if(Points.rows() == 0 && Lineality.rows() == 0){
+      // We deal with the trivial case here, since cdd fails for being called with two empty matrices.
+      return unit_matrix<Scalar>(Points.cols());
+   }
+   dd_debug = verbose ? dd_TRUE : dd_FALSE;
+   cdd_matrix<Scalar> IN(Points, Lineality, representation::V);
+   cdd_polyhedron<Scalar> P(IN);
+   dd_debug = dd_FALSE;
+   P.verify();
+   return cdd_matrix<Scalar>(P, representation::H).representation_conversion(isCone, representation::H, consumer);
+}
+
+template <typename Scalar>
+Matrix<Scalar>
+ConvexHullSolver<Scalar>::for_each_vertex(const Matrix<Scalar>& Inequalities, const Matrix<Scalar>& Equations, const bool isCone,
+                                          ConvexHullConsumer<Scalar>& consumer) const
+{
+   dd_debug = verbose ? dd_TRUE : dd_FALSE;
+   cdd_matrix<Scalar> IN(Inequalities, Equations, representation::H);
+   cdd_polyhedron<Scalar> P(IN);
+   dd_debug = dd_FALSE;
+   P.verify();
+   return cdd_matrix<Scalar>(P, representation::V).representation_conversion(isCone, representation::V, consumer);
+}
+
 template <typename Scalar>
 std::pair<Bitset, Set<Int>>
 ConvexHullSolver<Scalar>::get_non_redundant_points(const Matrix<Scalar>& Pt, const Matrix<Scalar>& Lin, bool /* isCone */) const
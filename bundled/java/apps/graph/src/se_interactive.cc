@@ -193,7 +193,7 @@ Function4perl(&interactive_spring_embedder,
               "interactive_spring_embedder(props::Graph<Undirected>, "
               "   { scale => 1, balance => 1, viscosity => 1, inertion => 1, eps => undef,"
               "     'z-ordering' => undef, 'z-factor' => undef, 'edge-weights' => undef,"
-              "      seed => undef, 'max-iterations' => 10000 }) ");
+              "      seed => undef, 'max-iterations' => 10000, theta => undef }) ");
 
 OpaqueClass4perl("SpringEmbedderWindow", std::unique_ptr<SpringEmbedderWindow>,
                  OpaqueMethod4perl("port()")
@@ -45,8 +45,11 @@ protected:
 
 class ConvexHullSolver : public LrsInstance, public polytope::ConvexHullSolver<Rational> {
 public:
-   explicit ConvexHullSolver(bool verbose_ = false)
-      : verbose(verbose_) {}
+   /// @param split_depth_ if positive, the reverse search tree is cut at this depth
+   ///                     and the subtrees below are traversed in parallel
+   explicit ConvexHullSolver(bool verbose_ = false, Int split_depth_ = 0)
+      : verbose(verbose_)
+      , split_depth(split_depth_) {}
 
    convex_hull_result<Rational>
    enumerate_facets(const Matrix<Rational>& Points, const Matrix<Rational>& Lineality, bool isCone) const override; 
@@ -57,6 +60,14 @@ public:
    convex_hull_result<Rational>
    enumerate_vertices(const Matrix<Rational>& Inequalities, const Matrix<Rational>& Equations, bool isCone) const override;
 
+   Matrix<Rational>
+   for_each_facet(const Matrix<Rational>& Points, const Matrix<Rational>& Lineality, bool isCone,
+                  ConvexHullConsumer<Rational>& consumer) const override;
+
+   Matrix<Rational>
+   for_each_vertex(const Matrix<Rational>& Inequalities, const Matrix<Rational>& Equations, bool isCone,
+                   ConvexHullConsumer<Rational>& consumer) const override;
+
    struct vertex_count {
       long n_vertices;
       long n_bounded_vertices;
@@ -75,6 +86,7 @@ public:
 
 private:
    const bool verbose;
+   const Int split_depth;
 };
 
 class LP_Solver : public LrsInstance, public polytope::LP_Solver<Rational> {
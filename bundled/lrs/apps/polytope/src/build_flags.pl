@@ -3,7 +3,10 @@
 # sympol and lrs interface compete for initialization of lrs FILE handles
 my $standalone_global_init = $ConfigFlags{BundledExts} =~ /\bsympol\b/ ? '' : ' -DPOLYMAKE_LRS_STANDALONE_GLOBAL_INIT';
 
-( 'lrs_interface.cc' => '${bundled.lrs.CFLAGS}'.$standalone_global_init,
+# only the bundled lrslib keeps the control of its dictionary cache in thread-local variables
+my $thread_local_cache = $ConfigFlags{'bundled.lrs.UseBundled'} ? ' -DPOLYMAKE_LRS_THREAD_LOCAL_CACHE' : '';
+
+( 'lrs_interface.cc' => '${bundled.lrs.CFLAGS}'.$standalone_global_init.$thread_local_cache,
 
   $ConfigFlags{'bundled.lrs.UseBundled'}
   ? ( staticlib => {
@@ -29,19 +29,19 @@ auto create_convex_hull_solver()
 
 }
 
-void lrs_ch_primal(BigObject p, const bool verbose, const bool isCone)
+void lrs_ch_primal(BigObject p, const bool verbose, const Int split_depth, const bool isCone)
 {
-   generic_convex_hull_primal<Rational>(p, isCone, lrs_interface::ConvexHullSolver(verbose));
+   generic_convex_hull_primal<Rational>(p, isCone, lrs_interface::ConvexHullSolver(verbose, split_depth));
 }
 
-void lrs_ch_dual(BigObject p, const bool verbose, const bool isCone)
+void lrs_ch_dual(BigObject p, const bool verbose, const Int split_depth, const bool isCone)
 {
-   generic_convex_hull_dual<Rational>(p, isCone, lrs_interface::ConvexHullSolver(verbose));
+   generic_convex_hull_dual<Rational>(p, isCone, lrs_interface::ConvexHullSolver(verbose, split_depth));
 }
 
-void lrs_count_vertices(BigObject p, const bool only_bounded, const bool verbose, const bool isCone)
+void lrs_count_vertices(BigObject p, const bool only_bounded, const bool verbose, const Int split_depth, const bool isCone)
 {
-   const lrs_interface::ConvexHullSolver solver(verbose);
+   const lrs_interface::ConvexHullSolver solver(verbose, split_depth);
    Matrix<Rational> H = p.give("FACETS | INEQUALITIES"),
                    EQ = p.lookup("LINEAR_SPAN | EQUATIONS");
 
@@ -82,9 +82,9 @@ void lrs_count_vertices(BigObject p, const bool only_bounded, const bool verbose
       p.take("N_BOUNDED_VERTICES") << 0;
 }
 
-void lrs_count_facets(BigObject p, const bool verbose, const bool isCone)
+void lrs_count_facets(BigObject p, const bool verbose, const Int split_depth, const bool isCone)
 {
-   const lrs_interface::ConvexHullSolver solver(verbose);
+   const lrs_interface::ConvexHullSolver solver(verbose, split_depth);
    Matrix<Rational> Points = p.give("RAYS | INPUT_RAYS"),
                  Lineality = p.lookup("LINEALITY_SPACE | INPUT_LINEALITY");
 
@@ -94,17 +94,17 @@ void lrs_count_facets(BigObject p, const bool verbose, const bool isCone)
    p.take("N_FACETS") << solver.count_facets(Points, Lineality, isCone);
 }
 
-Function4perl(&lrs_ch_primal, "lrs_ch_primal(Cone<Rational>; $=false, $=true)");
-Function4perl(&lrs_ch_dual, "lrs_ch_dual(Cone<Rational>; $=false, $=true)");
+Function4perl(&lrs_ch_primal, "lrs_ch_primal(Cone<Rational>; $=false, $=0, $=true)");
+Function4perl(&lrs_ch_dual, "lrs_ch_dual(Cone<Rational>; $=false, $=0, $=true)");
 
-Function4perl(&lrs_ch_primal, "lrs_ch_primal(Polytope<Rational>; $=false, $=false)");
-Function4perl(&lrs_ch_dual, "lrs_ch_dual(Polytope<Rational>; $=false, $=false)");
+Function4perl(&lrs_ch_primal, "lrs_ch_primal(Polytope<Rational>; $=false, $=0, $=false)");
+Function4perl(&lrs_ch_dual, "lrs_ch_dual(Polytope<Rational>; $=false, $=0, $=false)");
 
-Function4perl(&lrs_count_vertices, "lrs_count_vertices(Cone<Rational>, $; $=false, $=true)");
-Function4perl(&lrs_count_vertices, "lrs_count_vertices(Polytope<Rational>, $; $=false, $=false)");
+Function4perl(&lrs_count_vertices, "lrs_count_vertices(Cone<Rational>, $; $=false, $=0, $=true)");
+Function4perl(&lrs_count_vertices, "lrs_count_vertices(Polytope<Rational>, $; $=false, $=0, $=false)");
 
-Function4perl(&lrs_count_facets, "lrs_count_facets(Cone<Rational>; $=false, $=true)");
-Function4perl(&lrs_count_facets, "lrs_count_facets(Polytope<Rational>; $=false, $=false)");
+Function4perl(&lrs_count_facets, "lrs_count_facets(Cone<Rational>; $=false, $=0, $=true)");
+Function4perl(&lrs_count_facets, "lrs_count_facets(Polytope<Rational>; $=false, $=0, $=false)");
 
 InsertEmbeddedRule("function lrs.convex_hull: create_convex_hull_solver<Scalar> [Scalar==Rational] ()"
                    " : c++ (name => 'lrs_interface::create_convex_hull_solver') : returns(cached);\n");
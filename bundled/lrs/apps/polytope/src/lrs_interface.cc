@@ -20,7 +20,10 @@
 
 #include "polymake/polytope/lrs_interface.h"
 #include "polymake/hash_set"
-#include "polymake/ListMatrix.h"
+#include "polymake/list"
+#include "polymake/parallel.h"
+#include <vector>
+#include <exception>
 
 #define MA
 #define GMP
@@ -245,17 +248,216 @@ private:
    Int m, n;
 };
 
+// Consumers of the solutions found by the reverse search, see dictionary::traverse.
+// part() creates an empty consumer for the solutions in a subtree, merge() takes them over.
+// The traversal ends early as soon as the consumer reports to be stopped.
+class solution_sink {
+public:
+   bool stopped() const { return false; }
+};
+
+// all solutions, when each one is found exactly once
+class solution_list : public solution_sink {
+public:
+   void operator() (lrs_mp_vector_output& output)
+   {
+      rows.push_back(output.make_Vector(true));
+   }
+
+   solution_list part() const { return solution_list(); }
+
+   void merge(solution_list& p)
+   {
+      rows.splice(rows.end(), p.rows);
+   }
+
+   Matrix<Rational> make_Matrix(Int n)
+   {
+      return Matrix<Rational>(rows.size(), n, operations::move(), entire(rows));
+   }
+
+private:
+   std::list<Vector<Rational>> rows;
+};
+
+// all solutions, which may be found several times
+class solution_set : public solution_sink {
+public:
+   explicit solution_set(Int size_hint = 0)
+      : rows(size_hint) {}
+
+   void operator() (lrs_mp_vector_output& output)
+   {
+      rows.insert(output.make_Vector(true));
+   }
+
+   solution_set part() const { return solution_set(); }
+
+   void merge(solution_set& p)
+   {
+      for (const auto& r : p.rows)
+         rows.insert(r);
+      p.rows.clear();
+   }
+
+   Matrix<Rational> make_Matrix(Int n)
+   {
+      return Matrix<Rational>(rows.size(), n, operations::move(), entire(rows));
+   }
+
+private:
+   hash_set<Vector<Rational>> rows;
+};
+
+// each vertex is computed only once, but rays can appear multiple times.
+class vertices_and_rays : public solution_sink {
+public:
+   explicit vertices_and_rays(bool isCone_arg)
+      : isCone(isCone_arg) {}
+
+   void operator() (lrs_mp_vector_output& output)
+   {
+      if (!mpz_sgn(output.front())) {   // a ray starts with 0
+         rays.insert(output.make_Vector(true));
+      } else if (!isCone) {
+         // lrs returns the origin as a vertex for cones
+         // we have to remove this in our interpretation
+         vertices.push_back(output.make_Vector(false));
+      }
+   }
+
+   vertices_and_rays part() const { return vertices_and_rays(isCone); }
+
+   void merge(vertices_and_rays& p)
+   {
+      vertices.splice(vertices.end(), p.vertices);
+      for (const auto& r : p.rays)
+         rays.insert(r);
+      p.rays.clear();
+   }
+
+   Matrix<Rational> make_Matrix(Int n)
+   {
+      return Matrix<Rational>(rays.size()+vertices.size(), n, operations::move(), entire(rays), entire(vertices));
+   }
+
+private:
+   std::list<Vector<Rational>> vertices;
+   hash_set<Vector<Rational>> rays;
+   bool isCone;
+};
+
+class solution_count : public solution_sink {
+public:
+   explicit solution_count(bool only_bounded_arg = false)
+      : only_bounded(only_bounded_arg) {}
+
+   void operator() (lrs_mp_vector_output& output)
+   {
+      if (!only_bounded || mpz_sgn(output.front()))
+         ++n;
+   }
+
+   solution_count part() const { return solution_count(only_bounded); }
+
+   void merge(solution_count& p) { n += p.n; }
+
+   long n = 0;
+private:
+   bool only_bounded;
+};
+
+// vertices are counted, rays must be collected, as they can appear multiple times
+class vertex_and_ray_count : public solution_sink {
+public:
+   void operator() (lrs_mp_vector_output& output)
+   {
+      if (mpz_sgn(output.front()))
+         ++n_bounded;
+      else
+         rays.insert(output.make_Vector(true));
+   }
+
+   vertex_and_ray_count part() const { return vertex_and_ray_count(); }
+
+   void merge(vertex_and_ray_count& p)
+   {
+      n_bounded += p.n_bounded;
+      for (const auto& r : p.rays)
+         rays.insert(r);
+      p.rays.clear();
+   }
+
+   long n_bounded = 0;
+   hash_set<Vector<Rational>> rays;
+};
+
+// passes the solutions on to a consumer of the streaming solver interface, each one only once;
+// the parts for the subtrees keep them until they are merged
+class solution_stream : public solution_sink {
+public:
+   // vertices: the solutions are vertices and rays, otherwise facets
+   // unique: facets are found only once, as for polytopes, while rays always can appear multiple times
+   solution_stream(ConvexHullConsumer<Rational>* consumer_arg, bool vertices_arg, bool unique_arg, bool isCone_arg)
+      : consumer(consumer_arg)
+      , vertices(vertices_arg)
+      , unique(unique_arg)
+      , isCone(isCone_arg) {}
+
+   void operator() (lrs_mp_vector_output& output)
+   {
+      if (vertices && mpz_sgn(output.front())) {
+         // lrs returns the origin as a vertex for cones
+         if (!isCone) pass(output.make_Vector(false));
+      } else {
+         pass(output.make_Vector(true));
+      }
+   }
+
+   solution_stream part() const { return solution_stream(nullptr, vertices, unique, isCone); }
+
+   void merge(solution_stream& p)
+   {
+      for (auto& r : p.buffer)
+         pass(std::move(r));
+      p.buffer.clear();
+      p.seen.clear();
+   }
+
+   bool stopped() const { return !go_on; }
+
+private:
+   void pass(Vector<Rational>&& v)
+   {
+      if (!go_on) return;
+      if ((vertices ? is_zero(v[0]) : !unique) && !seen.insert(v).second) return;
+      if (consumer)
+         go_on = consumer->consume(v);
+      else
+         buffer.push_back(std::move(v));
+   }
+
+   ConvexHullConsumer<Rational>* consumer;
+   std::list<Vector<Rational>> buffer;
+   hash_set<Vector<Rational>> seen;
+   bool vertices, unique, isCone;
+   bool go_on = true;
+};
+
 struct dictionary {
    lrs_dat *Q;
-   lrs_dic_struct *P;
+   lrs_dic *P;
    lrs_mp_matrix Lin;
    FILE* save_lrs_ofp = nullptr;
+   // only the dictionary of the whole search redirects the lrs output, not those of the subtrees
+   bool redirected = false;
 #if defined(POLYMAKE_LRS_SUPPRESS_OUTPUT) && POLYMAKE_LRS_SUPPRESS_OUTPUT == 2
    int save_stdout = -1;
 #endif
 
    // stream cleanup and restore stdout
    void restore_ofp() {
+      if (!redirected) return;
       if (lrs_ofp == stderr) {
          fflush(lrs_ofp);
          lrs_ofp = save_lrs_ofp;
@@ -274,6 +476,8 @@ struct dictionary {
    {
       if (Lin) lrs_clear_mp_matrix(Lin, Q->nredundcol, Q->n);
       lrs_free_dic(P,Q);
+      // lrs keeps a global list of all lrs_dat records
+#pragma omp critical(lrs_globals)
       lrs_free_dat(Q);
       restore_ofp();
    }
@@ -312,6 +516,7 @@ struct dictionary {
       // initialize static lrs data
       Lin = nullptr;
 
+      redirected = true;
       if (verbose) {
          save_lrs_ofp = lrs_ofp;
          lrs_ofp = stderr;
@@ -323,7 +528,44 @@ struct dictionary {
       }
 #endif
 
+      init(Inequalities, Equations, dual, verbose);
+   }
+
+   // restart data of the reverse search: the cobasis of a node in the search tree and its depth
+   struct subtree {
+      std::vector<long> cobasis;
+      long depth;
+      // the cobasis entries follow the linearities in the restart data of lrs
+      long nlinearity;
+   };
+
+   // the subtree below the current basis
+   subtree current_subtree() const
+   {
+      subtree t{ std::vector<long>(P->d), P->depth, Q->nlinearity };
+      for (long i = 0; i < P->d; ++i)
+         t.cobasis[i] = Q->inequality[P->C[i] - Q->lastdv];
+      return t;
+   }
+
+   // A dictionary for the reverse search in a subtree, for the same input as the dictionary root.
+   // lrs_getfirstbasis pivots to the root of the subtree, the search does not backtrack above it.
+   dictionary(const dictionary& root, const Matrix<Rational>& Inequalities, const Matrix<Rational>& Equations, const subtree& start)
+   {
+      Lin = nullptr;
+      init(Inequalities, Equations, !root.Q->hull, false);
+      Q->polytope = root.Q->polytope;
+      Q->restart = TRUE;
+      Q->mindepth = start.depth;
+      P->depth = start.depth;
+      std::copy(start.cobasis.begin(), start.cobasis.end(), Q->facet + start.nlinearity);
+   }
+
+private:
+   void init(const Matrix<Rational>& Inequalities, const Matrix<Rational>& Equations, const bool dual, const bool verbose)
+   {
       char name[] = "polymake";
+#pragma omp critical(lrs_globals)
       Q=lrs_alloc_dat(name);
       if (!Q) {
          restore_ofp();
@@ -336,10 +578,13 @@ struct dictionary {
       if (!Q->n) Q->n=Equations.cols();
       Q->hull=dual?0:1;
 
-      // initialize dynamic lrs data
+      // initialize dynamic lrs data;
+      // this also resets the global control variables of the dictionary cache
+#pragma omp critical(lrs_globals)
       P=lrs_alloc_dic(Q);
       if (!P) {
          restore_ofp();
+#pragma omp critical(lrs_globals)
          lrs_free_dat(Q);
          throw std::bad_alloc();
       }
@@ -348,66 +593,85 @@ struct dictionary {
       if (Equations.rows())    set_matrix(Equations, Inequalities.rows(), false);
    }
 
-
+public:
    // the following functions "run" lrs
-   enum filter_nothing_t { filter_nothing };
-   enum filter_bounded_t { filter_bounded };
-   enum filter_rays_t { filter_rays };
-   enum filter_facets_t { filter_facets };
 
-   Matrix<Rational> get_solution_matrix(filter_nothing_t)
+   // Traverses the reverse search tree from the current basis and passes every solution to sink.
+   // With split_depth > 0 the nodes at this depth are not expanded here.  The subtrees below them are traversed
+   // in parallel instead, each one in its own dictionary restarted at its root and with its own part of the sink.
+   // The parts are merged into sink in the order of the subtrees, as soon as all preceding subtrees are finished,
+   // so that the solutions of finished subtrees do not pile up.
+   // lrs keeps a global list of lrs_dat records and the control variables of the dictionary cache in global variables.
+   // Access to the list is serialized.  The cache control is thread-local in the bundled lrslib only,
+   // the subtrees are traversed one after another with any other lrslib.
+   template <typename Sink>
+   void traverse(Sink& sink, const Matrix<Rational>& Inequalities, const Matrix<Rational>& Equations, const Int split_depth)
    {
-      ListMatrix<Vector<Rational>> facets(0,Q->n);
-
+      std::vector<subtree> subtrees;
       lrs_mp_vector_output output(Q->n);
+      bool prune;
       do {
          for (Int col = 0; col <= P->d; ++col)
             if (lrs_getsolution(P, Q, output, col))
-               facets /= output.make_Vector(true);
-      } while (lrs_getnextbasis (&P, Q, 0));
+               sink(output);
+         prune = split_depth > 0 && P->depth >= split_depth;
+         if (prune && !lrs_leaf(P, Q))
+            subtrees.push_back(current_subtree());
+      } while (!sink.stopped() && lrs_getnextbasis (&P, Q, prune));
+
+      const Int n_subtrees = subtrees.size();
+      if (n_subtrees == 0) return;
+
+      std::vector<Sink> parts;
+      parts.reserve(n_subtrees);
+      for (Int i = 0; i < n_subtrees; ++i)
+         parts.push_back(sink.part());
+      std::vector<bool> finished(n_subtrees, false);
+      Int n_merged = 0;
+      std::exception_ptr error;
+
+#ifdef POLYMAKE_LRS_THREAD_LOCAL_CACHE
+      const bool concurrent = true;
+#else
+      const bool concurrent = false;
+#endif
+      const parallel::ThreadLimit threads;
+#pragma omp parallel for schedule(dynamic, 1) if(concurrent)
+      for (Int i = 0; i < n_subtrees; ++i) {
+         bool skip;
+#pragma omp critical(lrs_merge)
+         skip = error || sink.stopped();
+         if (!skip) try {
+            dictionary D(*this, Inequalities, Equations, subtrees[i]);
+            if (!lrs_getfirstbasis(&D.P, D.Q, &D.Lin, 1))
+               throw std::runtime_error("lrs_interface - restart of the reverse search failed");
+            D.traverse_subtree(parts[i]);
+         }
+         catch (...) {
+#pragma omp critical(lrs_merge)
+            if (!error) error = std::current_exception();
+         }
+#pragma omp critical(lrs_merge)
+         {
+            finished[i] = true;
+            for (; n_merged < n_subtrees && finished[n_merged]; ++n_merged)
+               sink.merge(parts[n_merged]);
+         }
+      }
 
-      return Matrix<Rational>(facets.rows(), facets.cols(), operations::move(), entire(rows(facets)));
+      if (error) std::rethrow_exception(error);
    }
 
-   long count_solutions(filter_nothing_t)
+   // the solutions at the root of the subtree have already been found by the traversal which split it off
+   template <typename Sink>
+   void traverse_subtree(Sink& sink)
    {
-      long facets=0;
-
       lrs_mp_vector_output output(Q->n);
-      do {
+      while (!sink.stopped() && lrs_getnextbasis (&P, Q, 0)) {
          for (Int col = 0; col <= P->d; ++col)
             if (lrs_getsolution(P, Q, output, col))
-               ++facets;
-      } while (lrs_getnextbasis (&P, Q, 0));
-
-      return facets;
-   }
-
-   Matrix<Rational> get_solution_matrix(filter_rays_t, bool isCone)
-   {
-      // each vertex is computed only once, but rays can appear multiple times.
-      ListMatrix<Vector<Rational>> vertices(0,Q->n);
-      hash_set<Vector<Rational>> rays;
-
-      lrs_mp_vector_output output(Q->n);
-      do {
-         for (Int col = 0; col <= P->d; ++col) {
-            if (lrs_getsolution(P, Q, output, col)) {
-               if (!mpz_sgn(output.front())) {   // a ray starts with 0
-                  rays.insert(output.make_Vector(true));
-               } else if (!isCone) {
-                  // lrs returns the origin as a vertex for cones
-                  // we have to remove this in our interpretation
-                  vertices /= output.make_Vector(false);
-               }
-            }
-         }
-      } while (lrs_getnextbasis (&P, Q, 0));
-
-      if (isCone)
-         return Matrix<Rational>(rays.size(), Q->n, operations::move(), entire(rays));
-      else
-         return Matrix<Rational>(rays.size()+vertices.rows(), Q->n, operations::move(), entire(rays), entire(rows(vertices)));
+               sink(output);
+      }
    }
 
    Matrix<Rational> get_linearities()
@@ -417,57 +681,6 @@ struct dictionary {
       Lin=nullptr;
       return output.make_Matrix();
    }
-
-   std::pair<long, long> count_solutions(filter_rays_t)
-   {
-      std::pair<long, long> vertices(0, 0);
-      hash_set<Vector<Rational>> rays;
-
-      lrs_mp_vector_output output(Q->n);
-      do {
-         for (Int col = 0; col <= P->d; ++col)
-            if (lrs_getsolution(P, Q, output, col)) {
-               if (mpz_sgn(output.front()))
-                  ++vertices.second;
-               else
-                  rays.insert(output.make_Vector(true));
-            }
-
-      } while (lrs_getnextbasis (&P, Q, 0));
-
-      vertices.first = vertices.second + rays.size();
-      return vertices;
-   }
-
-   long count_solutions(filter_bounded_t)
-   {
-      long vertices=0;
-
-      lrs_mp_vector_output output(Q->n);
-      do {
-         for (Int col = 0; col <= P->d; ++col)
-            if (lrs_getsolution(P, Q, output, col)) {
-               if (mpz_sgn(output.front()))
-                  ++vertices;
-            }
-      } while (lrs_getnextbasis (&P, Q, 0));
-
-      return vertices;
-   }
-
-   Matrix<Rational> get_solution_matrix(filter_facets_t)
-   {
-      hash_set<Vector<Rational>> facets(Q->m * Q->n);
-
-      lrs_mp_vector_output output(Q->n);
-      do {
-         for (Int col = 0; col <= P->d; ++col)
-            if (lrs_getsolution(P, Q, output, col))
-               facets.insert(output.make_Vector(true));
-      } while (lrs_getnextbasis (&P, Q, 0));
-
-      return Matrix<Rational>(facets.size(), Q->n, operations::move(), entire(facets));
-   }
 };
 
 convex_hull_result<Rational>
@@ -481,13 +694,37 @@ ConvexHullSolver::enumerate_facets(const Matrix<Rational>& Points, const Matrix<
    if (!lrs_getfirstbasis(&D.P, D.Q, &D.Lin, 1) && !D.Q->nredundcol) throw infeasible();
 
    Matrix<Rational> AH = isCone ? D.get_linearities().minor(range_from(1), All) : D.get_linearities(); // always lrs returns the functional [1,0,0,0,...]
-   Matrix<Rational> F = D.Q->polytope
-                        ? D.get_solution_matrix(dictionary::filter_nothing)  // lrs computes facets only once if input is a polytope
-                        : D.get_solution_matrix(dictionary::filter_facets);  // FIXME can facets appear several times for unbounded polyhedra?
+   Matrix<Rational> F;
+   if (D.Q->polytope) {
+      // lrs computes facets only once if input is a polytope
+      solution_list facets;
+      D.traverse(facets, Points, Lineality, split_depth);
+      F = facets.make_Matrix(D.Q->n);
+   } else {
+      // FIXME can facets appear several times for unbounded polyhedra?
+      solution_set facets(D.Q->m * D.Q->n);
+      D.traverse(facets, Points, Lineality, split_depth);
+      F = facets.make_Matrix(D.Q->n);
+   }
    // TODO: std::move
    return { F, AH };
 }
 
+Matrix<Rational>
+ConvexHullSolver::for_each_facet(const Matrix<Rational>& Points, const Matrix<Rational>& Lineality, const bool isCone,
+                                 ConvexHullConsumer<Rational>& consumer) const
+{
+   dictionary D(Points, Lineality, false, verbose);
+   D.Q->polytope= isCone || attach_selector(Points.col(0), operations::is_zero()).empty();
+
+   if (!lrs_getfirstbasis(&D.P, D.Q, &D.Lin, 1) && !D.Q->nredundcol) throw infeasible();
+
+   Matrix<Rational> AH = isCone ? D.get_linearities().minor(range_from(1), All) : D.get_linearities();
+   solution_stream facets(&consumer, false, D.Q->polytope, isCone);
+   D.traverse(facets, Points, Lineality, split_depth);
+   return AH;
+}
+
 // FIXME check: why are unbounded polyhedra not allowed?
 long
 ConvexHullSolver::count_facets(const Matrix<Rational>& Points, const Matrix<Rational>& Lineality, const bool isCone) const
@@ -502,9 +739,12 @@ ConvexHullSolver::count_facets(const Matrix<Rational>& Points, const Matrix<Rati
 
    if (!lrs_getfirstbasis(&D.P, D.Q, &D.Lin, 1)) throw infeasible();
 
-   return D.Q->nredundcol+1==D.Q->n
-          ? 0       // lrs does not treat the special case of a single point correctly
-          : D.count_solutions(dictionary::filter_nothing);
+   // lrs does not treat the special case of a single point correctly
+   if (D.Q->nredundcol+1==D.Q->n) return 0;
+
+   solution_count facets;
+   D.traverse(facets, Points, Lineality, split_depth);
+   return facets.n;
 }
 
 convex_hull_result<Rational>
@@ -515,12 +755,28 @@ ConvexHullSolver::enumerate_vertices(const Matrix<Rational>& Inequalities, const
    if (!lrs_getfirstbasis(&D.P, D.Q, &D.Lin, 1)) throw infeasible();
 
    Matrix<Rational> Lineality = D.get_linearities();
-   Matrix<Rational> Vertices  = D.get_solution_matrix(dictionary::filter_rays, isCone);
+   vertices_and_rays solutions(isCone);
+   D.traverse(solutions, Inequalities, Equations, split_depth);
+   Matrix<Rational> Vertices = solutions.make_Matrix(D.Q->n);
 
    // TODO: std::move
    return { Vertices, Lineality };
 }
 
+Matrix<Rational>
+ConvexHullSolver::for_each_vertex(const Matrix<Rational>& Inequalities, const Matrix<Rational>& Equations, const bool isCone,
+                                  ConvexHullConsumer<Rational>& consumer) const
+{
+   dictionary D(Inequalities, Equations, true, verbose);
+
+   if (!lrs_getfirstbasis(&D.P, D.Q, &D.Lin, 1)) throw infeasible();
+
+   Matrix<Rational> Lineality = D.get_linearities();
+   solution_stream vertices(&consumer, true, false, isCone);
+   D.traverse(vertices, Inequalities, Equations, split_depth);
+   return Lineality;
+}
+
 ConvexHullSolver::vertex_count
 ConvexHullSolver::count_vertices(const Matrix<Rational>& Inequalities, const Matrix<Rational>& Equations, const bool only_bounded) const
 {
@@ -531,10 +787,15 @@ ConvexHullSolver::count_vertices(const Matrix<Rational>& Inequalities, const Mat
    vertex_count count;
    count.lineality_dim = D.Q->nredundcol;
    if (only_bounded) {
+      solution_count vertices(true);
+      D.traverse(vertices, Inequalities, Equations, split_depth);
       count.n_vertices = 0;
-      count.n_bounded_vertices = D.count_solutions(dictionary::filter_bounded);
+      count.n_bounded_vertices = vertices.n;
    } else {
-      std::tie(count.n_vertices, count.n_bounded_vertices) = D.count_solutions(dictionary::filter_rays);
+      vertex_and_ray_count vertices;
+      D.traverse(vertices, Inequalities, Equations, split_depth);
+      count.n_bounded_vertices = vertices.n_bounded;
+      count.n_vertices = vertices.n_bounded + vertices.rays.size();
    }
 
    return count;
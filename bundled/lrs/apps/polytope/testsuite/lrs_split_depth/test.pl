@@ -0,0 +1,43 @@
+#  Copyright (c) 1997-2020
+#  Ewgenij Gawrilow, Michael Joswig, and the polymake team
+#  Technische Universität Berlin, Germany
+#  https://polymake.org
+#
+#  This program is free software; you can redistribute it and/or modify it
+#  under the terms of the GNU General Public License as published by the
+#  Free Software Foundation; either version 2, or (at your option) any
+#  later version: http://www.gnu.org/licenses/gpl.txt.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#-------------------------------------------------------------------------------
+
+# the reverse search cut at a small depth must deliver the same results as the sequential one
+
+prefer_now "lrs";
+
+my $points = cyclic(5,12)->VERTICES;
+my $facets = (new Polytope(POINTS=>$points))->FACETS;
+my $vertices = (new Polytope(INEQUALITIES=>$facets))->VERTICES;
+
+local $lrs_split_depth = 2;
+
+my $p = new Polytope(POINTS=>$points);
+compare_values('facets', new Set<Vector<Rational>>(rows($facets)), new Set<Vector<Rational>>(rows($p->FACETS)));
+compare_values('n_facets', 72, (new Polytope(POINTS=>$points))->N_FACETS);
+
+my $q = new Polytope(INEQUALITIES=>$facets);
+compare_values('vertices', new Set<Vector<Rational>>(rows($vertices)), new Set<Vector<Rational>>(rows($q->VERTICES)));
+compare_values('n_vertices', 12, (new Polytope(INEQUALITIES=>$facets))->N_VERTICES);
+
+my $c = cube(4);
+compare_values('cube_n_vertices', 16, (new Polytope(INEQUALITIES=>$c->FACETS))->N_VERTICES);
+compare_values('cube_n_facets', 8, (new Polytope(POINTS=>$c->VERTICES))->N_FACETS);
+
+# Local Variables:
+# mode: perl
+# cperl-indent-level:3
+# indent-tabs-mode:nil
+# End:
@@ -35,7 +35,9 @@ FILE *lrs_ifp;			/* input file pointer       */
 FILE *lrs_ofp;			/* output file pointer      */
 
 
-static unsigned long dict_count, dict_limit, cache_tries, cache_misses;
+/* polymake: the dictionary cache is controlled per thread, because the subtrees of a reverse search
+   are traversed in parallel threads by lrs_interface.cc */
+static __thread unsigned long dict_count, dict_limit, cache_tries, cache_misses;
 
 /* Variables and functions global to this file only */
 static long lrs_checkpoint_seconds = 0;
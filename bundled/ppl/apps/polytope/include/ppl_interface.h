@@ -31,6 +31,14 @@ public:
 
    convex_hull_result<Scalar>
    enumerate_vertices(const Matrix<Scalar>& Inequalities, const Matrix<Scalar>& Equations, const bool isCone) const override; 
+
+   Matrix<Scalar>
+   for_each_facet(const Matrix<Scalar>& Points, const Matrix<Scalar>& Lineality, const bool isCone,
+                  ConvexHullConsumer<Scalar>& consumer) const override;
+
+   Matrix<Scalar>
+   for_each_vertex(const Matrix<Scalar>& Inequalities, const Matrix<Scalar>& Equations, const bool isCone,
+                   ConvexHullConsumer<Scalar>& consumer) const override;
 };
 
 template <typename Scalar>
@@ -340,6 +340,79 @@ ConvexHullSolver<Scalar>::enumerate_vertices(const Matrix<Scalar>& Inequalities,
    return { Matrix<Scalar>(vertex_list), Matrix<Scalar>(lin_space_list) };
 }
 
+template <typename Scalar>
+Matrix<Scalar>
+ConvexHullSolver<Scalar>::for_each_facet(const Matrix<Scalar>& Points, const Matrix<Scalar>& Lineality, const bool isCone,
+                                         ConvexHullConsumer<Scalar>& consumer) const
+{
+   const Int num_columns = std::max(Points.cols(), Lineality.cols());
+
+   PPL::C_Polyhedron polyhedron = construct_ppl_polyhedron_V(Points, Lineality, isCone);
+   Set<Int> far_face(far_points(Points));
+
+   PPL::Constraint_System cs = polyhedron.minimized_constraints();
+   ListMatrix< Vector<Scalar> > affine_hull_list(0, num_columns);
+
+   const auto triv_ineq=unit_vector<Scalar>(num_columns, 0);
+   bool go_on = true;
+
+   // the equations must be collected even after the consumer has stopped
+   for (PPL::Constraint_System::const_iterator csi = cs.begin(); csi != cs.end(); ++csi) {
+      const PPL::Constraint& c = *csi;
+      if (c.is_inequality() && !go_on) continue;
+      Vector<Scalar> row = ppl_constraint_to_vec<Scalar>(c, isCone);
+      if (!(isCone && row == triv_ineq )) {
+         if (c.is_inequality()) {
+            go_on = consumer.consume(row);
+         } else {
+            assert(c.is_equality());
+            affine_hull_list  /= row;
+         }
+      }
+   }
+
+   // the far face inequality, see enumerate_facets
+   if (go_on && !isCone && rank(Points.minor(far_face,All)/Lineality)+1 == num_columns - affine_hull_list.rows()) {
+      consumer.consume(triv_ineq);
+   }
+
+   return Matrix<Scalar>(affine_hull_list);
+}
+
+template <typename Scalar>
+Matrix<Scalar>
+ConvexHullSolver<Scalar>::for_each_vertex(const Matrix<Scalar>& Inequalities, const Matrix<Scalar>& Equations, const bool isCone,
+                                          ConvexHullConsumer<Scalar>& consumer) const
+{
+   const Int num_columns = std::max(Inequalities.cols(), Equations.cols());
+   // see enumerate_vertices
+   if (!isCone && Inequalities.rows() + Equations.rows() == 0)
+      return Matrix<Scalar>(0, num_columns);
+
+   PPL::C_Polyhedron polyhedron = construct_ppl_polyhedron_H(Inequalities, Equations, isCone);
+   PPL::Generator_System gs = polyhedron.minimized_generators();
+   ListMatrix<Vector<Scalar>> lin_space_list(0,num_columns);
+
+   const auto cone_origin=unit_vector<Scalar>(num_columns, 0);
+   bool go_on = true;
+
+   for (PPL::Generator_System::const_iterator gsi = gs.begin(); gsi != gs.end(); ++gsi) {
+      const PPL::Generator& g = *gsi;
+      if (!g.is_line() && !go_on) continue;
+      Vector<Scalar> row = ppl_gen_to_vec<Scalar>(g, isCone);
+      if (!(isCone && row == cone_origin)) {
+         if (g.is_point() || g.is_ray()) {
+            go_on = consumer.consume(row);
+         } else {
+            assert(g.is_line());
+            lin_space_list  /= row;
+         }
+      }
+   }
+
+   return Matrix<Scalar>(lin_space_list);
+}
+
 template <typename Scalar>
 LP_Solution<Scalar>
 LP_Solver<Scalar>::solve(const Matrix<Scalar>& Inequalities, const Matrix<Scalar>& Equations,
@@ -21,6 +21,14 @@
 #include <queue>
 #include <sstream>
 #include <map>
+#include <memory>
+#include <exception>
+#include <mutex>
+#include <condition_variable>
+
+#ifdef _OPENMP
+	#include <omp.h>
+#endif
 
 #include "TOSimplex.h"
 
@@ -57,6 +65,15 @@ struct MIP {
 };
 
 
+// Schrankenänderung eines Knotens: upper ? x_var <= bound : x_var >= bound
+template <class T, class TInt>
+struct BoundChange {
+	TInt var;
+	bool upper;
+	T bound;
+};
+
+
 template <class T, class TInt>
 class BnBNode
 {
@@ -65,10 +82,8 @@ class BnBNode
 		BnBNode<T, TInt>* rightChild;
 
 	public:
-		std::vector<TInt> vars;
+		std::vector<BoundChange<T, TInt> > changes;
 		const TInt depth;
-		std::vector<bool> whichBounds;
-		std::vector<T> Bounds;
 		const T priority;
 		T bound;
 		BnBNode<T, TInt>* parent;
@@ -77,10 +92,8 @@ class BnBNode
 		BnBNode( BnBNode<T, TInt>* parent_, const TInt pos, const TInt var, const bool whichBound, const T& Bound, const T& priority_, const T& bound_, const TInt depth_ ):
 			leftChild( nullptr ),
 			rightChild( nullptr ),
-			vars( 1, var ),
+			changes( 1, BoundChange<T, TInt>{ var, whichBound, Bound } ),
 			depth( depth_ ),
-			whichBounds( 1, whichBound ),
-			Bounds( 1, Bound ),
 			priority( priority_ ),
 			bound( bound_ ),
 			parent( parent_ ),
@@ -100,10 +113,7 @@ class BnBNode
 		BnBNode( const T& bound_ ):
 			leftChild( nullptr ),
 			rightChild( nullptr ),
-			vars( 0 ),
 			depth( 0 ),
-			whichBounds( 0 ),
-			Bounds( 0 ),
 			priority( 0 ),
 			bound( bound_ ),
 			parent( nullptr ),
@@ -208,6 +218,13 @@ class TOMipSolver
 		};
 
 		solstatus solve( MIP<T, TInt> mip, bool allSolutions, T& optimalValue, std::vector<T>& optimalAssignment, std::vector<std::vector<T> >* allAssignments );
+
+		// Anzahl der Threads für Branch-and-Bound, Voreinstellung 1, 0 = OpenMP-Voreinstellung.
+		// Mit mehreren Threads hängen die Reihenfolge in allAssignments und bei mehreren Optima die
+		// zurückgegebene optimale Lösung vom Ablauf ab, der Optimalwert und die Menge aller Lösungen nicht.
+		void setNumThreads( int threads ){
+			this->numThreads = threads;
+		}
 		std::string solstatusToString( solstatus solStatus ){
 			switch( solStatus ){
 				case UNSOLVED:
@@ -232,18 +249,76 @@ class TOMipSolver
 	private:
 
 		solstatus BnB( const MIP<T, TInt>& mip, TOSimplex::TOSolver<T, TInt>& plex, bool allSolutions, T& objval, std::vector<T>& optimalAssignment, std::vector<std::vector<T> >* allAssignments );
+		bool setNodeBounds( const MIP<T, TInt>& mip, TOSimplex::TOSolver<T, TInt>& plex, std::vector<T>& lbounds, std::vector<T>& ubounds, std::vector<TInt>& touched, std::vector<TInt>& reset, const BnBNode<T, TInt>* node, const BoundChange<T, TInt>* extra );
 
+		int numThreads;
 
 };
 
 
 template <class T, class TInt>
-TOMipSolver<T, TInt>::TOMipSolver(){
+TOMipSolver<T, TInt>::TOMipSolver():
+	numThreads( 1 )
+{
+
+}
+
+
+// Setzt die Schranken in plex auf die des Knotens node und seiner Vorgänger, ggf. zusätzlich extra.
+// lbounds/ubounds enthalten die Schranken des zuletzt gesetzten Knotens, touched die dabei geänderten Variablen.
+// Aufwand linear in der Tiefe des Knotens statt in der Anzahl der Variablen.
+// Liefert false, falls sich die Schranken widersprechen.
+template <class T, class TInt>
+bool TOMipSolver<T, TInt>::setNodeBounds( const MIP<T, TInt>& mip, TOSimplex::TOSolver<T, TInt>& plex, std::vector<T>& lbounds, std::vector<T>& ubounds, std::vector<TInt>& touched, std::vector<TInt>& reset, const BnBNode<T, TInt>* node, const BoundChange<T, TInt>* extra ){
+
+	reset.swap( touched );
+	touched.clear();
+	for( const TInt i : reset ){
+		lbounds[i] = mip.lbounds[i];
+		ubounds[i] = mip.ubounds[i];
+	}
+
+	bool feasible = true;
+	auto apply = [&]( const BoundChange<T, TInt>& change ){
+		if( !change.upper ){
+			if( change.bound > lbounds[change.var] ){
+				lbounds[change.var] = change.bound;
+			}
+		} else if( change.bound < ubounds[change.var] ){
+			ubounds[change.var] = change.bound;
+		}
+		if( lbounds[change.var] > ubounds[change.var] ){
+			feasible = false;
+		}
+		touched.push_back( change.var );
+	};
 
+	if( extra ){
+		apply( *extra );
+	}
+	for( ; node; node = node->parent ){
+		for( const BoundChange<T, TInt>& change : node->changes ){
+			apply( change );
+		}
+	}
+
+	for( const TInt i : reset ){
+		plex.setVarBounds( i, TOSimplex::TORationalInf<T>( lbounds[i] ), TOSimplex::TORationalInf<T>( ubounds[i] ) );
+	}
+	for( const TInt i : touched ){
+		plex.setVarBounds( i, TOSimplex::TORationalInf<T>( lbounds[i] ), TOSimplex::TORationalInf<T>( ubounds[i] ) );
+	}
+
+	return feasible;
 }
 
 
 
+// Best-First-Suche mit numThreads Threads. Jeder Thread löst die Knoten-LPs mit einer eigenen Kopie von plex,
+// Warteschlange, Baum, Inkumbente, branchPriorities und allAssignments werden nur unter mutex verändert.
+// Threads ohne Knoten warten auf wakeup, bis ein anderer Thread Kinder erzeugt oder die Suche endet.
+// Eine Ausnahme in einem Thread beendet die Suche und wird nach dem parallelen Bereich weitergeworfen.
+// Mit einem Thread entspricht der Ablauf der sequentiellen Suche.
 template <class T, class TInt>
 typename TOMipSolver<T, TInt>::solstatus TOMipSolver<T, TInt>::BnB( const MIP<T, TInt>& mip, TOSimplex::TOSolver<T, TInt>& plex, bool allSolutions, T& optimalValue, std::vector<T>& optimalAssignment, std::vector<std::vector<T> >* allAssignments ){
 
@@ -264,210 +339,251 @@ typename TOMipSolver<T, TInt>::solstatus TOMipSolver<T, TInt>::BnB( const MIP<T,
 		allAssignments->resize( 0 );
 	}
 
-	while( !queue.empty() ){
-
-		BnBNode<T, TInt>* bs = queue.top();
-		queue.pop();
-
-		if( bs->deleted ){
-			delete bs;
-			continue;
-		}
-
-		if( !allSolutions && optimalAssignment.size() && bs->bound >= optimalValue ){
-			#ifndef TO_DISABLE_OUTPUT
-				std::cout << "Cutoff 1: " << TOmath<T>::toShortString( bs->bound ) << " / " << TOmath<T>::toShortString( optimalValue ) << std::endl;
-			#endif
-			delete bs;
-			continue;
-		}
-
-		std::vector<T> tmplbounds = mip.lbounds;
-		std::vector<T> tmpubounds = mip.ubounds;
+	std::mutex mutex;
+	std::condition_variable wakeup;
+	// Anzahl der Threads, die gerade einen Knoten bearbeiten. Die Suche endet, wenn die Warteschlange leer ist und keiner mehr arbeitet.
+	TInt activeWorkers = 0;
+	// Wird bei jeder neuen Inkumbente erhöht, damit jeder Thread die Schranke seines LPs nachzieht.
+	unsigned long incumbentVersion = 0;
+	std::exception_ptr error;
 
+	// speichert die erste Ausnahme und weckt alle Threads, damit sie aufhören; mutex darf nicht gesperrt sein
+	auto fail = [&]( std::exception_ptr e ){
 		{
-			BnBNode<T, TInt>* tmpnode = bs;
-			do{
-				for( TInt i = 0; i < static_cast<TInt>( tmpnode->vars.size() ); ++i ){
-					if( !tmpnode->whichBounds[i] ){
-						tmplbounds[ tmpnode->vars[i] ] = std::max( tmplbounds.at( tmpnode->vars[i] ), tmpnode->Bounds[i] );
-					} else {
-						tmpubounds[ tmpnode->vars[i] ] = std::min( tmpubounds.at( tmpnode->vars[i] ), tmpnode->Bounds[i] );
-					}
-
-					if( tmplbounds.at( tmpnode->vars[i] ) > tmpubounds.at( tmpnode->vars[i] ) ){
-						bs->deleted = true;
-						break;
-					}
-				}
-				if( bs->deleted ){
-					break;
-				}
-			} while( ( tmpnode = tmpnode->parent ) );
+			std::lock_guard<std::mutex> lock( mutex );
+			if( !error ){
+				error = e;
+			}
 		}
+		wakeup.notify_all();
+	};
 
-		if( bs->deleted ){
-			delete bs;
-			continue;
-		}
+	int numWorkers = 1;
+	#ifdef _OPENMP
+		numWorkers = this->numThreads > 0 ? this->numThreads : omp_get_max_threads();
+	#endif
 
-		for( TInt i = 0; i < n; ++i ){
-			if( mip.numbersystems[i] != 'R' ){
-				plex.setVarBounds( i, TOSimplex::TORationalInf<T>( tmplbounds[i] ), TOSimplex::TORationalInf<T>( tmpubounds[i] ) );
+	#pragma omp parallel num_threads( numWorkers )
+	{
+		// Thread 0 arbeitet auf plex selbst, alle anderen auf einer Kopie, die erstellt sein muss, bevor Thread 0 plex verändert.
+		std::unique_ptr<TOSimplex::TOSolver<T, TInt> > plexCopy;
+		bool ready = true;
+		#ifdef _OPENMP
+			if( omp_get_thread_num() != 0 ){
+				try{
+					plexCopy.reset( new TOSimplex::TOSolver<T, TInt>( plex ) );
+				} catch( ... ){
+					fail( std::current_exception() );
+					ready = false;
+				}
 			}
-		}
+		#endif
+		#pragma omp barrier
 
-		if( plex.opt() ){
-			#ifndef TO_DISABLE_OUTPUT
-				std::cout << "Node-LP Infeasible.";
-				if( optimalAssignment.size() ){
-					std::cout << " (current best: " << optimalValue << ")";
-				}
-				std::cout << std::endl;
-			#endif
+		if( ready ){
+			TOSimplex::TOSolver<T, TInt>& nodeplex = plexCopy ? *plexCopy : plex;
 
-			if( bs->vars.size() == 1 ){
-				#ifndef TO_DISABLE_OUTPUT
-					std::cout << "Backtracking" << std::endl;
-				#endif
+			try{
+				std::vector<T> tmplbounds = mip.lbounds;
+				std::vector<T> tmpubounds = mip.ubounds;
+				std::vector<TInt> touched, reset;
+				unsigned long knownIncumbentVersion = 0;
 
-				BnBNode<T, TInt>* backTrackStart = bs->parent;
-				do{
-					std::vector<T> tmplbounds2 = mip.lbounds;
-					std::vector<T> tmpubounds2 = mip.ubounds;
+				while( true ){
 
-					if( backTrackStart && backTrackStart->parent ){
-						if( !bs->whichBounds[0] ){
-							tmplbounds2[ bs->vars[0] ] = std::max( tmplbounds2.at( bs->vars[0] ), bs->Bounds[0] );
-						} else {
-							tmpubounds2[ bs->vars[0] ] = std::min( tmpubounds2.at( bs->vars[0] ), bs->Bounds[0] );
+					BnBNode<T, TInt>* bs = nullptr;
+					{
+						std::unique_lock<std::mutex> lock( mutex );
+						wakeup.wait( lock, [&](){ return error || !queue.empty() || activeWorkers == 0; } );
+						if( error || queue.empty() ){
+							break;
 						}
+						bs = queue.top();
+						queue.pop();
+						++activeWorkers;
+					}
 
-						BnBNode<T, TInt>* tmpnode = backTrackStart->parent;
+					TInt branchVar = -1;
+					std::vector<T> x;
+					T objval;
+
+					try{
 						do{
-							for( TInt i = 0; i < static_cast<TInt>( tmpnode->vars.size() ); ++i ){
-								if( !tmpnode->whichBounds[i] ){
-									tmplbounds2[ tmpnode->vars[i] ] = std::max( tmplbounds2.at( tmpnode->vars[i] ), tmpnode->Bounds[i] );
+							bool cutoff = false;
+							bool feasibleBounds = true;
+							{
+								std::lock_guard<std::mutex> lock( mutex );
+								if( bs->deleted ){
+									cutoff = true;
+								} else if( !allSolutions && optimalAssignment.size() && bs->bound >= optimalValue ){
+									#ifndef TO_DISABLE_OUTPUT
+										std::cout << "Cutoff 1: " << TOmath<T>::toShortString( bs->bound ) << " / " << TOmath<T>::toShortString( optimalValue ) << std::endl;
+									#endif
+									cutoff = true;
 								} else {
-									tmpubounds2[ tmpnode->vars[i] ] = std::min( tmpubounds2.at( tmpnode->vars[i] ), tmpnode->Bounds[i] );
+									feasibleBounds = setNodeBounds( mip, nodeplex, tmplbounds, tmpubounds, touched, reset, bs, nullptr );
+									if( !allSolutions && knownIncumbentVersion != incumbentVersion ){
+										nodeplex.setInfeasibilityBound( optimalValue );
+										knownIncumbentVersion = incumbentVersion;
+									}
+								}
+								if( cutoff || !feasibleBounds ){
+									delete bs;
 								}
 							}
-						} while( ( tmpnode = tmpnode->parent ) );
-					} else {
-						break;
-					}
+							if( cutoff || !feasibleBounds ){
+								break;
+							}
 
-					for( TInt i = 0; i < n; ++i ){
-						if( mip.numbersystems[i] != 'R' ){
-							plex.setVarBounds( i, TOSimplex::TORationalInf<T>( tmplbounds2[i] ), TOSimplex::TORationalInf<T>( tmpubounds2[i] ) );
-						}
-					}
+							if( nodeplex.opt() ){
+								#ifndef TO_DISABLE_OUTPUT
+									std::cout << "Node-LP Infeasible." << std::endl;
+								#endif
 
-					if( plex.opt() || ( !allSolutions && optimalAssignment.size() && plex.getObj() > optimalValue ) ){
-						#ifndef TO_DISABLE_OUTPUT
-							std::cout << "Success" << std::endl;
-						#endif
-						++branchPriorities[bs->vars[0]];
-					} else {
-						#ifndef TO_DISABLE_OUTPUT
-							std::cout << "No success" << std::endl;
-						#endif
-						break;
-					}
-				} while( ( backTrackStart = backTrackStart->parent ) );
-
-				if( backTrackStart != bs->parent ){
-//					backTrackStart->setChildrenDeleted();
-					backTrackStart->vars.push_back( bs->vars[0] );
-					backTrackStart->whichBounds.push_back( !bs->whichBounds[0] );
-					if( !bs->whichBounds[0] ){
-						// Andere Schranke!!!
-						backTrackStart->Bounds.push_back( bs->Bounds[0] - T( 1 ) );
-					} else {
-						backTrackStart->Bounds.push_back( bs->Bounds[0] + T( 1 ) );
-					}
+								if( bs->changes.size() == 1 ){
+									#ifndef TO_DISABLE_OUTPUT
+										std::cout << "Backtracking" << std::endl;
+									#endif
 
-					// TODO Objval-Schranke anpassen?
-//					queue.push( backTrackStart );
+									const BoundChange<T, TInt> branch = bs->changes[0];
+									BnBNode<T, TInt>* backTrackStart = bs->parent;
+									do{
+										{
+											std::lock_guard<std::mutex> lock( mutex );
+											if( !( backTrackStart && backTrackStart->parent ) ){
+												break;
+											}
+											setNodeBounds( mip, nodeplex, tmplbounds, tmpubounds, touched, reset, backTrackStart->parent, &branch );
+										}
+
+										bool success = nodeplex.opt() != 0;
+										{
+											std::lock_guard<std::mutex> lock( mutex );
+											if( !success && !allSolutions && optimalAssignment.size() && nodeplex.getObj() > optimalValue ){
+												success = true;
+											}
+											if( success ){
+												++branchPriorities[branch.var];
+											}
+										}
+
+										if( success ){
+											#ifndef TO_DISABLE_OUTPUT
+												std::cout << "Success" << std::endl;
+											#endif
+										} else {
+											#ifndef TO_DISABLE_OUTPUT
+												std::cout << "No success" << std::endl;
+											#endif
+											break;
+										}
+									} while( ( backTrackStart = backTrackStart->parent ) );
+
+									if( backTrackStart != bs->parent ){
+										// Andere Schranke!!!
+										const BoundChange<T, TInt> opposite{ branch.var, !branch.upper, branch.upper ? branch.bound + T( 1 ) : branch.bound - T( 1 ) };
+										std::lock_guard<std::mutex> lock( mutex );
+										backTrackStart->changes.push_back( opposite );
+
+										// TODO Objval-Schranke anpassen?
+									}
+								} else {
+									// TODO: Kommt das noch vor?
+									#ifndef TO_DISABLE_OUTPUT
+										std::cout << "No backtracking." << std::endl;
+									#endif
+								}
 
-				}
-			} else {
-				// TODO: Kommt das noch vor?
-				#ifndef TO_DISABLE_OUTPUT
-					std::cout << "No backtracking." << std::endl;
-				#endif
-			}
+								std::lock_guard<std::mutex> lock( mutex );
+								delete bs;
+								break;
+							}
 
-			delete bs;
-			continue;
+							objval = nodeplex.getObj();
 
-		}
+							{
+								std::lock_guard<std::mutex> lock( mutex );
+								if( !allSolutions && optimalAssignment.size() && objval >= optimalValue ){
+									#ifndef TO_DISABLE_OUTPUT
+										std::cout << "Cutoff 2: " << TOmath<T>::toShortString( objval ) << " / " << TOmath<T>::toShortString( optimalValue ) << std::endl;
+									#endif
+									delete bs;
+									break;
+								}
+							}
 
-		T objval = plex.getObj();
+							x = nodeplex.getX();
+							std::vector<TInt> candidates;
+							for( TInt i = 0; i < n; ++i ){
+								if( mip.numbersystems[i] != 'R' && !TOmath<T>::isInt( x[i] ) ){
+									candidates.push_back( i );
+								}
+							}
 
-		if( !allSolutions && optimalAssignment.size() && objval >= optimalValue ){
-			#ifndef TO_DISABLE_OUTPUT
-				std::cout << "Cutoff 2: " << TOmath<T>::toShortString( objval ) << " / " << TOmath<T>::toShortString( optimalValue ) << std::endl;
-			#endif
-			delete bs;
-			continue;
-		}
+							if( allSolutions && candidates.empty() ){
+								for( TInt i = 0; i < n; ++i ){
+									if( mip.numbersystems[i] != 'R' && tmplbounds[i] != tmpubounds[i] ){
+										x[i] = tmplbounds[i] + ( T(1) / T(2) );
+										candidates.push_back( i );
+									}
+								}
+							}
 
-		TInt branchVar = -1;
-		std::vector<T> x = plex.getX();
-		for( TInt i = 0; i < n; ++i ){
-			if( mip.numbersystems[i] != 'R' && !TOmath<T>::isInt( x[i] ) ){
-//				cout << "x" << i << " = " << TOmath<T>::toShortString( x[i] ) << " fractional. Branching." << endl;
-				if( branchVar == -1 || branchPriorities[i] > branchPriorities[branchVar] ){
-					branchVar = i;
-				}
-			}
-		}
+							std::lock_guard<std::mutex> lock( mutex );
+							for( const TInt i : candidates ){
+								if( branchVar == -1 || branchPriorities[i] > branchPriorities[branchVar] ){
+									branchVar = i;
+								}
+							}
 
-		if( allSolutions && branchVar == -1 ){
-			for( TInt i = 0; i < n; ++i ){
-				if( mip.numbersystems[i] != 'R' && tmplbounds[i] != tmpubounds[i] ){
-					x[i] = tmplbounds[i] + ( T(1) / T(2) );
-//					cout << "x" << i << " = " << TOmath<T>::toShortString( x[i] ) << " forced fractional. Branching." << endl;
-					if( branchVar == -1 || branchPriorities[i] > branchPriorities[branchVar] ){
-						branchVar = i;
+							if( branchVar == -1 ){
+								if( optimalAssignment.size() == 0 || optimalValue > objval ){
+									optimalValue = objval;
+									optimalAssignment = x;
+									++incumbentVersion;
+								}
+								if( allAssignments ){
+									allAssignments->push_back( x );
+								}
+								#ifndef TO_DISABLE_OUTPUT
+									std::cout << "found incumbent: " << TOmath<T>::toShortString( mip.maximize ? - objval : objval ) << std::endl;
+								#endif
+								if( bs->parent && bs->parent->changes.size() == 1 ){
+									branchPriorities[bs->changes[0].var] += 10;
+								}
+								++numsol;
+								delete bs;
+							} else {
+								queue.push( new BnBNode<T, TInt>( bs, 1, branchVar, 1, TOmath<T>::floor( x[branchVar] ), objval, objval, bs->depth + 1 ) );
+								queue.push( new BnBNode<T, TInt>( bs, 2, branchVar, 0, TOmath<T>::ceil( x[branchVar] ), objval, objval, bs->depth + 1 ) );
+							}
+						} while( false );
+					} catch( ... ){
+						fail( std::current_exception() );
 					}
-				}
-			}
-		}
 
-		if( branchVar == -1 ){
-			if( optimalAssignment.size() == 0 || optimalValue > objval ){
-				optimalValue = objval;
-				if( !allSolutions ){
-					plex.setInfeasibilityBound( optimalValue );
+					{
+						std::lock_guard<std::mutex> lock( mutex );
+						--activeWorkers;
+					}
+					wakeup.notify_all();
 				}
-				optimalAssignment = plex.getX();
-			}
-			if( allAssignments ){
-				allAssignments->push_back( plex.getX() );
-			}
-			#ifndef TO_DISABLE_OUTPUT
-				std::cout << "found incumbent: " << TOmath<T>::toShortString( mip.maximize ? - objval : objval ) << std::endl;
-			#endif
-			if( bs->parent && bs->parent->vars.size() == 1 ){
-				branchPriorities[bs->vars[0]] += 10;
+			} catch( ... ){
+				fail( std::current_exception() );
 			}
-//			{
-//				std::vector<T> incumbent = plex.getX();
-//				std::cout << "x =";
-//				for( unsigned int i = 0; i < incumbent.size(); ++i ){
-//					std::cout << " " << TOmath<T>::toShortString( incumbent[i] );
-//				}
-//				std::cout << std::endl;
-//			}
-			++numsol;
-			delete bs;
-		} else {
-			queue.push( new BnBNode<T, TInt>( bs, 1, branchVar, 1, TOmath<T>::floor( x[branchVar] ), objval, objval, bs->depth + 1 ) );
-			queue.push( new BnBNode<T, TInt>( bs, 2, branchVar, 0, TOmath<T>::ceil( x[branchVar] ), objval, objval, bs->depth + 1 ) );
 		}
+	}
 
+	// nur nach einem Fehler bleiben Knoten übrig; der Baum ist dann womöglich inkonsistent, Fehler beim Abbau zählen nicht mehr
+	while( !queue.empty() ){
+		try{
+			delete queue.top();
+		} catch( ... ){
+		}
+		queue.pop();
+	}
+	if( error ){
+		std::rethrow_exception( error );
 	}
 
 	if( optimalAssignment.size() ){
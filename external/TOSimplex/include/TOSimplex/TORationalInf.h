@@ -23,6 +23,7 @@ class TORationalInf
 {
 	public:
 		TORationalInf( bool isInf_ = false ):
+			value(),
 			isInf( isInf_ ){}
 
 		TORationalInf( const T& value_ ):
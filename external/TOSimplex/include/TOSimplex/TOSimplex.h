@@ -36,6 +36,8 @@ class TOSolver
 	public:
 		TOSolver();
 		TOSolver( const std::vector<T> &rows, const std::vector<TInt> &colinds, const std::vector<TInt> &rowbegininds, const std::vector<T> &obj, const std::vector<TORationalInf<T> > &rowlowerbounds, const std::vector<TORationalInf<T> > &rowupperbounds, const std::vector<TORationalInf<T> > &varlowerbounds, const std::vector<TORationalInf<T> > &varupperbounds );
+		TOSolver( const TOSolver<T, TInt>& other );
+		TOSolver<T, TInt>& operator=( const TOSolver<T, TInt>& other ) = delete;
 		~TOSolver();
 		void addConstraint( const std::vector<T> vec, const TORationalInf<T>& lbound, const TORationalInf<T>& ubound );
 		void removeConstraint( TInt index );
@@ -53,6 +55,8 @@ class TOSolver
 		void setInexactFarkasInfeasibilityGuess( std::vector<double> ray );
 		std::vector<T> getFarkasInfeasibilityProof();
 		void setInfeasibilityBound( TORationalInf<T> bound );
+		void setIterationLimit( TInt limit );
+		void setTolerance( T tol );
 		TInt opt();
 		std::vector<T> getX();
 		std::vector<T> getY();
@@ -155,6 +159,20 @@ class TOSolver
 
 		TORationalInf<T> infeasibilityBound;
 
+		TInt iterationLimit;
+		TInt iterationCount;
+
+		// Toleranzen nur für inexakte Datentypen
+		bool hasTolerance;
+		T tolerance;
+		T negTolerance;
+
+		inline bool isPos( const T& a ) const { return this->hasTolerance ? a > this->tolerance : a > 0; }
+		inline bool isNeg( const T& a ) const { return this->hasTolerance ? a < this->negTolerance : a < 0; }
+		inline bool isNonZero( const T& a ) const { return this->hasTolerance ? a > this->tolerance || a < this->negTolerance : a != 0; }
+		inline bool isBelow( const T& a, const T& b ) const { return this->hasTolerance ? a < b + this->negTolerance : a < b; }
+		inline bool isAbove( const T& a, const T& b ) const { return this->hasTolerance ? a > b + this->tolerance : a > b; }
+
 		void copyTransposeA( TInt orgLen, const std::vector<T>& orgVal, const std::vector<TInt>& orgInd, const std::vector<TInt>& orgPointer, TInt newLen, std::vector<T>& newVal, std::vector<TInt>& newInd, std::vector<TInt>& newPointer );
 		void mulANT( T* result, T* vector );
 
@@ -279,6 +297,68 @@ TOSolver<T, TInt>::TOSolver( const std::vector<T> &rows, const std::vector<TInt>
 }
 
 
+// Kopie, z.B. für parallele Branch-and-Bound-Threads. Die Schranken-Zeiger zeigen auf die eigenen Vektoren,
+// daher darf nicht während opt() kopiert werden.
+template <class T, class TInt>
+TOSolver<T, TInt>::TOSolver( const TOSolver<T, TInt>& other ):
+	Acolwise( other.Acolwise ),
+	Acolwiseind( other.Acolwiseind ),
+	Acolpointer( other.Acolpointer ),
+	Arowwise( other.Arowwise ),
+	Arowwiseind( other.Arowwiseind ),
+	Arowpointer( other.Arowpointer ),
+	c( other.c ),
+	lvec( other.lvec ),
+	uvec( other.uvec ),
+	l( lvec.data() ),
+	u( uvec.data() ),
+	x( other.x ),
+	d( other.d ),
+	m( other.m ),
+	n( other.n ),
+	hasBase( other.hasBase ),
+	hasBasisMatrix( other.hasBasisMatrix ),
+	baseIter( other.baseIter ),
+	B( other.B ),
+	Binv( other.Binv ),
+	N( other.N ),
+	Ninv( other.Ninv ),
+	Urlen( other.Urlen ),
+	Urbeg( other.Urbeg ),
+	Urval( other.Urval ),
+	Ucind( other.Ucind ),
+	Ucptr( other.Ucptr ),
+	Ucfreepos( other.Ucfreepos ),
+	Uclen( other.Uclen ),
+	Ucbeg( other.Ucbeg ),
+	Ucval( other.Ucval ),
+	Urind( other.Urind ),
+	Urptr( other.Urptr ),
+	Letas( other.Letas ),
+	Lind( other.Lind ),
+	Llbeg( other.Llbeg ),
+	Lnetaf( other.Lnetaf ),
+	Lneta( other.Lneta ),
+	Letapos( other.Letapos ),
+	halfNumUpdateLetas( other.halfNumUpdateLetas ),
+	perm( other.perm ),
+	permback( other.permback ),
+	DSE( other.DSE ),
+	DSEtmp( other.DSEtmp ),
+	antiCycle( other.antiCycle ),
+	hasPerturbated( other.hasPerturbated ),
+	rayGuess( other.rayGuess ),
+	farkasProof( other.farkasProof ),
+	lastLeavingBaseVar( other.lastLeavingBaseVar ),
+	infeasibilityBound( other.infeasibilityBound ),
+	iterationLimit( other.iterationLimit ),
+	iterationCount( other.iterationCount ),
+	hasTolerance( other.hasTolerance ),
+	tolerance( other.tolerance ),
+	negTolerance( other.negTolerance )
+{}
+
+
 template <class T, class TInt>
 TOSolver<T, TInt>::~TOSolver(){
 
@@ -302,6 +382,13 @@ void TOSolver<T, TInt>::init(){
 	this->hasPerturbated = false;
 
 	this->infeasibilityBound = true;
+
+	this->iterationLimit = -1;
+	this->iterationCount = 0;
+
+	this->hasTolerance = false;
+	this->tolerance = 0;
+	this->negTolerance = 0;
 }
 
 
@@ -760,6 +847,24 @@ void TOSolver<T, TInt>::setInfeasibilityBound( TORationalInf<T> bound ){
 }
 
 
+// Maximale Anzahl Iterationen je Aufruf von opt(), negativ = unbeschränkt.
+// Bei Erreichen des Limits liefert opt() den Wert 4.
+template <class T, class TInt>
+void TOSolver<T, TInt>::setIterationLimit( TInt limit ){
+	this->iterationLimit = limit;
+}
+
+
+// Toleranz für Zulässigkeitstests und Pivotelemente, nur für Gleitkommatypen sinnvoll.
+// Mit tol = 0 wird exakt verglichen.
+template <class T, class TInt>
+void TOSolver<T, TInt>::setTolerance( T tol ){
+	this->hasTolerance = tol > 0;
+	this->tolerance = tol;
+	this->negTolerance = -tol;
+}
+
+
 template <class T, class TInt>
 void TOSolver<T, TInt>::mulANT( T* result, T* vector ){
 	for( TInt i = 0; i < m; ++i ){
@@ -1232,8 +1337,9 @@ bool TOSolver<T, TInt>::refactor(){
 
 		this->findPiv( Urowind, Ucolind, PP, QQ, PPa, QQa, nnzCs, nnzRs, p, q, colsingleton );
 
+		// Basismatrix singulär, kann nur bei einer über setBase vorgegebenen Basis passieren.
 		if( p == -1 || q == -1 ){
-			throw std::runtime_error( "This should not happen. Basis matrix singular! Contact author." );
+			return false;
 		}
 
 
@@ -1325,7 +1431,7 @@ bool TOSolver<T, TInt>::refactor(){
 						bilist* QQn = QQ;
 						do {
 							TInt j = QQn->val;
-							if( Up[j] != 0 ){
+							if( isNonZero( Up[j] ) ){
 								Ui[j] += L * Up[j];
 								Uiind[Uilen++] = j;
 								Uidone[j] = false;	// Dieser Wert muss ersetzt werden
@@ -1339,7 +1445,7 @@ bool TOSolver<T, TInt>::refactor(){
 					for( TInt ll = 0; ll < static_cast<TInt>( Urow[i].size() ); ++ll ){
 						TInt j = Ucolind[i][ll];
 						if( !Uidone[j] ){
-							if( Ui[j] == 0 ){
+							if( !isNonZero( Ui[j] ) ){
 								TInt cptr = Ucolptr[i][ll];
 
 								// Letztes Element der Zeile an diese Position holen, Zeile um 1 kürzen
@@ -1384,7 +1490,7 @@ bool TOSolver<T, TInt>::refactor(){
 
 					for( TInt ll = 0; ll < Uilen; ++ll ){
 						TInt j = Uiind[ll];
-						if( !Uidone[j] && Ui[j] != 0 ){
+						if( !Uidone[j] && isNonZero( Ui[j] ) ){
 
 							// Zeilen- und Spaltenende ermitteln, Längen anpassen
 							const TInt rowend = Ucolind[i].size();
@@ -1696,7 +1802,7 @@ void TOSolver<T, TInt>::updateB( TInt r, T* permSpike, TInt* permSpikeInd, TInt*
 	for( TInt k = t+1; k < m; ++k ){
 		TInt i = this->perm[k];
 
-		if( Ur[i] != 0 ){
+		if( isNonZero( Ur[i] ) ){
 			T L = - Ur[i] / this->Urval[Urbeg[i]];
 			this->Letas[this->Llbeg[this->Lneta]] = L;
 			this->Lind[this->Llbeg[this->Lneta]++] = i;
@@ -1773,7 +1879,10 @@ TInt TOSolver<T, TInt>::phase1(){
 	TInt retval = -1;
 
 	// Phase 1 - Problem lösen
-	if( this->opt( true ) >= 0 ){
+	const TInt p1optretval = this->opt( true );
+	if( p1optretval == -2 ){
+		retval = -2;
+	} else if( p1optretval >= 0 ){
 		// Zielfunktionswert bestimmen	// TODO später auslesen, falls wir den Wert zwischenspeichern/zurückgeben?
 		T Z( 0 );
 		for( TInt i = 0; i < n; ++i ){
@@ -1871,6 +1980,8 @@ TInt TOSolver<T, TInt>::opt(){
 		clock_t fulltime = clock();
 	#endif
 
+	this->iterationCount = 0;
+
 	if( !this->hasBase || ( !this->hasBasisMatrix && !this->refactor() ) ){
 
 		// DSE-Gewichte für logische Basis initialisieren.
@@ -1944,12 +2055,45 @@ TInt TOSolver<T, TInt>::opt(){
 		}
 	} while( retval == -1 );
 
+	// Bei inexakter Arithmetik sammeln sich in der aktualisierten Faktorisierung Rundungsfehler an.
+	// Daher neu faktorisieren, x und d neu berechnen und Optimalität erneut prüfen.
+	if( this->hasTolerance ){
+		for( TInt refinement = 0; retval == 0 && refinement < 5; ++refinement ){
+			if( this->DSE.size() ){
+				for( TInt i = 0; i < m; ++i ){
+					this->DSEtmp[B[i]] = this->DSE[i];
+				}
+			}
+			this->removeBasisFactorization();
+			if( !this->refactor() ){
+				break;
+			}
+			if( this->DSE.size() ){
+				for( TInt i = 0; i < m; ++i ){
+					this->DSE[i] = this->DSEtmp[B[i]];
+				}
+			}
+
+			// Ohne Basiswechsel zählt opt( false ) genau zwei Iterationen.
+			const TInt iterationsBefore = this->iterationCount;
+			retval = this->opt( false );
+			if( this->iterationCount - iterationsBefore <= 2 ){
+				break;
+			}
+		}
+	}
+
 
 	#ifndef TO_DISABLE_OUTPUT
 		std::cout << "Zeit externer Löser (sofern eingebunden): " << externalTime / (double) CLOCKS_PER_SEC << std::endl;
 		std::cout << "Optimierungszeit: " << ( ( clock() - fulltime ) / (double) CLOCKS_PER_SEC ) << " Sekunden" << std::endl;
 	#endif
 
+	// Iterationslimit erreicht, aktuelle Basis ist weder optimal noch ein Unzulässigkeitsnachweis.
+	if( retval == -2 ){
+		return 4;
+	}
+
 	if( !retval ){
 		this->rayGuess.clear();
 		this->farkasProof.clear();
@@ -1987,6 +2131,10 @@ TInt TOSolver<T, TInt>::opt( bool P1 ){
 
 	do {
 
+		if( ++this->iterationCount > this->iterationLimit && this->iterationLimit >= 0 ){
+			return -2;
+		}
+
 		// Nichtbasisvariablen in ihre Schranken weißen!
 		for( TInt i = 0; i < n; ++i ){
 			const TInt j = this->N[i];
@@ -2057,10 +2205,10 @@ TInt TOSolver<T, TInt>::opt( bool P1 ){
 			for( TInt i = 0; i < n; ++i ){
 				const TInt j = this->N[i];
 				if( !l[j].isInf && !u[j].isInf && l[j].value != u[j].value ){
-					if( x[j] == l[j].value && d[i] < 0 ){
+					if( x[j] == l[j].value && isNeg( d[i] ) ){
 						x[j] = u[j].value;
 						dfcdone = true;
-					} else if( x[j] == u[j].value && d[i] > 0 ){
+					} else if( x[j] == u[j].value && isPos( d[i] ) ){
 						x[j] = l[j].value;
 						dfcdone = true;
 					}
@@ -2081,15 +2229,15 @@ TInt TOSolver<T, TInt>::opt( bool P1 ){
 				if( !l[j].isInf && !u[j].isInf && l[j].value == u[j].value ){
 					continue;
 				}
-				if( !l[j].isInf && l[j].value == x[j] && d[i] < 0 ){
+				if( !l[j].isInf && l[j].value == x[j] && isNeg( d[i] ) ){
 					feas = false;
 					break;
 				}
-				if( !u[j].isInf && u[j].value == x[j] && d[i] > 0 ){
+				if( !u[j].isInf && u[j].value == x[j] && isPos( d[i] ) ){
 					feas = false;
 					break;
 				}
-				if( l[j].isInf && u[j].isInf && x[j] == 0 && d[i] != 0 ){
+				if( l[j].isInf && u[j].isInf && x[j] == 0 && ( isPos( d[i] ) || isNeg( d[i] ) ) ){
 					feas = false;
 					break;
 				}
@@ -2109,8 +2257,8 @@ TInt TOSolver<T, TInt>::opt( bool P1 ){
 					#endif
 					return 2;
 				}
-				if( p1retval == -1 ){
-					return -1;
+				if( p1retval < 0 ){
+					return p1retval;
 				}
 
 				#ifndef TO_DISABLE_OUTPUT
@@ -2160,6 +2308,10 @@ TInt TOSolver<T, TInt>::opt( bool P1 ){
 
 	while( true ){
 
+		if( ++this->iterationCount > this->iterationLimit && this->iterationLimit >= 0 ){
+			return -2;
+		}
+
 		#ifndef TO_DISABLE_OUTPUT
 			clock_t oldtime = itertime;
 			itertime = clock();
@@ -2232,9 +2384,9 @@ TInt TOSolver<T, TInt>::opt( bool P1 ){
 			for( TInt i = 0; i < m; ++i ){
 				const TInt b = this->B[i];
 				T deltai( 0 );
-				if( !this->l[b].isInf && this->x[b] < this->l[b].value ){
+				if( !this->l[b].isInf && isBelow( this->x[b], this->l[b].value ) ){
 					deltai =  this->l[b].value - this->x[b];
-				} else if( !this->u[b].isInf && this->x[b] > this->u[b].value ){
+				} else if( !this->u[b].isInf && isAbove( this->x[b], this->u[b].value ) ){
 					deltai = this->u[b].value - this->x[b];
 				}
 				if( deltai != 0 ){
@@ -2251,10 +2403,10 @@ TInt TOSolver<T, TInt>::opt( bool P1 ){
 			for( TInt i = 0; i < m; ++i ){
 				const TInt b = this->B[i];
 				if( b < p ){
-					if( !this->l[b].isInf && this->x[b] < this->l[b].value ){
+					if( !this->l[b].isInf && isBelow( this->x[b], this->l[b].value ) ){
 						r = i;
 						p = b;
-					} else if( !this->u[b].isInf && this->x[b] > this->u[b].value ){
+					} else if( !this->u[b].isInf && isAbove( this->x[b], this->u[b].value ) ){
 						r = i;
 						p = b;
 					}
@@ -2270,7 +2422,7 @@ TInt TOSolver<T, TInt>::opt( bool P1 ){
 		} else {
 
 			delta = x[p];
-			if( !this->l[p].isInf && this->x[p] < this->l[p].value ){
+			if( !this->l[p].isInf && isBelow( this->x[p], this->l[p].value ) ){
 				delta -= this->l[p].value;
 				ratioNeg = true;
 			} else {
@@ -2366,14 +2518,18 @@ TInt TOSolver<T, TInt>::opt( bool P1 ){
 					for( TInt i = 0; i < n; ++i ){
 						TInt j = this->N[i];
 						if(
-								( this->l[j].isInf && this->u[j].isInf && alphartilde[i] != 0 )
-								|| ( ( this->u[j].isInf || this->u[j].value != this->x[j] ) && !this->l[j].isInf && this->x[j] == this->l[j].value && alphartilde[i] > 0 )
-								|| ( ( this->l[j].isInf || this->l[j].value != this->x[j] ) && !this->u[j].isInf && this->x[j] == this->u[j].value && alphartilde[i] < 0 )
+								( this->l[j].isInf && this->u[j].isInf && ( isPos( alphartilde[i] ) || isNeg( alphartilde[i] ) ) )
+								|| ( ( this->u[j].isInf || this->u[j].value != this->x[j] ) && !this->l[j].isInf && this->x[j] == this->l[j].value && isPos( alphartilde[i] ) )
+								|| ( ( this->l[j].isInf || this->l[j].value != this->x[j] ) && !this->u[j].isInf && this->x[j] == this->u[j].value && isNeg( alphartilde[i] ) )
 						){
 
 							Qind[Qlen] = i;
 							Qord[Qlen] = Qlen;
 							Q[Qlen] = d[i] / alphartilde[i];
+							// Rundungsfehler dürfen keine negativen Quotienten erzeugen
+							if( this->hasTolerance && Q[Qlen] < 0 ){
+								Q[Qlen] = 0;
+							}
 							++Qlen;
 
 						}
@@ -2555,6 +2711,10 @@ TInt TOSolver<T, TInt>::opt( bool P1 ){
 							if( i != r ) {
 								mult = alphaq[i] / alphaq[r];
 								this->DSE[i] += - 2 * mult * tau[i] + mult * mult * betar;
+								// Rundungsfehler: Gewichte nach unten beschränken, sonst werden Zeilen beim Pricing übersehen
+								if( this->hasTolerance && !( this->DSE[i] >= mult * mult + this->tolerance ) ){
+									this->DSE[i] = mult * mult + this->tolerance;
+								}
 							}
 						}
 					}
@@ -2574,6 +2734,11 @@ TInt TOSolver<T, TInt>::opt( bool P1 ){
 		this->Ninv[p] = s;
 		this->Ninv[q] = -1;
 
+		// Rundungsfehler: die Basis verlassende Variable muss exakt auf ihrer Schranke liegen
+		if( this->hasTolerance ){
+			x[p] = ratioNeg ? l[p].value : u[p].value;
+		}
+
 
 		if( ++this->baseIter % this->halfNumUpdateLetas ){
 			this->updateB( r, permSpike.data(), permSpikeInd.data(), &permSpikeLen );
@@ -2586,7 +2751,9 @@ TInt TOSolver<T, TInt>::opt( bool P1 ){
 				}
 			}
 
-			this->refactor();
+			if( !this->refactor() ){
+				throw std::runtime_error( "This should not happen. Basis matrix singular! Contact author." );
+			}
 
 			// DSE für permutierte Basis zurückholen
 			if( this->DSE.size() ){
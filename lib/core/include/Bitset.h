@@ -751,6 +751,9 @@ public:
 /// See incl(GenericSet,GenericSet)
 Int incl(const Bitset& s1, const Bitset& s2) noexcept;
 
+/// Size of the intersection, computed without creating it.
+Int intersection_size(const Bitset& s1, const Bitset& s2) noexcept;
+
 template <typename TSet>
 std::enable_if_t<!std::is_same<TSet, Bitset>::value, Bitset&>
 Bitset::operator*= (const GenericSet<TSet, Int, element_comparator>& s)
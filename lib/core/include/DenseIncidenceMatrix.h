@@ -0,0 +1,162 @@
+/* Copyright (c) 1997-2020
+   Ewgenij Gawrilow, Michael Joswig, and the polymake team
+   Technische Universität Berlin, Germany
+   https://polymake.org
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version: http://www.gnu.org/licenses/gpl.txt.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+--------------------------------------------------------------------------------
+*/
+
+/** @file DenseIncidenceMatrix.h
+    @brief Implementation of pm::DenseIncidenceMatrix class
+*/
+
+#ifndef POLYMAKE_DENSE_INCIDENCE_MATRIX_H
+#define POLYMAKE_DENSE_INCIDENCE_MATRIX_H
+
+#include "polymake/IncidenceMatrix.h"
+#include "polymake/Bitset.h"
+#include <vector>
+
+namespace pm {
+
+/** @class DenseIncidenceMatrix
+    @brief Incidence matrix stored as bit sets, both row- and columnwise.
+
+    An alternative representation of an IncidenceMatrix for dense incidence relations,
+    e.g. VERTICES_IN_FACETS of simplicial polytopes.  An entry costs two bits instead of a node
+    of two AVL trees, and rows and columns are intersected, compared, and counted word by word.
+
+    Rows and columns are Bitsets and can be used wherever a set is expected.
+    Changes of single elements keep both representations in sync.
+    Objects of this class are working copies for algorithms; they are not meant to be stored in big objects.
+*/
+class DenseIncidenceMatrix {
+public:
+   /// Create an empty matrix.
+   DenseIncidenceMatrix() {}
+
+   /// Create a matrix with @a r rows and @a c columns initialized with zeroes.
+   DenseIncidenceMatrix(Int r, Int c)
+      : row_bits(r, Bitset(c))
+      , col_bits(c, Bitset(r)) {}
+
+   template <typename TMatrix>
+   explicit DenseIncidenceMatrix(const GenericIncidenceMatrix<TMatrix>& M)
+      : DenseIncidenceMatrix(M.rows(), M.cols())
+   {
+      for (auto r = entire<indexed>(pm::rows(M)); !r.at_end(); ++r)
+         for (auto e = entire(*r); !e.at_end(); ++e)
+            insert(r.index(), *e);
+   }
+
+   /** Whether the dense representation pays off for the given matrix:
+       intersecting two lines word by word is faster than merging two trees
+       as soon as there is more than one incidence in 64 bits on average.
+   */
+   template <typename TMatrix>
+   static bool is_dense(const GenericIncidenceMatrix<TMatrix>& M)
+   {
+      Int n_entries = 0;
+      for (auto r = entire(pm::rows(M)); !r.at_end(); ++r)
+         n_entries += r->size();
+      return n_entries * 64 >= M.rows() * M.cols();
+   }
+
+   Int rows() const { return row_bits.size(); }
+   Int cols() const { return col_bits.size(); }
+
+   bool operator() (Int i, Int j) const { return row_bits[i].contains(j); }
+
+   void insert(Int i, Int j)
+   {
+      row_bits[i] += j;
+      col_bits[j] += i;
+   }
+
+   void erase(Int i, Int j)
+   {
+      row_bits[i] -= j;
+      col_bits[j] -= i;
+   }
+
+   const Bitset& row(Int i) const { return row_bits[i]; }
+   const Bitset& col(Int j) const { return col_bits[j]; }
+
+   const std::vector<Bitset>& get_rows() const { return row_bits; }
+   const std::vector<Bitset>& get_cols() const { return col_bits; }
+
+   /// Number of columns incident to both rows.
+   Int rows_intersection_size(Int i1, Int i2) const { return intersection_size(row_bits[i1], row_bits[i2]); }
+
+   /// Number of rows incident to both columns.
+   Int cols_intersection_size(Int j1, Int j2) const { return intersection_size(col_bits[j1], col_bits[j2]); }
+
+   /// Intersection of the selected rows; all columns if none is selected.
+   template <typename TSet>
+   Bitset rows_intersection(const GenericSet<TSet, Int>& row_indices) const
+   {
+      return lines_intersection(row_bits, row_indices.top(), cols());
+   }
+
+   /// Intersection of the selected columns; all rows if none is selected.
+   template <typename TSet>
+   Bitset cols_intersection(const GenericSet<TSet, Int>& col_indices) const
+   {
+      return lines_intersection(col_bits, col_indices.top(), rows());
+   }
+
+   IncidenceMatrix<> to_incidence_matrix() const
+   {
+      return IncidenceMatrix<>(rows(), cols(), row_bits.begin());
+   }
+
+   bool operator== (const DenseIncidenceMatrix& M) const { return row_bits == M.row_bits; }
+   bool operator!= (const DenseIncidenceMatrix& M) const { return !operator==(M); }
+
+   void swap(DenseIncidenceMatrix& M)
+   {
+      row_bits.swap(M.row_bits);
+      col_bits.swap(M.col_bits);
+   }
+
+protected:
+   template <typename TSet>
+   static Bitset lines_intersection(const std::vector<Bitset>& lines, const TSet& indices, Int dim)
+   {
+      auto i = entire(indices);
+      if (i.at_end()) return Bitset(sequence(0, dim));
+      Bitset result(lines[*i]);
+      for (++i; !i.at_end() && !result.empty(); ++i)
+         result *= lines[*i];
+      return result;
+   }
+
+   std::vector<Bitset> row_bits, col_bits;
+};
+
+} // end namespace pm
+
+namespace polymake {
+   using pm::DenseIncidenceMatrix;
+}
+
+namespace std {
+   inline void swap(pm::DenseIncidenceMatrix& M1, pm::DenseIncidenceMatrix& M2) { M1.swap(M2); }
+}
+
+#endif // POLYMAKE_DENSE_INCIDENCE_MATRIX_H
+
+// Local Variables:
+// mode:C++
+// c-basic-offset:3
+// indent-tabs-mode:nil
+// End:
@@ -463,7 +463,7 @@ public:
    {
       if (__builtin_expect(isfinite(*this), 1)) {
          if (__builtin_expect(isfinite(b), 1))
-            mpz_add(this, this, &b);
+            add_finite(this, this, &b);
          else
             set_inf(this, b);
       } else {
@@ -479,7 +479,7 @@ public:
       Integer result;
       if (__builtin_expect(isfinite(a), 1)) {
          if (__builtin_expect(isfinite(b), 1))
-            mpz_add(&result, &a, &b);
+            add_finite(&result, &a, &b);
          else
             set_inf(&result, b);
       } else {
@@ -572,7 +572,7 @@ public:
    {
       if (__builtin_expect(isfinite(*this), 1)) {
          if (__builtin_expect(isfinite(b), 1))
-            mpz_sub(this, this, &b);
+            sub_finite(this, this, &b);
          else
             set_inf(this, -1, b);
       } else {
@@ -588,7 +588,7 @@ public:
       Integer result;
       if (__builtin_expect(isfinite(a), 1)) {
          if (__builtin_expect(isfinite(b), 1))
-            mpz_sub(&result, &a, &b);
+            sub_finite(&result, &a, &b);
          else
             set_inf(&result, -1, b);
       } else {
@@ -683,7 +683,7 @@ public:
    {
       if (__builtin_expect(isfinite(*this), 1)) {
          if (__builtin_expect(isfinite(b), 1))
-            mpz_mul(this, this, &b);
+            mul_finite(this, this, &b);
          else
             set_inf(this, mpz_sgn(this), b);
       } else {
@@ -698,7 +698,7 @@ public:
       Integer result;
       if (__builtin_expect(isfinite(a), 1)) {
          if (__builtin_expect(isfinite(b), 1))
-            mpz_mul(&result, &a, &b);
+            mul_finite(&result, &a, &b);
          else
             set_inf(&result, mpz_sgn(&a), b);
       } else {
@@ -1128,7 +1128,7 @@ public:
    Int compare(const Integer& b) const
    {
       if (__builtin_expect(isfinite(*this) && isfinite(b), 1))
-         return mpz_cmp(this, &b);
+         return cmp_finite(this, &b);
       else
          return isinf(*this)-isinf(b);
    }
@@ -1535,6 +1535,81 @@ protected:
          me->_mp_size = -me->_mp_size;
    }
 
+   /* Fast paths for finite operands consisting of at most one limb.
+      Arithmetic on small values is processed inline, as long as the result fits into one limb
+      and the target has at least one limb allocated; otherwise the generic GMP routines take over.
+      Construction, assignment and destruction still go through mpz_init_set_si & Co. */
+
+   static bool fits_limb(mpz_srcptr a) noexcept
+   {
+      return GMP_NAIL_BITS == 0 && a->_mp_size >= -1 && a->_mp_size <= 1;
+   }
+
+   static mp_limb_t limb_of(mpz_srcptr a) noexcept
+   {
+      return a->_mp_size != 0 ? a->_mp_d[0] : 0;
+   }
+
+   // me = a + sign_b * b
+   static bool add_small(mpz_ptr me, mpz_srcptr a, int sign_b, mp_limb_t b) noexcept
+   {
+      if (me->_mp_alloc < 1) return false;
+      const int sign_a = a->_mp_size;
+      const mp_limb_t la = limb_of(a);
+      mp_limb_t r;
+      int sign_r;
+      if (sign_a == 0 || sign_b == 0) {
+         r = la | b;
+         sign_r = sign_a | sign_b;
+      } else if (sign_a == sign_b) {
+         if (__builtin_add_overflow(la, b, &r)) return false;
+         sign_r = sign_a;
+      } else if (la >= b) {
+         r = la - b;
+         sign_r = sign_a;
+      } else {
+         r = b - la;
+         sign_r = sign_b;
+      }
+      me->_mp_d[0] = r;
+      me->_mp_size = r != 0 ? sign_r : 0;
+      return true;
+   }
+
+   static void add_finite(mpz_ptr me, mpz_srcptr a, mpz_srcptr b)
+   {
+      if (!(fits_limb(a) && fits_limb(b) && add_small(me, a, b->_mp_size, limb_of(b))))
+         mpz_add(me, a, b);
+   }
+
+   static void sub_finite(mpz_ptr me, mpz_srcptr a, mpz_srcptr b)
+   {
+      if (!(fits_limb(a) && fits_limb(b) && add_small(me, a, -b->_mp_size, limb_of(b))))
+         mpz_sub(me, a, b);
+   }
+
+   static void mul_finite(mpz_ptr me, mpz_srcptr a, mpz_srcptr b)
+   {
+      mp_limb_t r;
+      if (fits_limb(a) && fits_limb(b) && me->_mp_alloc >= 1 && !__builtin_mul_overflow(limb_of(a), limb_of(b), &r)) {
+         const int sign_r = a->_mp_size * b->_mp_size;
+         me->_mp_d[0] = r;
+         me->_mp_size = sign_r;
+      } else {
+         mpz_mul(me, a, b);
+      }
+   }
+
+   static int cmp_finite(mpz_srcptr a, mpz_srcptr b) noexcept
+   {
+      if (fits_limb(a) && fits_limb(b)) {
+         if (a->_mp_size != b->_mp_size) return a->_mp_size - b->_mp_size;
+         const mp_limb_t la = limb_of(a), lb = limb_of(b);
+         return la == lb ? 0 : (la > lb) == (a->_mp_size > 0) ? 1 : -1;
+      }
+      return mpz_cmp(a, b);
+   }
+
    template <typename Src>
    void set_data(Src&& src, initialized st)
    {
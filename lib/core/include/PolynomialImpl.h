@@ -32,6 +32,7 @@
 
 #include <cassert>
 #include <forward_list>
+#include <algorithm>
 
 namespace pm {
 
@@ -209,6 +210,87 @@ private:
 };
 
 
+// Exponent vectors of multivariate monomials packed into a single machine word.
+// Each variable gets a bit field wide enough for its largest exponent in a product of two polynomials,
+// thus adding two packed words never carries from one field into the next one
+// and the integer order of the words is preserved under multiplication of monomials.
+template <typename Exponent>
+class packed_monomial_layout {
+public:
+  using word_type = uint64_t;
+
+  // Try to find a layout for all monomials of products of terms from h1 and h2.
+  // Fails for negative exponents and for too large exponents or numbers of variables.
+  template <typename Coefficient>
+  bool init(const hash_map<SparseVector<Exponent>, Coefficient>& h1,
+            const hash_map<SparseVector<Exponent>, Coefficient>& h2, const Int n_vars)
+  {
+    std::vector<Exponent> max1(n_vars, 0), max2(n_vars, 0);
+    if (!collect_max_exponents(h1, max1) || !collect_max_exponents(h2, max2))
+      return false;
+    Int total_bits = 0;
+    fields.clear();
+    for (Int i = 0; i < n_vars; ++i) {
+      if (max1[i] == 0 && max2[i] == 0) continue;
+      // both are less than 2^62, the sum can't overflow
+      const Int bits = bit_length(word_type(max1[i]) + word_type(max2[i]));
+      if ((total_bits += bits) > Int(sizeof(word_type) * 8))
+        return false;
+      fields.push_back(field{ i, int(total_bits - bits), (word_type(1) << bits) - 1 });
+    }
+    dim = n_vars;
+    return true;
+  }
+
+  word_type pack(const SparseVector<Exponent>& m) const
+  {
+    word_type w = 0;
+    auto f = fields.begin();
+    for (auto e = entire(m); !e.at_end(); ++e) {
+      while (f->var != e.index()) ++f;
+      w |= word_type(*e) << f->shift;
+    }
+    return w;
+  }
+
+  SparseVector<Exponent> unpack(word_type w) const
+  {
+    SparseVector<Exponent> m(dim);
+    for (const field& f : fields) {
+      if (const word_type e = (w >> f.shift) & f.mask)
+        m.push_back(f.var, Exponent(e));
+    }
+    return m;
+  }
+
+private:
+  template <typename Coefficient>
+  static bool collect_max_exponents(const hash_map<SparseVector<Exponent>, Coefficient>& h, std::vector<Exponent>& max_exp)
+  {
+    for (const auto& term : h) {
+      for (auto e = entire(term.first); !e.at_end(); ++e) {
+        if (*e < 0 || *e >= (Exponent(1) << 62)) return false;
+        assign_max(max_exp[e.index()], *e);
+      }
+    }
+    return true;
+  }
+
+  static Int bit_length(word_type x)
+  {
+    return sizeof(word_type) * 8 - __builtin_clzll(x);
+  }
+
+  struct field {
+    Int var;
+    int shift;
+    word_type mask;
+  };
+  // only variables occurring in the monomials, in increasing order
+  std::vector<field> fields;
+  Int dim = 0;
+};
+
 // Univariate and multivariate monomials
 // these don't actually contain any data, they just encode the basic functionality.
 template <typename Exponent>
@@ -273,6 +355,14 @@ struct UnivariateMonomial {
     result[new_variable_index == 0] = m;
     return result;
   }
+
+  // univariate polynomials don't profit from packing
+  template <typename Coefficient>
+  static bool multiply_packed(const hash_map<monomial_type, Coefficient>&, const hash_map<monomial_type, Coefficient>&,
+                              const Int, hash_map<monomial_type, Coefficient>&)
+  {
+    return false;
+  }
 };
 
 template <typename Exponent>
@@ -334,6 +424,86 @@ struct MultivariateMonomial {
     result.slice(~scalar2set(new_variable_index)) = m;
     return result;
   }
+
+  // Product of two polynomials computed on packed exponent vectors.
+  // Returns false if the monomials of the product don't fit into a machine word.
+  template <typename Coefficient>
+  static bool multiply_packed(const hash_map<monomial_type, Coefficient>& h1, const hash_map<monomial_type, Coefficient>& h2,
+                              const Int n_vars, hash_map<monomial_type, Coefficient>& prod)
+  {
+    return multiply_packed(h1, h2, n_vars, prod, bool_constant<std::numeric_limits<Exponent>::is_integer>());
+  }
+
+private:
+  template <typename Coefficient>
+  static bool multiply_packed(const hash_map<monomial_type, Coefficient>&, const hash_map<monomial_type, Coefficient>&,
+                              const Int, hash_map<monomial_type, Coefficient>&, std::false_type)
+  {
+    return false;
+  }
+
+  // Johnson's heap merge: every term of the shorter factor, multiplied with the terms of the longer one
+  // in increasing order of their packed monomials, yields a sorted stream of products.
+  // The streams are merged in a heap, so that equal monomials come in a row and are collected
+  // in a single coefficient; a result monomial is unpacked only once.
+  template <typename Coefficient>
+  static bool multiply_packed(const hash_map<monomial_type, Coefficient>& h1, const hash_map<monomial_type, Coefficient>& h2,
+                              const Int n_vars, hash_map<monomial_type, Coefficient>& prod, std::true_type)
+  {
+    if (h1.empty() || h2.empty()) return true;
+
+    packed_monomial_layout<Exponent> layout;
+    if (!layout.init(h1, h2, n_vars)) return false;
+
+    using word_type = typename packed_monomial_layout<Exponent>::word_type;
+    using packed_term = std::pair<word_type, const Coefficient*>;
+    const bool swapped = h2.size() < h1.size();
+    std::vector<packed_term> streams, sorted;
+    streams.reserve(std::min(h1.size(), h2.size()));
+    sorted.reserve(std::max(h1.size(), h2.size()));
+    for (const auto& term : swapped ? h2 : h1)
+      streams.emplace_back(layout.pack(term.first), &term.second);
+    for (const auto& term : swapped ? h1 : h2)
+      sorted.emplace_back(layout.pack(term.first), &term.second);
+    std::sort(sorted.begin(), sorted.end(),
+              [](const packed_term& a, const packed_term& b) { return a.first < b.first; });
+
+    struct heap_entry {
+      word_type monomial;
+      Int stream, pos;
+    };
+    const auto greater = [](const heap_entry& a, const heap_entry& b) { return a.monomial > b.monomial; };
+    std::vector<heap_entry> heap;
+    heap.reserve(streams.size());
+    for (Int i = 0, n = streams.size(); i < n; ++i)
+      heap.push_back(heap_entry{ streams[i].first + sorted.front().first, i, 0 });
+    std::make_heap(heap.begin(), heap.end(), greater);
+
+    const auto next_product = [&]() -> Coefficient {
+      std::pop_heap(heap.begin(), heap.end(), greater);
+      heap_entry& e = heap.back();
+      const Coefficient& c1 = *streams[e.stream].second;
+      const Coefficient& c2 = *sorted[e.pos].second;
+      Coefficient c = swapped ? c2 * c1 : c1 * c2;
+      if (++e.pos < Int(sorted.size())) {
+        e.monomial = streams[e.stream].first + sorted[e.pos].first;
+        std::push_heap(heap.begin(), heap.end(), greater);
+      } else {
+        heap.pop_back();
+      }
+      return c;
+    };
+
+    while (!heap.empty()) {
+      const word_type monomial = heap.front().monomial;
+      Coefficient c = next_product();
+      while (!heap.empty() && heap.front().monomial == monomial)
+        c += next_product();
+      if (!is_zero(c))
+        prod.emplace(layout.unpack(monomial), std::move(c));
+    }
+    return true;
+  }
 };
 
 template <typename T>
@@ -393,12 +563,14 @@ public:
 
   explicit GenericImpl(const Int n_vars = 0)
     : n_variables(n_vars)
-    , the_sorted_terms_set(false) {}
+    , the_sorted_terms_set(false)
+    , the_deg_set(false) {}
 
   template <typename T, typename = std::enable_if_t<fits_as_coefficient<T>::value>>
   GenericImpl(const T& c, const Int n_vars)
     : n_variables(n_vars)
     , the_sorted_terms_set(false)
+    , the_deg_set(false)
   {
     if (__builtin_expect(!is_zero(c), 1)) {
       the_terms.emplace(Monomial::default_value(n_variables), static_cast<coefficient_type>(c));
@@ -409,6 +581,7 @@ public:
   GenericImpl(const Container1& coefficients, const Container2& monomials, const Int n_vars)
     : n_variables(n_vars)
     , the_sorted_terms_set(false)
+    , the_deg_set(false)
   {
     if (POLYMAKE_DEBUG) {
       if (static_cast<size_t>(monomials.size()) != static_cast<size_t>(coefficients.size()))
@@ -422,7 +595,8 @@ public:
   GenericImpl(const term_hash& src, const Int n_vars)
     : n_variables(n_vars)
     , the_terms(src)
-    , the_sorted_terms_set(false) {}
+    , the_sorted_terms_set(false)
+    , the_deg_set(false) {}
                
   GenericImpl(const Int n_vars, const term_hash& src)
     : GenericImpl(src,n_vars) {}
@@ -514,9 +688,14 @@ public:
     return the_terms.exists(m);
   }
 
+  // kept until the monomials change, like the sorted terms
   typename Monomial::exponent_type deg() const
   {
-    return Monomial::deg(lm());
+    if (!the_deg_set) {
+      the_deg = Monomial::deg(lm());
+      the_deg_set = true;
+    }
+    return the_deg;
   }
 
   typename Monomial::exponent_type lower_deg() const
@@ -734,9 +913,11 @@ public:
   {
     croak_if_incompatible(p2);
     GenericImpl prod(n_variables);
-    for (const auto& term1 : the_terms)
-      for (const auto& term2 : p2.the_terms)
-        prod.add_term(term1.first + term2.first, term1.second * term2.second, std::true_type());
+    if (!Monomial::multiply_packed(the_terms, p2.the_terms, n_variables, prod.the_terms)) {
+      for (const auto& term1 : the_terms)
+        for (const auto& term2 : p2.the_terms)
+          prod.add_term(term1.first + term2.first, term1.second * term2.second, std::true_type());
+    }
 
     return prod;
   }
@@ -1169,12 +1350,14 @@ private:
   static bool needs_plus(const coefficient_type& c, std::true_type) { return c >= zero_value<coefficient_type>(); }
   static bool needs_plus(const coefficient_type&, std::false_type) { return true; }
 
+  // to be called whenever the set of monomials changes
   void forget_sorted_terms()
   {
     if (the_sorted_terms_set) {
       the_sorted_terms.clear();
       the_sorted_terms_set=false;
     }
+    the_deg_set=false;
   }
 
 protected:
@@ -1184,6 +1367,9 @@ protected:
   mutable sorted_terms_type the_sorted_terms;
   // true if sorted_terms has a valid value
   mutable bool the_sorted_terms_set;
+  // degree of the leading monomial, valid if the_deg_set is true
+  mutable exponent_type the_deg;
+  mutable bool the_deg_set;
 };
 
 
@@ -624,7 +624,7 @@ public:
    {
       if (__builtin_expect(isfinite(*this), 1)) {
          if (__builtin_expect(isfinite(b), 1))
-            mpq_add(this, this, &b);
+            add_finite(this, this, &b);
          else
             set_inf(this, 1, b);
       } else {
@@ -640,7 +640,7 @@ public:
       Rational result;
       if (__builtin_expect(isfinite(a), 1)) {
          if (__builtin_expect(isfinite(b), 1))
-            mpq_add(&result, &a, &b);
+            add_finite(&result, &a, &b);
          else
             set_inf(&result, 1, b);
       } else {
@@ -781,7 +781,7 @@ public:
    {
       if (__builtin_expect(isfinite(*this), 1)) {
          if (__builtin_expect(isfinite(b), 1))
-            mpq_sub(this, this, &b);
+            sub_finite(this, this, &b);
          else
             set_inf(this, -1, b);
       } else {
@@ -797,7 +797,7 @@ public:
       Rational result;
       if (__builtin_expect(isfinite(a), 1)) {
          if (__builtin_expect(isfinite(b), 1))
-            mpq_sub(&result, &a, &b);
+            sub_finite(&result, &a, &b);
          else
             set_inf(&result, -1, b);
       } else {
@@ -942,7 +942,7 @@ public:
    {
       if (__builtin_expect(isfinite(*this), 1)) {
          if (__builtin_expect(isfinite(b), 1))
-            mpq_mul(this, this, &b);
+            mul_finite(this, this, &b);
          else
             set_inf(this, mpq_sgn(this), b);
       } else {
@@ -957,7 +957,7 @@ public:
       Rational result;
       if (__builtin_expect(isfinite(a), 1)) {
          if (__builtin_expect(isfinite(b), 1))
-            mpq_mul(&result, &a, &b);
+            mul_finite(&result, &a, &b);
          else
             set_inf(&result, mpq_sgn(&a), b);
       } else {
@@ -1413,7 +1413,7 @@ public:
    Int compare(const Rational& b) const
    {
       if (__builtin_expect(isfinite(*this) && isfinite(b), 1))
-         return mpq_cmp(this, &b);
+         return cmp_finite(this, &b);
       else
          return isinf(*this)-isinf(b);
    }
@@ -1465,7 +1465,7 @@ public:
    bool operator== (const Rational& a, const Rational& b)
    {
       if (__builtin_expect(isfinite(a) && isfinite(b), 1))
-         return mpq_equal(&a, &b);
+         return a.equal_finite(b);
       return isinf(a) == isinf(b);
    }
 
@@ -1771,6 +1771,64 @@ protected:
       Integer::inf_inv_sign(mpq_numref(me), s);
    }
 
+   /* Arithmetic on finite values.
+      Integral operands are processed via their numerators, skipping the gcd computations of the generic mpq routines;
+      thus the arithmetic on small integral values is carried out inline, while constructing them still calls libgmp. */
+
+   static
+   bool integral_rep(mpq_srcptr a) noexcept
+   {
+      return mpq_denref(a)->_mp_size == 1 && mpq_denref(a)->_mp_d[0] == 1;
+   }
+   static
+   void set_den_1(mpq_ptr me)
+   {
+      if (!integral_rep(me)) mpz_set_ui(mpq_denref(me), 1);
+   }
+   static
+   void add_finite(mpq_ptr me, mpq_srcptr a, mpq_srcptr b)
+   {
+      if (integral_rep(a) && integral_rep(b)) {
+         Integer::add_finite(mpq_numref(me), mpq_numref(a), mpq_numref(b));
+         set_den_1(me);
+      } else {
+         mpq_add(me, a, b);
+      }
+   }
+   static
+   void sub_finite(mpq_ptr me, mpq_srcptr a, mpq_srcptr b)
+   {
+      if (integral_rep(a) && integral_rep(b)) {
+         Integer::sub_finite(mpq_numref(me), mpq_numref(a), mpq_numref(b));
+         set_den_1(me);
+      } else {
+         mpq_sub(me, a, b);
+      }
+   }
+   static
+   void mul_finite(mpq_ptr me, mpq_srcptr a, mpq_srcptr b)
+   {
+      if (integral_rep(a) && integral_rep(b)) {
+         Integer::mul_finite(mpq_numref(me), mpq_numref(a), mpq_numref(b));
+         set_den_1(me);
+      } else {
+         mpq_mul(me, a, b);
+      }
+   }
+   static
+   int cmp_finite(mpq_srcptr a, mpq_srcptr b)
+   {
+      if (integral_rep(a) && integral_rep(b))
+         return Integer::cmp_finite(mpq_numref(a), mpq_numref(b));
+      return mpq_cmp(a, b);
+   }
+   bool equal_finite(const Rational& b) const
+   {
+      if (integral_rep(this) && integral_rep(&b))
+         return Integer::cmp_finite(mpq_numref(this), mpq_numref(&b)) == 0;
+      return mpq_equal(this, &b);
+   }
+
    void canonicalize()
    {
       if (__builtin_expect(mpz_sgn(mpq_denref(this)), 1))
@@ -0,0 +1,566 @@
+/* Copyright (c) 1997-2020
+   Ewgenij Gawrilow, Michael Joswig, and the polymake team
+   Technische Universität Berlin, Germany
+   https://polymake.org
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version: http://www.gnu.org/licenses/gpl.txt.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+--------------------------------------------------------------------------------
+*/
+
+/** @file SmallBitset.h
+    @brief Implementation of pm::SmallBitset class
+*/
+
+#ifndef POLYMAKE_SMALL_BITSET_H
+#define POLYMAKE_SMALL_BITSET_H
+
+#include "polymake/GenericSet.h"
+#include "polymake/Bitset.h"
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace pm {
+
+template <Int inline_bits> class SmallBitset;
+
+template <bool is_reversed>
+class SmallBitset_iterator {
+   template <Int> friend class SmallBitset;
+public:
+   using iterator_category = bidirectional_iterator_tag;
+   using value_type = Int;
+   using reference = Int;
+   using pointer = const Int*;
+   using difference_type = ptrdiff_t;
+   using iterator = SmallBitset_iterator;
+   using const_iterator = SmallBitset_iterator;
+
+   SmallBitset_iterator()
+      : words(nullptr)
+      , n_words(0)
+      , cur(-1) {}
+
+   reference operator* () const { return cur; }
+   pointer operator-> () const { return &cur; }
+
+   iterator& operator++ ()
+   {
+      is_reversed ? prev_pos() : next_pos();
+      return *this;
+   }
+
+   iterator& operator-- ()
+   {
+      is_reversed ? next_pos() : prev_pos();
+      return *this;
+   }
+
+   iterator operator++ (int) { iterator copy=*this; operator++(); return copy; }
+   iterator operator-- (int) { iterator copy=*this; operator--(); return copy; }
+
+   bool operator== (const iterator& it) const { return cur == it.cur; }
+   bool operator!= (const iterator& it) const { return !operator==(it); }
+
+   bool at_end() const { return cur < 0; }
+
+   void rewind()
+   {
+      cur = -1;
+      is_reversed ? prev_pos() : next_pos();
+   }
+
+protected:
+   static constexpr Int bits_per_word = 64;
+
+   SmallBitset_iterator(const uint64_t* words_arg, Int n_words_arg)
+      : words(words_arg)
+      , n_words(n_words_arg)
+      , cur(-1)
+   {
+      rewind();
+   }
+
+   SmallBitset_iterator(const uint64_t* words_arg, Int n_words_arg, Int pos)
+      : words(words_arg)
+      , n_words(n_words_arg)
+      , cur(pos) {}
+
+   // cur == -1 stands for the position before the first and behind the last element
+   void next_pos()
+   {
+      Int w = (cur+1) / bits_per_word;
+      if (w >= n_words) { cur = -1; return; }
+      uint64_t word = words[w] & (~uint64_t(0) << ((cur+1) % bits_per_word));
+      while (word == 0) {
+         if (++w == n_words) { cur = -1; return; }
+         word = words[w];
+      }
+      cur = w * bits_per_word + __builtin_ctzll(word);
+   }
+
+   void prev_pos()
+   {
+      Int w;
+      uint64_t word;
+      if (cur < 0) {
+         w = n_words-1;
+         if (w < 0) return;
+         word = words[w];
+      } else if (cur == 0) {
+         cur = -1;
+         return;
+      } else {
+         w = (cur-1) / bits_per_word;
+         word = words[w] & (~uint64_t(0) >> (bits_per_word-1 - (cur-1) % bits_per_word));
+      }
+      while (word == 0) {
+         if (--w < 0) { cur = -1; return; }
+         word = words[w];
+      }
+      cur = w * bits_per_word + bits_per_word-1 - __builtin_clzll(word);
+   }
+
+   const uint64_t* words;
+   Int n_words;
+   Int cur;
+};
+
+/** @class SmallBitset
+    @brief Bit set with inline storage for small element ranges.
+
+    Offers the interface of Bitset, but keeps the bits in an array of 64-bit words
+    which are processed by inline loops instead of calls to GMP.
+    Sets with elements below @a inline_bits are stored within the object, larger ones are moved to the heap;
+    in both cases, the range only grows and is not freed by removing elements.
+
+    It is meant for working sets in inner loops of algorithms, like visited nodes or candidate lists.
+*/
+template <Int inline_bits = 256>
+class SmallBitset
+   : public GenericSet<SmallBitset<inline_bits>, Int, operations::cmp> {
+   static constexpr Int bits_per_word = 64;
+   static constexpr Int n_inline_words = (inline_bits + bits_per_word-1) / bits_per_word;
+   static_assert(n_inline_words > 0, "inline storage must not be empty");
+
+public:
+   template <typename Left, typename Right, typename Controller, typename = void>
+   struct custom_op : std::false_type {};
+
+   template <typename T>
+   using is_SmallBitset = std::is_same<pure_type_t<T>, SmallBitset>;
+
+   template <typename T>
+   using propagate_rvalue = std::is_same<T, SmallBitset>;
+
+   template <typename Left, typename Right, typename Controller>
+   struct custom_op<Left, Right, Controller,
+                    std::enable_if_t<is_SmallBitset<Left>::value && is_SmallBitset<Right>::value &&
+                                     is_among<Controller, set_union_zipper, set_intersection_zipper,
+                                                          set_difference_zipper, set_symdifference_zipper>::value>> : std::true_type {
+      using type = SmallBitset;
+      static type make(Left&& l, Right&& r)
+      {
+         SmallBitset result(std::forward<Left>(l));
+         if (std::is_same<Controller, set_union_zipper>::value)
+            result += r;
+         else if (std::is_same<Controller, set_intersection_zipper>::value)
+            result *= r;
+         else if (std::is_same<Controller, set_difference_zipper>::value)
+            result -= r;
+         else
+            result ^= r;
+         return result;
+      }
+   };
+
+   using value_type = Int;
+   using const_reference = const Int;
+   using reference = const_reference;
+   using iterator = SmallBitset_iterator<false>;
+   using const_iterator = iterator;
+   using reverse_iterator = SmallBitset_iterator<true>;
+   using const_reverse_iterator = reverse_iterator;
+
+   /// An empty set.
+   SmallBitset()
+   {
+      std::memset(inline_words, 0, sizeof(inline_words));
+   }
+
+   /// An empty set with storage for the elements 0..@a n-1, or the full range if @a full is set.
+   explicit SmallBitset(Int n, const bool full = false)
+      : SmallBitset()
+   {
+      reserve(n);
+      if (full) fill1s(n);
+   }
+
+   explicit SmallBitset(const sequence& s)
+      : SmallBitset()
+   {
+      if (!s.empty()) {
+         reserve(s.back()+1);
+         for (const Int i : s) *this += i;
+      }
+   }
+
+   SmallBitset(const SmallBitset& s)
+      : SmallBitset()
+   {
+      assign_words(s);
+   }
+
+   SmallBitset(SmallBitset&& s) noexcept
+      : SmallBitset()
+   {
+      swap(s);
+   }
+
+   /// Copy of an abstract set of integers, e.g. a Bitset.
+   template <typename TSet>
+   explicit SmallBitset(const GenericSet<TSet, Int>& s)
+      : SmallBitset()
+   {
+      for (auto e = entire(s.top()); !e.at_end(); ++e)
+         *this += *e;
+   }
+
+   template <typename E2,
+             typename = std::enable_if_t<std::is_convertible<E2, Int>::value>>
+   SmallBitset(std::initializer_list<E2> l)
+      : SmallBitset()
+   {
+      for (const auto& e : l)
+         *this += e;
+   }
+
+   SmallBitset& operator= (const SmallBitset& s)
+   {
+      if (this != &s) {
+         clear();
+         assign_words(s);
+      }
+      return *this;
+   }
+
+   SmallBitset& operator= (SmallBitset&& s) noexcept
+   {
+      swap(s);
+      return *this;
+   }
+
+   template <typename TSet>
+   SmallBitset& operator= (const GenericSet<TSet, Int>& s)
+   {
+      SmallBitset tmp(s);
+      swap(tmp);
+      return *this;
+   }
+
+   void swap(SmallBitset& s) noexcept
+   {
+      std::swap(heap_words, s.heap_words);
+      std::swap(n_words, s.n_words);
+      uint64_t tmp[n_inline_words];
+      std::memcpy(tmp, inline_words, sizeof(inline_words));
+      std::memcpy(inline_words, s.inline_words, sizeof(inline_words));
+      std::memcpy(s.inline_words, tmp, sizeof(inline_words));
+   }
+
+   /// Make room for the elements 0..@a n-1 without reallocations.
+   void reserve(Int n)
+   {
+      const Int needed = (n + bits_per_word-1) / bits_per_word;
+      if (needed > n_words) grow(needed);
+   }
+
+   /// Synonym for reserve, for compatibility with Bitset
+   void resize(Int n) { reserve(n); }
+
+   /// Remove all elements; the storage is kept.
+   void clear()
+   {
+      std::memset(words(), 0, n_words * sizeof(uint64_t));
+   }
+
+   bool empty() const
+   {
+      const uint64_t* w = words();
+      for (Int i = 0; i < n_words; ++i)
+         if (w[i]) return false;
+      return true;
+   }
+
+   Int size() const
+   {
+      const uint64_t* w = words();
+      Int result = 0;
+      for (Int i = 0; i < n_words; ++i)
+         result += __builtin_popcountll(w[i]);
+      return result;
+   }
+
+   bool contains(Int i) const
+   {
+      return i / bits_per_word < n_words && (words()[i / bits_per_word] >> (i % bits_per_word)) & 1;
+   }
+
+   bool exists(Int i) const { return contains(i); }
+
+   Int front() const { return *begin(); }
+   Int back() const { return *rbegin(); }
+
+   SmallBitset& operator+= (Int i)
+   {
+      reserve(i+1);
+      words()[i / bits_per_word] |= uint64_t(1) << (i % bits_per_word);
+      return *this;
+   }
+
+   SmallBitset& operator-= (Int i)
+   {
+      if (i / bits_per_word < n_words)
+         words()[i / bits_per_word] &= ~(uint64_t(1) << (i % bits_per_word));
+      return *this;
+   }
+
+   SmallBitset& operator^= (Int i)
+   {
+      reserve(i+1);
+      words()[i / bits_per_word] ^= uint64_t(1) << (i % bits_per_word);
+      return *this;
+   }
+
+   SmallBitset& operator*= (Int i)
+   {
+      const bool had = contains(i);
+      clear();
+      if (had) *this += i;
+      return *this;
+   }
+
+   SmallBitset& operator+= (const SmallBitset& s)
+   {
+      if (s.n_words > n_words) grow(s.n_words);
+      uint64_t* w = words();
+      const uint64_t* sw = s.words();
+      for (Int i = 0; i < s.n_words; ++i)
+         w[i] |= sw[i];
+      return *this;
+   }
+
+   SmallBitset& operator-= (const SmallBitset& s)
+   {
+      uint64_t* w = words();
+      const uint64_t* sw = s.words();
+      for (Int i = 0, n = std::min(n_words, s.n_words); i < n; ++i)
+         w[i] &= ~sw[i];
+      return *this;
+   }
+
+   SmallBitset& operator*= (const SmallBitset& s)
+   {
+      uint64_t* w = words();
+      const uint64_t* sw = s.words();
+      const Int n = std::min(n_words, s.n_words);
+      for (Int i = 0; i < n; ++i)
+         w[i] &= sw[i];
+      std::memset(w+n, 0, (n_words-n) * sizeof(uint64_t));
+      return *this;
+   }
+
+   SmallBitset& operator^= (const SmallBitset& s)
+   {
+      if (s.n_words > n_words) grow(s.n_words);
+      uint64_t* w = words();
+      const uint64_t* sw = s.words();
+      for (Int i = 0; i < s.n_words; ++i)
+         w[i] ^= sw[i];
+      return *this;
+   }
+
+   template <typename TSet>
+   std::enable_if_t<!std::is_same<TSet, SmallBitset>::value, SmallBitset&>
+   operator+= (const GenericSet<TSet, Int>& s)
+   {
+      for (auto e = entire(s.top()); !e.at_end(); ++e)
+         *this += *e;
+      return *this;
+   }
+
+   template <typename TSet>
+   std::enable_if_t<!std::is_same<TSet, SmallBitset>::value, SmallBitset&>
+   operator-= (const GenericSet<TSet, Int>& s)
+   {
+      for (auto e = entire(s.top()); !e.at_end(); ++e)
+         *this -= *e;
+      return *this;
+   }
+
+   template <typename TSet>
+   std::enable_if_t<!std::is_same<TSet, SmallBitset>::value, SmallBitset&>
+   operator*= (const GenericSet<TSet, Int>& s)
+   {
+      SmallBitset result(n_words * bits_per_word);
+      for (auto e = entire(s.top()); !e.at_end(); ++e)
+         if (contains(*e)) result += *e;
+      swap(result);
+      return *this;
+   }
+
+   template <typename TSet>
+   std::enable_if_t<!std::is_same<TSet, SmallBitset>::value, SmallBitset&>
+   operator^= (const GenericSet<TSet, Int>& s)
+   {
+      for (auto e = entire(s.top()); !e.at_end(); ++e)
+         *this ^= *e;
+      return *this;
+   }
+
+   bool operator== (const SmallBitset& s) const
+   {
+      const uint64_t *w = words(), *sw = s.words();
+      const Int n = std::min(n_words, s.n_words);
+      if (std::memcmp(w, sw, n * sizeof(uint64_t))) return false;
+      for (Int i = n; i < n_words; ++i)
+         if (w[i]) return false;
+      for (Int i = n; i < s.n_words; ++i)
+         if (sw[i]) return false;
+      return true;
+   }
+
+   bool operator!= (const SmallBitset& s) const { return !operator==(s); }
+
+   iterator begin() const { return iterator(words(), n_words); }
+   iterator end() const { return iterator(words(), n_words, -1); }
+   reverse_iterator rbegin() const { return reverse_iterator(words(), n_words); }
+   reverse_iterator rend() const { return reverse_iterator(words(), n_words, -1); }
+
+   iterator insert(Int i)
+   {
+      *this += i;
+      return iterator(words(), n_words, i);
+   }
+
+   void push_back(Int i) { *this += i; }
+   void push_front(Int i) { *this += i; }
+   void erase(Int i) { *this -= i; }
+   void pop_front() { *this -= front(); }
+   void pop_back() { *this -= back(); }
+
+   operations::cmp get_comparator() const { return operations::cmp(); }
+
+   /// See incl(GenericSet,GenericSet)
+   friend Int incl(const SmallBitset& s1, const SmallBitset& s2)
+   {
+      const uint64_t *w1 = s1.words(), *w2 = s2.words();
+      Int result = 0;
+      for (Int i = 0, n = std::max(s1.n_words, s2.n_words); i < n; ++i) {
+         const uint64_t e1 = i < s1.n_words ? w1[i] : 0,
+                        e2 = i < s2.n_words ? w2[i] : 0,
+                        intersect = e1 & e2;
+         if (e1 != intersect) {
+            if (result < 0) return 2;
+            result = 1;
+         }
+         if (e2 != intersect) {
+            if (result > 0) return 2;
+            result = -1;
+         }
+      }
+      return result;
+   }
+
+   /// Size of the intersection, computed without creating it.
+   friend Int intersection_size(const SmallBitset& s1, const SmallBitset& s2)
+   {
+      const uint64_t *w1 = s1.words(), *w2 = s2.words();
+      Int result = 0;
+      for (Int i = 0, n = std::min(s1.n_words, s2.n_words); i < n; ++i)
+         result += __builtin_popcountll(w1[i] & w2[i]);
+      return result;
+   }
+
+   // consume data as if designated for Set<Int>
+   template <typename Input> friend
+   Input& operator>> (GenericInput<Input>& in, SmallBitset& me)
+   {
+      me.clear();
+      for (auto c = in.top().begin_list((Set<Int>*)nullptr); !c.at_end(); ) {
+         Int elem = -1;
+         c >> elem;
+         me += elem;
+      }
+      return in.top();
+   }
+
+protected:
+   uint64_t* words() { return heap_words ? heap_words.get() : inline_words; }
+   const uint64_t* words() const { return heap_words ? heap_words.get() : inline_words; }
+
+   void grow(Int needed)
+   {
+      // at least double the storage, to keep the amortized costs of successive insertions low
+      const Int new_n_words = std::max(needed, 2*n_words);
+      std::unique_ptr<uint64_t[]> new_words(new uint64_t[new_n_words]);
+      std::memcpy(new_words.get(), words(), n_words * sizeof(uint64_t));
+      std::memset(new_words.get() + n_words, 0, (new_n_words-n_words) * sizeof(uint64_t));
+      heap_words = std::move(new_words);
+      n_words = new_n_words;
+   }
+
+   void fill1s(Int n)
+   {
+      uint64_t* w = words();
+      const Int full_words = n / bits_per_word;
+      std::memset(w, 0xff, full_words * sizeof(uint64_t));
+      if (n % bits_per_word)
+         w[full_words] = ~uint64_t(0) >> (bits_per_word - n % bits_per_word);
+   }
+
+   void assign_words(const SmallBitset& s)
+   {
+      if (s.n_words > n_words) grow(s.n_words);
+      std::memcpy(words(), s.words(), s.n_words * sizeof(uint64_t));
+   }
+
+   uint64_t inline_words[n_inline_words];
+   std::unique_ptr<uint64_t[]> heap_words;
+   Int n_words = n_inline_words;
+};
+
+template <bool is_reversed>
+struct check_iterator_feature<SmallBitset_iterator<is_reversed>, end_sensitive>
+   : std::true_type {};
+
+template <bool is_reversed>
+struct check_iterator_feature<SmallBitset_iterator<is_reversed>, rewindable>
+   : std::true_type {};
+
+} // end namespace pm
+
+namespace polymake {
+   using pm::SmallBitset;
+}
+
+namespace std {
+   template <pm::Int inline_bits>
+   void swap(pm::SmallBitset<inline_bits>& s1, pm::SmallBitset<inline_bits>& s2) noexcept { s1.swap(s2); }
+}
+
+#endif // POLYMAKE_SMALL_BITSET_H
+
+// Local Variables:
+// mode:C++
+// c-basic-offset:3
+// indent-tabs-mode:nil
+// End:
@@ -276,10 +276,12 @@ Int smith_normal_form(SparseMatrix<E>& M, std::list<std::pair<E, Int>>& torsion,
 #endif
    Int rank = 0;
    torsion.clear();
-   Array<Int> r_perm(strict_diagonal ? M.rows() : 0),
-              c_perm(strict_diagonal ? M.cols() : 0);
-   Array<Int>::iterator rp = r_perm.begin(), rpe = r_perm.end(),
-                        cp = c_perm.begin(), cpe = c_perm.end();
+   // plain vectors: an empty Array would share the static empty representation,
+   // while this function is called from several threads at once, e.g. in topaz::HomologyComplex::compute_homologies
+   std::vector<Int> r_perm(strict_diagonal ? M.rows() : 0),
+                    c_perm(strict_diagonal ? M.cols() : 0);
+   auto rp = r_perm.begin(), rpe = r_perm.end(),
+        cp = c_perm.begin(), cpe = c_perm.end();
 
    for (auto r = entire(rows(M)); !r.at_end(); ++r) {
       if (!r->empty()) {
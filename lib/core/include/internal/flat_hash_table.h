@@ -0,0 +1,487 @@
+/* Copyright (c) 1997-2020
+   Ewgenij Gawrilow, Michael Joswig, and the polymake team
+   Technische Universität Berlin, Germany
+   https://polymake.org
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version: http://www.gnu.org/licenses/gpl.txt.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+--------------------------------------------------------------------------------
+*/
+
+#ifndef POLYMAKE_INTERNAL_FLAT_HASH_TABLE_H
+#define POLYMAKE_INTERNAL_FLAT_HASH_TABLE_H
+
+#include "polymake/internal/comparators.h"
+#include "polymake/meta_list.h"
+
+#include <memory>
+#include <limits>
+#include <tuple>
+
+namespace pm {
+
+/* Hash table with open addressing and linear probing, the common implementation of flat_hash_set and flat_hash_map.
+
+   The elements live in one flat array, their hash values in a parallel array which is scanned when probing.
+   The hash value of every element is computed once on insertion:
+   probing compares the stored hash values before comparing keys, and growing the table does not call the hash function.
+
+   Erased elements leave tombstones behind, which are purged when the table is rebuilt.
+   Thus erasing never invalidates iterators to other elements, while inserting may move all elements.
+
+   Lookup functions accept any key type comparable to Key, provided that hash_func yields equal hash values
+   for equal keys of both types, like for two sets or two vectors with the same elements.
+*/
+
+template <typename Key, typename... TParams>
+struct flat_hash_key_eq {
+   typedef typename mlist_wrap<TParams...>::type params;
+   typedef typename mtagged_list_extract<params, ComparatorTag>::type key_comparator;
+
+   template <typename Left, typename Right>
+   bool operator() (const Left& a, const Right& b) const
+   {
+      return compare(a, b, std::is_same<key_comparator, void>());
+   }
+private:
+   template <typename Left, typename Right>
+   static bool compare(const Left& a, const Right& b, std::true_type) { return a == b; }
+
+   template <typename Left, typename Right>
+   static bool compare(const Left& a, const Right& b, std::false_type) { return key_comparator()(a, b) == cmp_eq; }
+};
+
+template <typename Key, typename Value, typename KeyEqual>
+class flat_hash_table {
+protected:
+   // stored hash values of occupied slots have the top bit set; the remaining values mark unused slots
+   static constexpr size_t occupied_bit = size_t(1) << (std::numeric_limits<size_t>::digits-1);
+   static constexpr size_t empty_slot = 0, erased_slot = 1;
+   static constexpr int min_capacity_log = 3;
+
+   template <bool is_const>
+   class iterator_impl {
+      friend class flat_hash_table;
+      template <bool> friend class iterator_impl;
+   public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef Value value_type;
+      typedef ptrdiff_t difference_type;
+      typedef std::conditional_t<is_const, const Value&, Value&> reference;
+      typedef std::conditional_t<is_const, const Value*, Value*> pointer;
+      typedef iterator_impl<false> iterator;
+      typedef iterator_impl<true> const_iterator;
+
+      iterator_impl() = default;
+
+      // non-const to const
+      iterator_impl(const iterator& it)
+         : hash(it.hash), slot(it.slot), hash_end(it.hash_end) {}
+
+      reference operator* () const { return *slot; }
+      pointer operator-> () const { return slot; }
+
+      iterator_impl& operator++ ()
+      {
+         ++hash; ++slot;
+         valid_position();
+         return *this;
+      }
+      const iterator_impl operator++ (int) { iterator_impl copy=*this; operator++(); return copy; }
+
+      template <bool is_const2>
+      bool operator== (const iterator_impl<is_const2>& it) const { return hash == it.hash; }
+      template <bool is_const2>
+      bool operator!= (const iterator_impl<is_const2>& it) const { return hash != it.hash; }
+
+      bool at_end() const { return hash == hash_end; }
+
+   protected:
+      const size_t* hash = nullptr;
+      pointer slot = nullptr;
+      const size_t* hash_end = nullptr;
+
+      iterator_impl(const size_t* hash_arg, pointer slot_arg, const size_t* hash_end_arg)
+         : hash(hash_arg), slot(slot_arg), hash_end(hash_end_arg) {}
+
+      void valid_position()
+      {
+         while (hash != hash_end && !(*hash & occupied_bit)) {
+            ++hash; ++slot;
+         }
+      }
+   };
+
+public:
+   typedef Key key_type;
+   typedef Value value_type;
+   typedef size_t size_type;
+   typedef ptrdiff_t difference_type;
+   typedef hash_func<Key> hasher;
+   typedef KeyEqual key_equal;
+   typedef Value& reference;
+   typedef const Value& const_reference;
+
+   flat_hash_table() = default;
+
+   explicit flat_hash_table(size_t start_cap)
+   {
+      reserve(start_cap);
+   }
+
+   flat_hash_table(const flat_hash_table& other)
+   {
+      if (other.n_elements == 0) return;
+      // same layout, tombstones included
+      allocate(other.capacity_log);
+      try {
+         for (size_t i = 0, cap = capacity(); i < cap; ++i) {
+            if (other.hashes[i] & occupied_bit) {
+               new(slots+i) Value(other.slots[i]);
+               ++n_elements;
+            }
+            hashes[i] = other.hashes[i];
+         }
+      }
+      catch (...) {
+         destroy();
+         throw;
+      }
+      n_erased = other.n_erased;
+   }
+
+   flat_hash_table(flat_hash_table&& other) noexcept
+   {
+      swap(other);
+   }
+
+   flat_hash_table& operator= (const flat_hash_table& other)
+   {
+      if (this != &other) {
+         flat_hash_table copy(other);
+         swap(copy);
+      }
+      return *this;
+   }
+
+   flat_hash_table& operator= (flat_hash_table&& other) noexcept
+   {
+      swap(other);
+      return *this;
+   }
+
+   ~flat_hash_table()
+   {
+      destroy();
+   }
+
+   void swap(flat_hash_table& other) noexcept
+   {
+      std::swap(hashes, other.hashes);
+      std::swap(slots, other.slots);
+      std::swap(capacity_log, other.capacity_log);
+      std::swap(n_elements, other.n_elements);
+      std::swap(n_erased, other.n_erased);
+   }
+
+   size_t size() const { return n_elements; }
+   bool empty() const { return n_elements == 0; }
+   size_t capacity() const { return hashes ? size_t(1) << capacity_log : 0; }
+   size_t bucket_count() const { return capacity(); }
+   double load_factor() const { return hashes ? double(n_elements) / capacity() : 0.; }
+
+   hasher hash_function() const { return hasher(); }
+   key_equal key_eq() const { return key_equal(); }
+
+   typedef iterator_impl<false> iterator;
+   typedef iterator_impl<true> const_iterator;
+
+   iterator begin() { return make_iterator<iterator>(0); }
+   iterator end() { return make_iterator<iterator>(capacity()); }
+   const_iterator begin() const { return make_iterator<const_iterator>(0); }
+   const_iterator end() const { return make_iterator<const_iterator>(capacity()); }
+   const_iterator cbegin() const { return begin(); }
+   const_iterator cend() const { return end(); }
+
+   /// Make room for n elements without further rebuilding of the table.
+   void reserve(size_t n)
+   {
+      int log = min_capacity_log;
+      while (max_load(log) < n) ++log;
+      if (!hashes || log > capacity_log)
+         rebuild(log);
+   }
+
+   void clear()
+   {
+      if (hashes) {
+         destroy_elements();
+         std::fill(hashes, hashes + capacity(), empty_slot);
+         n_elements = 0;
+         n_erased = 0;
+      }
+   }
+
+   template <typename KeyRef>
+   iterator find(const KeyRef& k)
+   {
+      return make_iterator<iterator>(find_pos(k, hash_func<KeyRef>()(k)));
+   }
+
+   template <typename KeyRef>
+   const_iterator find(const KeyRef& k) const
+   {
+      return make_iterator<const_iterator>(find_pos(k, hash_func<KeyRef>()(k)));
+   }
+
+   template <typename KeyRef>
+   size_t count(const KeyRef& k) const
+   {
+      return find_pos(k, hash_func<KeyRef>()(k)) != capacity();
+   }
+
+   template <typename KeyRef>
+   bool exists(const KeyRef& k) const
+   {
+      return count(k) != 0;
+   }
+
+   template <typename KeyRef>
+   size_t erase(const KeyRef& k)
+   {
+      const size_t pos = find_pos(k, hash_func<KeyRef>()(k));
+      if (pos == capacity()) return 0;
+      erase_at(pos);
+      return 1;
+   }
+
+   /// Remove the element and return an iterator to the next one.
+   iterator erase(const_iterator where)
+   {
+      const size_t pos = where.hash - hashes;
+      erase_at(pos);
+      // the erased slot is skipped
+      return make_iterator<iterator>(pos);
+   }
+
+   iterator erase(iterator where)
+   {
+      return erase(const_iterator(where));
+   }
+
+   iterator erase(const_iterator first, const_iterator last)
+   {
+      while (first != last)
+         first = erase(first);
+      return make_iterator<iterator>(last.hash - hashes);
+   }
+
+   bool operator== (const flat_hash_table& other) const
+   {
+      if (size() != other.size()) return false;
+      for (auto it = other.begin(); !it.at_end(); ++it) {
+         const size_t pos = find_pos(key_of(*it), hash_func<Key>()(key_of(*it)));
+         if (pos == capacity() || !(slots[pos] == *it)) return false;
+      }
+      return true;
+   }
+
+   bool operator!= (const flat_hash_table& other) const
+   {
+      return !operator==(other);
+   }
+
+protected:
+   size_t* hashes = nullptr;
+   Value* slots = nullptr;
+   int capacity_log = 0;
+   size_t n_elements = 0, n_erased = 0;
+
+   // the table is rebuilt when occupied slots and tombstones together exceed 3/4 of the capacity
+   static size_t max_load(int log) { return (size_t(1) << log) / 4 * 3; }
+
+   static size_t stored_hash(size_t h) { return h | occupied_bit; }
+
+   // Fibonacci hashing spreads hash values of small integers and aligned pointers over the table
+   size_t home_pos(size_t h) const
+   {
+      return size_t(h * size_t(0x9E3779B97F4A7C15ull)) >> (std::numeric_limits<size_t>::digits - capacity_log);
+   }
+
+   template <typename Iterator>
+   Iterator make_iterator(size_t pos) const
+   {
+      Iterator it(hashes + pos, slots + pos, hashes + capacity());
+      it.valid_position();
+      return it;
+   }
+
+   template <typename KeyRef>
+   size_t find_pos(const KeyRef& k, size_t h) const
+   {
+      const size_t cap = capacity();
+      if (n_elements == 0) return cap;
+      h = stored_hash(h);
+      const size_t mask = cap-1;
+      for (size_t pos = home_pos(h); ; pos = (pos+1) & mask) {
+         const size_t stored = hashes[pos];
+         if (stored == empty_slot) return cap;
+         if (stored == h && key_equal()(key_of(slots[pos]), k)) return pos;
+      }
+   }
+
+   // Insert a new element constructed from args unless an element with key k already exists.
+   template <typename KeyRef, typename... Args>
+   std::pair<iterator, bool> emplace_unique(const KeyRef& k, Args&&... args)
+   {
+      const size_t h = stored_hash(hash_func<KeyRef>()(k));
+      size_t pos = capacity(), free_pos = pos;
+      if (hashes) {
+         const size_t mask = capacity()-1;
+         for (pos = home_pos(h); ; pos = (pos+1) & mask) {
+            const size_t stored = hashes[pos];
+            if (stored == empty_slot) break;
+            if (stored == erased_slot) {
+               if (free_pos == capacity()) free_pos = pos;
+            } else if (stored == h && key_equal()(key_of(slots[pos]), k)) {
+               return { make_iterator<iterator>(pos), false };
+            }
+         }
+         if (free_pos == capacity()) {
+            if (n_elements + n_erased < max_load(capacity_log))
+               free_pos = pos;
+         } else {
+            // reusing a tombstone
+            --n_erased;
+         }
+      }
+      if (free_pos == capacity()) {
+         // the new element is constructed in the new table before the old elements are moved,
+         // the arguments might refer to one of them
+         free_pos = rebuild(n_elements + 1 > max_load(capacity_log) / 2 ? std::max(capacity_log+1, min_capacity_log) : capacity_log,
+                            h, std::forward<Args>(args)...);
+      } else {
+         new(slots+free_pos) Value(std::forward<Args>(args)...);
+         hashes[free_pos] = h;
+         ++n_elements;
+      }
+      return { make_iterator<iterator>(free_pos), true };
+   }
+
+   void erase_at(size_t pos)
+   {
+      slots[pos].~Value();
+      hashes[pos] = erased_slot;
+      --n_elements;
+      ++n_erased;
+   }
+
+   // Rebuild the table with the given capacity, dropping all tombstones.
+   void rebuild(int new_log)
+   {
+      flat_hash_table t;
+      t.allocate(new_log);
+      t.take_elements(*this);
+      swap(t);
+   }
+
+   // Rebuild the table and insert a new element constructed from args; returns the position of the new element.
+   template <typename... Args>
+   size_t rebuild(int new_log, size_t h, Args&&... args)
+   {
+      flat_hash_table t;
+      t.allocate(new_log);
+      const size_t pos = t.free_pos_for(h);
+      new(t.slots+pos) Value(std::forward<Args>(args)...);
+      t.hashes[pos] = h;
+      ++t.n_elements;
+      t.take_elements(*this);
+      swap(t);
+      return pos;
+   }
+
+   size_t free_pos_for(size_t h) const
+   {
+      const size_t mask = capacity()-1;
+      size_t pos = home_pos(h);
+      while (hashes[pos] != empty_slot) pos = (pos+1) & mask;
+      return pos;
+   }
+
+   // move all elements of the other table, which gets empty
+   void take_elements(flat_hash_table& other)
+   {
+      for (size_t i = 0, cap = other.capacity(); i < cap; ++i) {
+         const size_t h = other.hashes[i];
+         if (h & occupied_bit) {
+            const size_t pos = free_pos_for(h);
+            relocate_value(other.slots+i, slots+pos);
+            hashes[pos] = h;
+            other.hashes[i] = empty_slot;
+            ++n_elements;
+         }
+      }
+      other.n_elements = 0;
+      other.n_erased = 0;
+   }
+
+   void allocate(int log)
+   {
+      capacity_log = log;
+      const size_t cap = size_t(1) << log;
+      hashes = new size_t[cap]();
+      slots = std::allocator<Value>().allocate(cap);
+   }
+
+   void destroy_elements()
+   {
+      for (size_t i = 0, cap = capacity(); i < cap; ++i)
+         if (hashes[i] & occupied_bit)
+            slots[i].~Value();
+   }
+
+   void destroy()
+   {
+      if (hashes) {
+         destroy_elements();
+         std::allocator<Value>().deallocate(slots, capacity());
+         delete[] hashes;
+         hashes = nullptr;
+         slots = nullptr;
+      }
+   }
+
+   static const Key& key_of(const Key& k) { return k; }
+   template <typename Mapped>
+   static const Key& key_of(const std::pair<const Key, Mapped>& p) { return p.first; }
+
+   static void relocate_value(Key* from, Key* to)
+   {
+      new(to) Key(std::move(*from));
+      from->~Key();
+   }
+
+   template <typename Mapped>
+   static void relocate_value(std::pair<const Key, Mapped>* from, std::pair<const Key, Mapped>* to)
+   {
+      new(to) std::pair<const Key, Mapped>(std::move(const_cast<Key&>(from->first)), std::move(from->second));
+      from->~pair();
+   }
+};
+
+} // end namespace pm
+
+#endif // POLYMAKE_INTERNAL_FLAT_HASH_TABLE_H
+
+// Local Variables:
+// mode:C++
+// c-basic-offset:3
+// indent-tabs-mode:nil
+// End:
@@ -20,6 +20,9 @@
 
 #include "polymake/internal/operations_basic_defs.h"
 #include "polymake/internal/iterators.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace pm {
 namespace operations {
@@ -234,6 +237,14 @@ private:
    static
    result_type default_instance(std::true_type)
    {
+#ifdef _OPENMP
+      // Copies of the default instance share its reference counter, if any, e.g. when
+      // a NodeMap or EdgeMap gets new entries.  Threads must not update a common one.
+      if (omp_in_parallel()) {
+         static thread_local const value_type thread_dflt = value_type();
+         return thread_dflt;
+      }
+#endif
       static const value_type dflt = value_type();
       return dflt;
    }
@@ -30,17 +30,73 @@
 
 namespace pm {
 
+#if defined(__GLIBCXX__)
+/* Per-thread cache of small memory blocks.
+   Blocks freed by a thread are kept here and handed out to subsequent allocations of the same size class
+   in the same thread, sparing the lock of the global pool.  A block may be freed in a thread other than
+   the one it has been allocated in; it simply migrates into the cache of the freeing thread.
+   The cache is bounded per size class and flushed back to the global pool when the thread terminates. */
+struct allocator_thread_cache {
+   static constexpr size_t align = 8, max_bytes = 128, n_classes = max_bytes / align;
+   static constexpr unsigned int max_blocks = 256;
+
+   void* free_blocks[n_classes];
+   unsigned int n_blocks[n_classes];
+   int state;   // 0: not initialized yet, 1: active, -1: disabled
+
+   // decide whether caching can be used in the current thread
+   void init();
+   // give all cached blocks back to the global pool and stop caching
+   void flush();
+
+   static size_t size_class(size_t n) { return (n-1) / align; }
+};
+
+extern thread_local allocator_thread_cache allocator_cache;
+#endif
+
 class allocator : public PM_ALLOCATOR_BASE<char> {
    using base_t = PM_ALLOCATOR_BASE<char>;
 public:
+#if defined(__GLIBCXX__)
    void* allocate(size_t n)
    {
+      if (n-1 < allocator_thread_cache::max_bytes) {
+         allocator_thread_cache& cache = allocator_cache;
+         const size_t k = allocator_thread_cache::size_class(n);
+         if (void* p = cache.free_blocks[k]) {
+            cache.free_blocks[k] = *reinterpret_cast<void**>(p);
+            --cache.n_blocks[k];
+            return p;
+         }
+      }
       return base_t::allocate(n, nullptr);
    }
    void deallocate(void* p, size_t n)
    {
+      if (n-1 < allocator_thread_cache::max_bytes) {
+         allocator_thread_cache& cache = allocator_cache;
+         if (__builtin_expect(cache.state == 0, 0)) cache.init();
+         const size_t k = allocator_thread_cache::size_class(n);
+         if (cache.state > 0 && cache.n_blocks[k] < allocator_thread_cache::max_blocks) {
+            *reinterpret_cast<void**>(p) = cache.free_blocks[k];
+            cache.free_blocks[k] = p;
+            ++cache.n_blocks[k];
+            return;
+         }
+      }
       base_t::deallocate(reinterpret_cast<char*>(p), n);
    }
+#else
+   void* allocate(size_t n)
+   {
+      return base_t::allocate(n, nullptr);
+   }
+   void deallocate(void* p, size_t n)
+   {
+      base_t::deallocate(reinterpret_cast<char*>(p), n);
+   }
+#endif
    void* reallocate(void* p, size_t old_sz, size_t new_sz);
 
    template <typename Data, typename... Args>
@@ -26,6 +26,9 @@
 #include <cstring>
 #include <limits>
 #include <cassert>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace pm {
 
@@ -262,6 +265,17 @@ protected:
    };
 
    static rep<> empty_rep;
+
+   // Threads of a parallel region must not share the static empty representation,
+   // its reference counter is not atomic.
+   static bool in_parallel_region()
+   {
+#ifdef _OPENMP
+      return omp_in_parallel();
+#else
+      return false;
+#endif
+   }
 };
 
 /** Automatic pointer to shared data
@@ -880,11 +894,12 @@ protected:
       }
 
    public:
+      // Empty arrays are attached to the static representation, but get an own one in parallel threads.
       template <typename... Args>
       static rep* construct(shared_array* owner, size_t n, Args&&... args)
       {
          rep* r;
-         if (__builtin_expect(n != 0, 1)) {
+         if (__builtin_expect(n != 0, 1) || in_parallel_region()) {
             r=allocate(n, prefix_type());
             init(owner, r, r->obj, r->obj+n, std::forward<Args>(args)...);
          } else {
@@ -0,0 +1,294 @@
+/* Copyright (c) 1997-2020
+   Ewgenij Gawrilow, Michael Joswig, and the polymake team
+   Technische Universität Berlin, Germany
+   https://polymake.org
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version: http://www.gnu.org/licenses/gpl.txt.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+--------------------------------------------------------------------------------
+*/
+
+/** @file parallel.h
+    @brief Thread limits and parallel loops over polymake containers
+
+    The loops are executed by the OpenMP runtime, which distributes the iterations dynamically among its threads;
+    there is no thread pool of polymake's own.  Without OpenMP support they degrade to plain sequential loops.
+    An exception thrown by an operation cancels the iterations not yet started and is rethrown after the loop.
+
+    Every parallelized algorithm should run under a ThreadLimit, so that the custom variable $common::max_threads
+    and the option //threads// of the client functions take effect.
+
+    The reference counters of shared polymake objects are not thread-safe.
+    The elements of the containers are therefore fetched in the calling thread before the threads start;
+    the operations may read them and create new objects, but must not copy or destroy shared objects
+    existing outside, nor call back into perl.
+*/
+
+#ifndef POLYMAKE_PARALLEL_H
+#define POLYMAKE_PARALLEL_H
+
+#include "polymake/Array.h"
+#include <vector>
+#include <atomic>
+#include <exception>
+#include <type_traits>
+#include <utility>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace pm {
+
+namespace perl { class Value; }
+
+namespace parallel {
+
+/// Number of threads a parallel loop started now would use.
+inline
+Int max_threads()
+{
+#ifdef _OPENMP
+   return omp_get_max_threads();
+#else
+   return 1;
+#endif
+}
+
+/// Number of processors available for computations.
+inline
+Int available_threads()
+{
+#ifdef _OPENMP
+   return omp_get_num_procs();
+#else
+   return 1;
+#endif
+}
+
+/// Number of the calling thread within the current parallel region, 0 outside of it.
+/// It can serve as an index into per-thread data prepared for max_threads() threads.
+inline
+Int thread_num()
+{
+#ifdef _OPENMP
+   return omp_get_thread_num();
+#else
+   return 0;
+#endif
+}
+
+/// Whether the caller is running in a parallel region.
+inline
+bool in_parallel()
+{
+#ifdef _OPENMP
+   return omp_in_parallel();
+#else
+   return false;
+#endif
+}
+
+/// Limit the number of threads of subsequent parallel loops; @a n <= 0 means all available processors.
+inline
+void set_max_threads(Int n)
+{
+#ifdef _OPENMP
+   omp_set_num_threads(n > 0 ? int(n) : omp_get_num_procs());
+#endif
+}
+
+/** @class ThreadLimit
+    @brief Number of threads valid within a scope.
+
+    The previous limit is restored on leaving the scope.
+    The value passed from perl is taken from the option //threads// of a client function;
+    if it is undefined, the custom variable $common::max_threads applies.
+    The default constructor is meant for algorithms without such an option:
+    it applies $common::max_threads unless an enclosing scope has already set a limit.
+*/
+class ThreadLimit {
+public:
+   /// @a n <= 0 keeps the current limit
+   explicit ThreadLimit(Int n)
+      : saved(max_threads())
+   {
+      ++nesting();
+      if (n > 0) set_max_threads(n);
+   }
+
+   explicit ThreadLimit(perl::Value v);
+
+   ThreadLimit();
+
+   ~ThreadLimit()
+   {
+      --nesting();
+      set_max_threads(saved);
+   }
+
+   ThreadLimit(const ThreadLimit&) = delete;
+   ThreadLimit& operator= (const ThreadLimit&) = delete;
+
+   Int get() const { return max_threads(); }
+
+private:
+   Int saved;
+
+   // number of limits active in the current thread
+   static Int& nesting()
+   {
+      static thread_local Int n = 0;
+      return n;
+   }
+};
+
+namespace impl {
+
+// The first exception thrown by an operation in a parallel loop; it must not leave the parallel region.
+class exception_holder {
+public:
+   template <typename Operation>
+   void run(const Operation& op) noexcept
+   {
+      if (failed.load(std::memory_order_relaxed)) return;
+      try {
+         op();
+      }
+      catch (...) {
+#pragma omp critical(pm_parallel_exception)
+         if (!error) error = std::current_exception();
+         failed = true;
+      }
+   }
+
+   void rethrow() const
+   {
+      if (error) std::rethrow_exception(error);
+   }
+
+private:
+   std::exception_ptr error;
+   std::atomic<bool> failed{false};
+};
+
+// elements of a container fetched in advance: pointers to real elements, copies of temporary ones like matrix rows
+template <typename Container,
+          typename Reference = decltype(*std::declval<Container&>().begin()),
+          bool by_ref = std::is_lvalue_reference<Reference>::value>
+class fetched_elements {
+public:
+   explicit fetched_elements(Container& c)
+   {
+      for (auto it = entire(c); !it.at_end(); ++it)
+         elements.push_back(&*it);
+   }
+   Int size() const { return elements.size(); }
+   Reference operator[] (Int i) const { return *elements[i]; }
+private:
+   std::vector<std::remove_reference_t<Reference>*> elements;
+};
+
+template <typename Container, typename Reference>
+class fetched_elements<Container, Reference, false> {
+public:
+   explicit fetched_elements(Container& c)
+   {
+      for (auto it = entire(c); !it.at_end(); ++it)
+         elements.emplace_back(*it);
+   }
+   Int size() const { return elements.size(); }
+   pure_type_t<Reference>& operator[] (Int i) { return elements[i]; }
+private:
+   std::vector<pure_type_t<Reference>> elements;
+};
+
+}
+
+/** Apply @a op to every element of @a c in parallel.
+    Mutable elements, like entries of a non-const Array or rows of a non-const Matrix, can be modified by @a op,
+    provided that the container does not share its data with other objects.
+    @a chunk is the number of consecutive elements handed to a thread at once.
+*/
+template <typename Container, typename Operation>
+void for_each(Container&& c, const Operation& op, Int chunk = 1)
+{
+   impl::fetched_elements<std::remove_reference_t<Container>> elements(c);
+   const Int n = elements.size();
+   impl::exception_holder exception;
+#pragma omp parallel for schedule(dynamic, chunk)
+   for (Int i = 0; i < n; ++i)
+      exception.run([&]() { op(elements[i]); });
+   exception.rethrow();
+}
+
+/** Apply @a op to every element of @a c in parallel, collecting the results in the order of the elements.
+    @a chunk is the number of consecutive elements handed to a thread at once.
+*/
+template <typename Container, typename Operation>
+auto transform(Container&& c, const Operation& op, Int chunk = 1)
+{
+   using element_ref = decltype(std::declval<impl::fetched_elements<std::remove_reference_t<Container>>&>()[0]);
+   using result_type = pure_type_t<decltype(op(std::declval<element_ref>()))>;
+   impl::fetched_elements<std::remove_reference_t<Container>> elements(c);
+   const Int n = elements.size();
+   Array<result_type> results(n);
+   const auto out = results.begin();
+   impl::exception_holder exception;
+#pragma omp parallel for schedule(dynamic, chunk)
+   for (Int i = 0; i < n; ++i)
+      exception.run([&]() { out[i] = op(elements[i]); });
+   exception.rethrow();
+   return results;
+}
+
+/** Combine all elements of @a c with an associative binary operation, starting with @a init.
+    The elements are divided into contiguous blocks, one per thread, whose partial results are combined
+    in the order of the blocks; thus @a op does not need to be commutative.
+*/
+template <typename Container, typename Result, typename Operation>
+Result reduce(Container&& c, Result init, const Operation& op)
+{
+   impl::fetched_elements<std::remove_reference_t<Container>> elements(c);
+   const Int n = elements.size();
+   const Int n_blocks = std::min(max_threads(), n);
+   std::vector<Result> partial(n_blocks);
+   std::vector<char> filled(n_blocks, false);
+   impl::exception_holder exception;
+#pragma omp parallel for schedule(static, 1)
+   for (Int b = 0; b < n_blocks; ++b) {
+      const Int start = n * b / n_blocks, stop = n * (b+1) / n_blocks;
+      if (start == stop) continue;
+      exception.run([&]() {
+         Result result(elements[start]);
+         for (Int i = start+1; i < stop; ++i)
+            result = op(result, elements[i]);
+         partial[b] = std::move(result);
+         filled[b] = true;
+      });
+   }
+   exception.rethrow();
+   for (Int b = 0; b < n_blocks; ++b)
+      if (filled[b]) init = op(init, partial[b]);
+   return init;
+}
+
+} }
+
+namespace polymake {
+   namespace parallel = pm::parallel;
+}
+
+#endif // POLYMAKE_PARALLEL_H
+
+// Local Variables:
+// mode:C++
+// c-basic-offset:3
+// indent-tabs-mode:nil
+// End:
@@ -140,6 +140,17 @@ Int incl(const Bitset& s1, const Bitset& s2) noexcept
    return result;
 }
 
+Int intersection_size(const Bitset& s1, const Bitset& s2) noexcept
+{
+   mpz_srcptr rep1 = s1.get_rep(), rep2 = s2.get_rep();
+   const int size = std::min(rep1->_mp_size, rep2->_mp_size);
+   const mp_limb_t *e1 = rep1->_mp_d, *e2 = rep2->_mp_d;
+   Int result = 0;
+   for (int i = 0; i < size; ++i)
+      result += __builtin_popcountll(e1[i] & e2[i]);
+   return result;
+}
+
 }
 
 // Local Variables:
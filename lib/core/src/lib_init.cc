@@ -39,6 +39,49 @@ public:
    static constexpr size_t align = _S_align, limit = _S_max_bytes;
 };
 
+static_assert(allocator_thread_cache::align == pool_allocator_constants::align &&
+              allocator_thread_cache::max_bytes == pool_allocator_constants::limit,
+              "thread cache size classes must coincide with those of the pool allocator");
+
+bool pool_allocator_forced_new()
+{
+   static const bool use_new = getenv("GLIBCPP_FORCE_NEW") || getenv("GLIBCXX_FORCE_NEW");
+   return use_new;
+}
+
+// returns the cached blocks to the global pool when the thread terminates
+struct allocator_thread_cache_flusher {
+   ~allocator_thread_cache_flusher() { allocator_cache.flush(); }
+};
+
+}
+
+// trivially destructible, so that it stays usable during the destruction of other thread-local and static objects
+thread_local allocator_thread_cache allocator_cache{};
+
+void allocator_thread_cache::init()
+{
+   if (pool_allocator_forced_new()) {
+      // pool allocator delegates to plain new/delete, every block must be freed with its exact size
+      state = -1;
+   } else {
+      static thread_local allocator_thread_cache_flusher flusher;
+      (void)flusher;
+      state = 1;
+   }
+}
+
+void allocator_thread_cache::flush()
+{
+   state = -1;
+   __gnu_cxx::__pool_alloc<char> pool;
+   for (size_t k = 0; k < n_classes; ++k) {
+      while (void* p = free_blocks[k]) {
+         free_blocks[k] = *reinterpret_cast<void**>(p);
+         pool.deallocate(reinterpret_cast<char*>(p), (k+1) * align);
+      }
+      n_blocks[k] = 0;
+   }
 }
 
 void* pm::allocator::reallocate(void* p, size_t old_sz, size_t new_sz)
@@ -47,7 +90,7 @@ void* pm::allocator::reallocate(void* p, size_t old_sz, size_t new_sz)
       assert(old_sz == 0);
       return allocate(new_sz);
    }
-   static const bool use_new = getenv("GLIBCPP_FORCE_NEW") || getenv("GLIBCXX_FORCE_NEW");
+   const bool use_new = pool_allocator_forced_new();
    constexpr size_t align_mask = pool_allocator_constants::align-1;
    if (!use_new && ((old_sz+align_mask) & ~align_mask) == ((new_sz+align_mask) & ~align_mask) && new_sz < pool_allocator_constants::limit)
       return p;
@@ -0,0 +1,50 @@
+/* Copyright (c) 1997-2020
+   Ewgenij Gawrilow, Michael Joswig, and the polymake team
+   Technische Universität Berlin, Germany
+   https://polymake.org
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version: http://www.gnu.org/licenses/gpl.txt.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+--------------------------------------------------------------------------------
+*/
+
+#include "polymake/parallel.h"
+#include "polymake/client.h"
+
+namespace pm { namespace parallel {
+
+ThreadLimit::ThreadLimit(perl::Value v)
+   : saved(max_threads())
+{
+   ++nesting();
+   Int n = 0;
+   if (!(v >> n))
+      perl::get_custom("$common::max_threads") >> n;
+   if (n > 0) set_max_threads(n);
+}
+
+ThreadLimit::ThreadLimit()
+   : saved(max_threads())
+{
+   // perl must not be called from parallel threads
+   if (nesting()++ == 0 && !in_parallel()) {
+      Int n = 0;
+      perl::get_custom("$common::max_threads") >> n;
+      if (n > 0) set_max_threads(n);
+   }
+}
+
+} }
+
+// Local Variables:
+// mode:C++
+// c-basic-offset:3
+// indent-tabs-mode:nil
+// End:
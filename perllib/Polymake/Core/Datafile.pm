@@ -26,6 +26,7 @@ use Polymake::Struct (
    [ '$filename' => 'Cwd::abs_path(#1)' ],
    '$is_compressed',
    [ '$canonical' => '#%', default => 'undef' ],
+   [ '$binary' => '#%', default => 'undef' ],       # minimal number of entries of values stored in the binary sidecar file
 );
 
 sub new {
@@ -47,6 +48,10 @@ sub load {
 	 { local $/; $_ .= <$fh>; }
 	 local $PropertyType::trusted_value = 1;
          my $decoded = decode_json($_);
+         if (defined(my $sidecar = $decoded->{_sidecar})) {
+            ($flags{sidecar} = $self->filename) =~ s{[^/]+$}{$sidecar->{file}};
+            $self->binary = $sidecar->{threshold};
+         }
 	 $data = Serializer::deserialize($decoded, \%flags);
          $self->canonical = $decoded->{_canonical};
 	 last;
@@ -121,6 +126,13 @@ sub save {
       }
       $name
    };
+   # large values go into a binary file next to the data file, unless the output must be plain JSON
+   my $sidecar_file = $self->filename . ".bin";
+   my $use_sidecar = $self->binary && !$self->canonical && !defined($options{schema});
+   if ($use_sidecar) {
+      unlink "$sidecar_file.new";
+      $options{sidecar} = { file => "$sidecar_file.new", threshold => $self->binary };
+   }
    my $serialized = Serializer::serialize($data, \%options);
    my $compress = layer_for_compression($self);
    my $encoder = JSON->new->utf8;
@@ -128,9 +140,20 @@ sub save {
       $encoder->canonical->indent->space_after;
       $serialized->{_canonical} = true;
    }
+   $use_sidecar &&= -f "$sidecar_file.new";
+   if ($use_sidecar) {
+      my ($sidecar_name) = $sidecar_file =~ m{([^/]+)$};
+      $serialized->{_sidecar} = { file => $sidecar_name, threshold => $self->binary };
+   }
    my ($of, $of_k) = new OverwriteFile($self->filename, $compress);
    $encoder->write($serialized, $of);
    close $of;
+   if ($use_sidecar) {
+      rename "$sidecar_file.new", $sidecar_file
+        or die "can't rename $sidecar_file.new: $!\n";
+   } elsif (-f $sidecar_file) {
+      unlink $sidecar_file;
+   }
 }
 #############################################################################################
 1
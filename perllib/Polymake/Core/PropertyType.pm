@@ -32,6 +32,8 @@ sub parse_fallback : method { croak( "no string parsing routine defined for clas
 sub toString_fallback { "$_[0]" }
 sub serialize_fallback { $_[0] }
 sub deserialize_meth : method { $_[0]->construct->($_[1]) }
+sub write_binary_fallback { undef }
+sub read_binary_fallback : method { croak( "no binary representation defined for class ", $_[0]->full_name ) }
 
 sub init_fallback { }
 sub performs_deduction { 0 }
@@ -59,6 +61,8 @@ use Polymake::Struct (
    [ '&serialize' => '->super || \&serialize_fallback' ],          # object, { options } => value or ()
    [ '&deserialize' => '->super || \&deserialize_meth' ],          # JSON => object
    [ '&JSONschema' => '->super' ],                                 #
+   [ '&write_binary' => '->super || \&write_binary_fallback' ],    # object, { sidecar } => offset or undef
+   [ '&read_binary' => '->super || \&read_binary_fallback' ],      # filename, offset => object
    [ '$construct_node' => 'undef' ],                               # Overload::Node
    [ '&construct' => '\&construct_object' ],                       # args ... => object
    [ '&parse' => '->super || \&parse_fallback' ],                  # "string" => object
@@ -71,7 +75,7 @@ use Polymake::Struct (
    [ '$help' => 'undef' ],              # Help::Topic if loaded
 );
 
-declare @override_methods=qw( canonical equal isa coherent_type serialize JSONschema parse toString init );
+declare @override_methods=qw( canonical equal isa coherent_type serialize JSONschema write_binary read_binary parse toString init );
 
 ####################################################################################
 #
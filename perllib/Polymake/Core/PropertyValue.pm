@@ -101,6 +101,10 @@ sub serialize {
          $prescribed_type ||= $self->property->type;
          $result = $prescribed_type->serialize->($type == $prescribed_type ? $self->value : $prescribed_type->construct->($self->value), $options);
          $type = $prescribed_type;
+      } elsif (defined(my $sidecar = $options->{sidecar})
+               and defined(my $offset = $type->write_binary->($self->value, $sidecar))) {
+         # large value stored in the binary file accompanying the data file
+         $result = { _sidecar => $offset };
       } else {
          $result = $type->serialize->($self->value, $options);
       }
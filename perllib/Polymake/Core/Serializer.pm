@@ -707,7 +707,8 @@ sub deserialize {
 
       my %options = ( ext_check => $ext_check, ext_store => $ext_store,
                       ns_prefix => $ns_prefix,
-                      set_changed_flag => $set_changed_flag );
+                      set_changed_flag => $set_changed_flag,
+                      sidecar => defined($flags) ? $flags->{sidecar} : undef );
       deserialize_data($src, $flags, \%options);
    } else {
       croak( "does not look like polymake data file" );
@@ -1160,6 +1161,10 @@ sub deserialize {
             push @{$options->{deferred}}, sub {
                _add($self, $prop, $value, $PropertyType::trusted_value);
             };
+         } elsif (is_hash($value) && defined(my $offset = $value->{_sidecar})) {
+            defined($options->{sidecar})
+              or croak( "property $name refers to a binary file, but none is associated with the data" );
+            _add($self, $prop, ($type // $prop->type)->read_binary->($options->{sidecar}, $offset), $PropertyType::trusted_value);
          } else {
             _add($self, $prop, defined($type) ? $type->deserialize->($value) : $value, $PropertyType::trusted_value);
          }